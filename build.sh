@@ -88,5 +88,16 @@ cmake -S "${PROJECT_ROOT}/robot" -B "${PROJECT_ROOT}/robot" -DCMAKE_BUILD_TYPE=D
 
 cmake --build "${PROJECT_ROOT}/robot" --config "${BUILD_TYPE}" -j
 
+# ========== tools (emulator, bench) ==========
+install -D "${PROJECT_ROOT}/CMakeLists_tools.txt" "${PROJECT_ROOT}/tools/CMakeLists.txt"
+
+cmake -S "${PROJECT_ROOT}/tools" -B "${PROJECT_ROOT}/tools" \
+  -DCMAKE_BUILD_TYPE="${BUILD_TYPE}" \
+  -DPREFIX_DIR="${PROJECT_ROOT}" \
+  -DPROJ_ROOT="${PROJECT_ROOT}" \
+  ${CMAKE_EXTRA_ARGS}
+
+cmake --build "${PROJECT_ROOT}/tools" --config "${BUILD_TYPE}" -j
+
 
 echo "Done !"
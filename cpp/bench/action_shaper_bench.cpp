@@ -0,0 +1,203 @@
+// action_shaper_bench.cpp
+//
+// 50 Hz 계단 목표(다리 ±0.3 rad 사각파, 바퀴 0 ↔ 3 rad/s)를 ControlLoop(lockstep, 가상 시계)로
+// SimBackend에 보내며 action shaper 유무를 비교한다.
+//   - raw    : 목표를 그대로 (주기당 MIT 1프레임)
+//   - shaped : 속도 제한(다리 8 rad/s, 바퀴 40 rad/s^2) + 1차 평활 10 ms + sub_ticks 4
+//
+//   max_jump     : 연속한 MIT 프레임 사이 다리 위치 목표의 최대 변화 (rad)
+//   frames_per_tick
+//   peak_torque  : 틱마다 본 다리 모터 토크 |u|의 최대 (N m)
+//   track_rms    : 정책 목표 대비 다리 관측 위치 RMS (rad, 첫 1초 제외)
+//   shaper_ns    : ActionShaper<16>::step() 1회 (단독)
+//
+// 결과를 JSON으로 출력하고, shaped가 프레임당 변화 / 토크를 줄이지 못하거나 추종이 무너지면 exit code 1.
+//
+// Usage:
+//   action_shaper_bench [--ticks 2000] [--out result.json]
+
+#include "action_shaper.hpp"
+#include "control_loop.hpp"
+#include "robot.hpp"
+#include "sim_backend.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Topo = robot::Robot::Topology;
+
+// SimBackend 앞에서 MIT 프레임을 가로채 목표 변화를 잰다
+class Recorder final : public robot::RobotBackend {
+public:
+    explicit Recorder(std::unique_ptr<robot::SimBackend> sim) : _sim(std::move(sim)) {}
+
+    const char* name() const override { return "recorder"; }
+    const std::vector<std::vector<uint8_t>>& boards() const override { return _sim->boards(); }
+    size_t motor_cmd(const char* tag, const std::vector<char>& sel, std::vector<char>& ok) override {
+        return _sim->motor_cmd(tag, sel, ok);
+    }
+    void estop_nowait() override { _sim->estop_nowait(); }
+    void status(MotorHealth* m, BoardHealth* b) override { _sim->status(m, b); }
+    bool req(ReqMotorState* m, ReqImu& imu, bool& has_imu, robot::BoardStamp* st) override {
+        return _sim->req(m, imu, has_imu, st);
+    }
+    void send(const robot::MotorTargets& t) override {
+        bool pos_mode = false;
+        for (size_t j = 0; j < Topo::kJoints; ++j) pos_mode |= t.kp[Topo::kJointMotor[j]] > 0.0f;
+        if (pos_mode && _have_last)
+            for (size_t j = 0; j < Topo::kJoints; ++j) {
+                const size_t g = Topo::kJointMotor[j];
+                max_jump = std::max<double>(max_jump, std::fabs(t.pos[g] - _last[g]));
+            }
+        if (pos_mode) {
+            std::copy(t.pos.begin(), t.pos.end(), _last.begin());
+            _have_last = true;
+        }
+        ++sends;
+        _sim->send(t);
+    }
+    void set_control_period(double period_ms) override { _sim->set_control_period(period_ms); }
+
+    robot::SimBackend& sim() { return *_sim; }
+
+    double max_jump = 0.0;
+    uint64_t sends = 0;
+
+private:
+    std::unique_ptr<robot::SimBackend> _sim;
+    std::array<float, Topo::kMotors> _last{};
+    bool _have_last = false;
+};
+
+struct Result {
+    double max_jump = 0.0, frames_per_tick = 0.0, peak_torque = 0.0, track_rms = 0.0;
+    std::string error;
+};
+
+Result run(long ticks, const ShaperOptions* shaper) {
+    Result res;
+    auto rec = std::make_unique<Recorder>(std::make_unique<robot::SimBackend>());
+    Recorder* r = rec.get();
+    robot::Robot robot(std::move(rec), std::make_shared<rt::VirtualClock>());
+
+    constexpr auto kp = Topo::per_motor(20.0f, 0.0f);
+    constexpr auto kd = Topo::per_motor(0.5f, 2.0f);
+    robot.set_gains({kp.begin(), kp.end()}, {kd.begin(), kd.end()});
+    if (shaper) robot.set_action_shaper(*shaper);
+
+    // 정책: 0.5초마다 뒤집히는 계단
+    long tick = 0;
+    double se = 0.0;
+    long n_err = 0;
+    float prev[Topo::kMotors] = {};
+    auto step = [&](const ObsFrame& obs, const robot::LoopCommand&, std::span<float> action) {
+        if (tick > 50) {   // 관측은 직전 목표를 따라간 결과
+            for (size_t j = 0; j < Topo::kJoints; ++j) {
+                const double e = obs.dof_pos[j] - prev[Topo::kJointMotor[j]];
+                se += e * e;
+                ++n_err;
+            }
+            const robot::SimSnapshot st = r->sim().snapshot();
+            for (size_t j = 0; j < Topo::kJoints; ++j)
+                res.peak_torque = std::max<double>(res.peak_torque, std::fabs(st.u[Topo::kJointMotor[j]]));
+        }
+        const bool up = (tick / 25) % 2 == 0;
+        for (size_t g = 0; g < Topo::kMotors; ++g)
+            action[g] = Topo::is_wheel(g) ? (up ? 3.0f : 0.0f) : (up ? 0.3f : -0.3f);
+        std::copy(action.begin(), action.end(), prev);
+        ++tick;
+    };
+
+    robot::LoopOptions lo;
+    lo.hz = 50.0;
+    lo.spin_ns = 0;
+    lo.fifo_prio = 0;
+    lo.max_ticks = static_cast<uint64_t>(ticks);
+    robot::ControlLoop loop(robot, step, lo);
+    loop.start();
+    loop.wait();
+    res.error = loop.error();
+
+    res.max_jump = r->max_jump;
+    res.frames_per_tick = static_cast<double>(r->sends) / ticks;
+    res.track_rms = n_err ? std::sqrt(se / n_err) : 0.0;
+    return res;
+}
+
+double shaper_ns(long n) {
+    ActionShaper<Topo::kMotors> s;
+    ShaperOptions o;
+    o.max_rate.assign(Topo::kMotors, 8.0f);
+    o.smooth_ms = 10.0f;
+    o.sub_ticks = 4;
+    s.configure(o, 20.0);
+    float a[Topo::kMotors] = {};
+    volatile float sink = 0.0f;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < n; ++i) {
+        if (i % 4 == 0) {
+            a[i / 4 % Topo::kMotors] += 0.01f;
+            s.set_target(a);
+        }
+        sink = sink + s.step()[i % Topo::kMotors];
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / n;
+}
+
+void print(FILE* f, const char* name, const Result& r) {
+    std::fprintf(f,
+        "  \"%s\": {\"max_jump\": %.4f, \"frames_per_tick\": %.2f, \"peak_torque\": %.2f, "
+        "\"track_rms\": %.4f, \"error\": \"%s\"},\n",
+        name, r.max_jump, r.frames_per_tick, r.peak_torque, r.track_rms, r.error.c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long ticks = 2000;
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--ticks") && i + 1 < argc) ticks = std::atol(argv[++i]);
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else { std::cerr << "usage: " << argv[0] << " [--ticks N] [--out FILE]\n"; return 2; }
+    }
+    if (ticks < 200) ticks = 200;
+
+    ShaperOptions so;
+    so.max_rate.resize(Topo::kMotors);
+    for (size_t g = 0; g < Topo::kMotors; ++g) so.max_rate[g] = Topo::is_wheel(g) ? 40.0f : 8.0f;
+    so.smooth_ms = 10.0f;
+    so.sub_ticks = 4;
+
+    const Result raw = run(ticks, nullptr);
+    const Result shaped = run(ticks, &so);
+    const double ns = shaper_ns(10000000);
+
+    const bool ok = raw.error.empty() && shaped.error.empty() &&
+                    std::fabs(shaped.frames_per_tick - so.sub_ticks) < 0.01 &&
+                    shaped.max_jump <= 8.0 * 0.020 / so.sub_ticks + 1e-4 &&   // 속도 제한 × sub-tick dt
+                    shaped.max_jump < raw.max_jump && shaped.peak_torque < raw.peak_torque &&
+                    shaped.track_rms < 0.2;
+
+    FILE* f = stdout;
+    if (!out.empty()) {
+        f = std::fopen(out.c_str(), "w");
+        if (!f) { std::perror("fopen"); return 1; }
+    }
+    std::fprintf(f, "{\n  \"config\": {\"ticks\": %ld, \"sub_ticks\": %d, \"smooth_ms\": %.1f},\n",
+                 ticks, so.sub_ticks, so.smooth_ms);
+    print(f, "raw", raw);
+    print(f, "shaped", shaped);
+    std::fprintf(f, "  \"shaper_ns\": %.1f,\n  \"ok\": %s\n}\n", ns, ok ? "true" : "false");
+    if (f != stdout) std::fclose(f);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+// control_loop_bench.cpp
+//
+// 제어 주기 지터 비교. 내장 FxEmulator 두 대(앞/뒤 보드)에 Robot을 붙이고
+// get_obs → step → do_action 을 hz 주기로 돌리며 step 호출 간격을 기록한다.
+//
+//   relative : control_rate 데코레이터와 같은 방식 (남은 시간 - spin 만큼 상대 sleep 후 spin,
+//              마감 초과 시 now + period 로 재정렬)
+//   native   : robot::ControlLoop (SCHED_FIFO 시도, clock_nanosleep(TIMER_ABSTIME) + spin)
+//
+// |간격 - 주기| 분포(p50/p99/max, us)와 overrun 수를 JSON으로 출력.
+//
+// Usage:
+//   control_loop_bench [--seconds 5] [--hz 50] [--spin-us 200] [--port 15701] [--out result.json]
+
+#include "control_loop.hpp"
+#include "fx_emulator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Summary { size_t n; double p50, p99, max; };
+
+Summary summarize(const std::vector<int64_t>& stamps, int64_t period_ns) {
+    std::vector<double> d;
+    for (size_t i = 1; i < stamps.size(); ++i)
+        d.push_back(std::abs(static_cast<double>(stamps[i] - stamps[i - 1] - period_ns)) / 1000.0);
+    if (d.empty()) return {0, 0, 0, 0};
+    std::sort(d.begin(), d.end());
+    auto pick = [&](double p) { return d[std::min(d.size() - 1, static_cast<size_t>(p * (d.size() - 1) + 0.5))]; };
+    return {d.size(), pick(0.50), pick(0.99), d.back()};
+}
+
+// 정책 자리: 관측에서 바로 작은 목표를 만든다 (추론 비용은 비교 대상이 아님)
+void dummy_step(const ObsFrame& obs, std::span<float> action) {
+    for (size_t i = 0; i < action.size(); ++i) action[i] = 0.01f * obs.dof_vel[i];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = 5.0, hz = 50.0, spin_us = 200.0;
+    uint16_t port = 15701;
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--hz") && i + 1 < argc) hz = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--spin-us") && i + 1 < argc) spin_us = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--port") && i + 1 < argc) port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else {
+            std::cerr << "usage: " << argv[0] << " [--seconds S] [--hz HZ] [--spin-us US] [--port N] [--out FILE]\n";
+            return 2;
+        }
+    }
+    if (!(hz > 0.0)) { std::cerr << "--hz must be greater than 0\n"; return 2; }
+
+    FxEmulator::Options fo, ro;
+    fo.port = port;                         fo.motor_ids = {1, 2, 3, 4, 5, 6, 7, 8};  fo.imu = false;
+    ro.port = static_cast<uint16_t>(port + 1); ro.motor_ids = {9, 10, 11, 12, 13, 14, 15, 16};
+    FxEmulator front(fo), rear(ro);
+    std::atomic<bool> run{true};
+    std::thread emu([&] { FxEmulator::serve_all({&front, &rear}, run); });
+
+    const int64_t period_ns = static_cast<int64_t>(1e9 / hz);
+    const int64_t spin_ns = static_cast<int64_t>(spin_us * 1000.0);
+    const size_t ticks = static_cast<size_t>(seconds * hz);
+
+    std::vector<int64_t> rel_stamps, nat_stamps;
+    rel_stamps.reserve(ticks + 1);
+    nat_stamps.reserve(ticks + 16);
+    uint64_t rel_overruns = 0, nat_overruns = 0;
+    std::string nat_error;
+    {
+        robot::Robot r({{"127.0.0.1", fo.port, fo.motor_ids}, {"127.0.0.1", ro.port, ro.motor_ids}});
+        std::vector<float> kp(16, 10.0f), kd(16, 0.5f);
+        kp[6] = kp[7] = kp[14] = kp[15] = 0.0f;
+        r.set_gains(kp, kd);
+
+        // ── relative: control_rate.py 스케줄링 ──
+        float act[ObsFrame::kLastAction] = {};
+        int64_t next = now_ns() + period_ns;
+        while (rel_stamps.size() < ticks) {
+            rel_stamps.push_back(now_ns());
+            dummy_step(r.get_obs(), act);
+            r.do_action(std::span<const float>(act));
+
+            const int64_t remaining = next - now_ns();
+            if (remaining <= 0) { ++rel_overruns; next = now_ns() + period_ns; continue; }
+            if (remaining - spin_ns > 0) std::this_thread::sleep_for(std::chrono::nanoseconds(remaining - spin_ns));
+            while (now_ns() < next) {}
+            next += period_ns;
+        }
+
+        // ── native: ControlLoop ──
+        robot::LoopOptions opt;
+        opt.hz = hz;
+        opt.spin_ns = spin_ns;
+        robot::ControlLoop loop(r, [&](const ObsFrame& obs, const robot::LoopCommand&, std::span<float> action) {
+            if (nat_stamps.size() < nat_stamps.capacity()) nat_stamps.push_back(now_ns());
+            dummy_step(obs, action);
+        }, opt);
+        loop.start();
+        while (loop.running() && loop.telemetry().tick < ticks)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        loop.stop();
+        nat_overruns = loop.telemetry().overruns;
+        nat_error = loop.error();
+        if (nat_stamps.size() > ticks) nat_stamps.resize(ticks);
+    }
+    run = false;
+    emu.join();
+
+    if (!nat_error.empty()) { std::cerr << "ControlLoop stopped: " << nat_error << "\n"; return 1; }
+
+    const Summary rs = summarize(rel_stamps, period_ns);
+    const Summary ns = summarize(nat_stamps, period_ns);
+
+    FILE* f = stdout;
+    if (!out.empty()) {
+        f = std::fopen(out.c_str(), "w");
+        if (!f) { std::perror("fopen"); return 1; }
+    }
+    auto emit = [&](const char* name, const Summary& s, uint64_t overruns, const char* tail) {
+        std::fprintf(f, "    \"%s\": {\"n\": %zu, \"p50_us\": %.1f, \"p99_us\": %.1f, \"max_us\": %.1f, \"overruns\": %llu}%s\n",
+                     name, s.n, s.p50, s.p99, s.max, static_cast<unsigned long long>(overruns), tail);
+    };
+    std::fprintf(f, "{\n  \"config\": {\"seconds\": %.1f, \"hz\": %.1f, \"spin_us\": %.1f},\n  \"period_jitter\": {\n",
+                 seconds, hz, spin_us);
+    emit("relative", rs, rel_overruns, ",");
+    emit("native", ns, nat_overruns, "");
+    std::fprintf(f, "  }\n}\n");
+    if (f != stdout) std::fclose(f);
+    return 0;
+}
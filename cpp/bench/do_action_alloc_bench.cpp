@@ -0,0 +1,107 @@
+// do_action_alloc_bench.cpp
+//
+// Robot::do_action 구동 경로의 힙 할당 검사. 내장 FxEmulator 두 대(앞/뒤 보드)에
+// Robot을 붙이고, 워밍업 후 do_action(위치 제어 / 토크 제어 교대 → GAIN 재업로드
+// 경로 포함)을 반복하면서 호출 스레드의 operator new 횟수를 센다.
+// RX/I-O 스레드의 할당은 제외 (thread_local 카운터).
+//
+// 결과를 JSON으로 출력하고, do_action 한 번이라도 할당하면 exit code 1.
+//
+// Usage:
+//   do_action_alloc_bench [--iters N] [--port 15601] [--out result.json]
+
+#include "robot.hpp"
+#include "fx_emulator.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ──────────────── 할당 횟수 측정 (호출 스레드만) ────────────────
+static thread_local uint64_t t_allocs = 0;
+
+// new / delete 전체를 같은 malloc / free 쌍으로 (noinline: GCC가 내장 new와 free를 짝지어
+// -Wmismatched-new-delete를 내지 않도록)
+__attribute__((noinline)) static void* counted_alloc(std::size_t n) {
+    ++t_allocs;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+__attribute__((noinline)) static void counted_free(void* p) noexcept { std::free(p); }
+
+void* operator new(std::size_t n) { return counted_alloc(n); }
+void* operator new[](std::size_t n) { return counted_alloc(n); }
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+
+int main(int argc, char** argv) {
+    int iters = 2000;
+    uint16_t port = 15601;
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--iters") && i + 1 < argc) iters = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--port") && i + 1 < argc) port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else { std::cerr << "usage: " << argv[0] << " [--iters N] [--port N] [--out FILE]\n"; return 2; }
+    }
+
+    FxEmulator::Options fo, ro;
+    fo.port = port;                         fo.motor_ids = {1, 2, 3, 4, 5, 6, 7, 8};  fo.imu = false;
+    ro.port = static_cast<uint16_t>(port + 1); ro.motor_ids = {9, 10, 11, 12, 13, 14, 15, 16};
+    FxEmulator front(fo), rear(ro);
+    std::atomic<bool> run{true};
+    std::thread emu([&] { FxEmulator::serve_all({&front, &rear}, run); });
+
+    uint64_t pos_allocs = 0, tau_allocs = 0;
+    double us_per_call = 0.0;
+    {
+        robot::Robot r({{"127.0.0.1", fo.port, fo.motor_ids}, {"127.0.0.1", ro.port, ro.motor_ids}});
+        std::vector<float> kp(16, 10.0f), kd(16, 0.5f);
+        kp[6] = kp[7] = kp[14] = kp[15] = 0.0f;
+        r.set_gains(kp, kd);
+
+        const std::vector<float> action(16, 0.1f), torque(16, 0.0f);
+        auto tick = [&](int i) {
+            if (i & 1) r.do_action(torque, /*torque_ctrl=*/true);   // kp/kd=0 → gain table 재업로드
+            else       r.do_action(action, /*torque_ctrl=*/false);
+        };
+
+        for (int i = 0; i < 100; ++i) { r.get_obs(); tick(i); }   // 워밍업 (버퍼 용량 확보)
+
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < iters; ++i) {
+            r.get_obs();
+            const uint64_t a0 = t_allocs;
+            tick(i);
+            (i & 1 ? tau_allocs : pos_allocs) += t_allocs - a0;
+        }
+        us_per_call = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - t0).count() / iters;
+    }
+    run = false;
+    emu.join();
+
+    FILE* f = stdout;
+    if (!out.empty()) {
+        f = std::fopen(out.c_str(), "w");
+        if (!f) { std::perror("fopen"); return 1; }
+    }
+    std::fprintf(f,
+        "{\n  \"iters\": %d,\n  \"us_per_tick\": %.1f,\n"
+        "  \"do_action_allocs\": {\"position\": %llu, \"torque\": %llu},\n"
+        "  \"ok\": %s\n}\n",
+        iters, us_per_call,
+        static_cast<unsigned long long>(pos_allocs), static_cast<unsigned long long>(tau_allocs),
+        (pos_allocs + tau_allocs) == 0 ? "true" : "false");
+    if (f != stdout) std::fclose(f);
+    return (pos_allocs + tau_allocs) == 0 ? 0 : 1;
+}
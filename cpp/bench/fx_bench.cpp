@@ -0,0 +1,284 @@
+// fx_bench.cpp
+//
+// FxCli 루프백 전송 벤치마크. 내장 FxEmulator(또는 --remote 대상)에 대해
+// req / status / operation_control / operation_control_compact / Non-RT 명령의
+// RTT 분포(p50/p99/p999/max)와 처리량을 측정하고 JSON으로 출력한다.
+//
+// Usage:
+//   fx_bench [--iters N] [--loss P] [--corrupt P] [--load N] [--crc]
+//            [--ops req,status,mit,mitc,nonrt,gain] [--port 15501] [--remote IP:PORT]
+//            [--out result.json]
+//
+//   --load N : 측정 동안 N개의 busy-loop 스레드로 배경 CPU 부하
+//   --remote : 내장 에뮬레이터 대신 외부 보드/에뮬레이터 (loss/corrupt 무시)
+//
+// Non-RT 명령(START/STOP)은 FxCli의 1s 안정화 sleep을 빼고 ACK 왕복만 잰다
+// (post_motor_cmd + collect).
+//
+// gain: UdpBackend::send를 손실 링크(max(--loss, 0.2): ACK 유실이 실제로 일어나도록)의 별도 에뮬레이터에 대고 돌리며
+// 100 송신마다 gain을 바꾼다. AT+GAIN ACK가 유실된 뒤에도 (backoff 재시도로) 다음 gain
+// 변경 전에 compact AT+MITC로 돌아오는지 확인 → 못 돌아오면 exit code 1.
+
+#include "fx_client.hpp"
+#include "fx_emulator.hpp"
+#include "crc32c.hpp"
+#include "udp_backend.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct Config {
+    int iters = 5000;
+    double loss = 0.0;
+    double corrupt = 0.0;
+    int load = 0;
+    bool crc = false;
+    std::string ops = "req,status,mit,mitc,nonrt,gain";
+    uint16_t port = 15501;
+    std::string remote;     // "IP:PORT"
+    std::string out;        // 비어 있으면 stdout
+};
+
+// gain: GAIN ACK 유실 → compact 복귀
+struct GainRecovery {
+    bool ran = false;
+    int sends = 0;
+    int lost_acks = 0;        // gain 변경 뒤 첫 송신이 full MIT였던 횟수
+    int recovered = 0;        // 그중 다음 gain 변경 전에 compact로 돌아온 횟수
+    int max_recover = 0;      // 복귀까지 걸린 최대 송신 수
+    double loss = 0.0;
+};
+
+// 보드 하나짜리 UdpBackend: 100 송신마다 kp를 바꿔 AT+GAIN 재업로드를 일으킨다
+GainRecovery run_gain(uint16_t port, double loss, int iters) {
+    GainRecovery g;
+    g.ran = true;
+    g.loss = loss;
+    FxEmulator::Options o;
+    o.port = port;
+    o.loss = loss;
+    FxEmulator emu(o);
+    emu.start();
+    {
+        const FxBoard b{"127.0.0.1", port, {1, 2, 3, 4, 5, 6, 7, 8}};
+        robot::UdpBackend be(std::make_shared<FxPool>(), {b});
+        std::vector<float> pos(8, 0.1f), vel(8, 0.0f), kp(8, 10.0f), kd(8, 0.5f), tau(8, 0.0f);
+        constexpr int kEvery = 100;
+        int lost_at = -1;
+        for (int i = 0; i < std::max(iters, 10 * kEvery); ++i) {
+            if (i % kEvery == 0) {
+                if (lost_at >= 0) lost_at = -1;   // 복귀 못 한 채 다음 변경
+                kp.assign(8, 10.0f + static_cast<float>(i / kEvery % 7));
+            }
+            be.send({pos, vel, kp, kd, tau});
+            ++g.sends;
+            const bool compact = be.compact_boards() == 1;
+            if (i % kEvery == 0 && !compact) { ++g.lost_acks; lost_at = i; }
+            else if (lost_at >= 0 && compact) {
+                ++g.recovered;
+                g.max_recover = std::max(g.max_recover, i - lost_at);
+                lost_at = -1;
+            }
+        }
+    }
+    emu.stop();
+    return g;
+}
+
+struct Result {
+    std::string name;
+    int iters = 0;
+    int ok = 0;
+    double wall_s = 0.0;
+    std::vector<double> rtt_us;   // 성공한 호출만
+};
+
+double pct(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t i = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(i, sorted.size() - 1)];
+}
+
+// 한 연산을 iters번 호출: call()은 성공 여부 반환
+Result run(const std::string& name, int iters, const std::function<bool()>& call) {
+    Result r;
+    r.name = name;
+    r.iters = iters;
+    r.rtt_us.reserve(static_cast<size_t>(iters));
+    const auto t0 = clock_type::now();
+    for (int i = 0; i < iters; ++i) {
+        const auto a = clock_type::now();
+        bool ok = call();
+        const auto b = clock_type::now();
+        if (ok) {
+            ++r.ok;
+            r.rtt_us.push_back(std::chrono::duration<double, std::micro>(b - a).count());
+        }
+    }
+    r.wall_s = std::chrono::duration<double>(clock_type::now() - t0).count();
+    std::sort(r.rtt_us.begin(), r.rtt_us.end());
+    return r;
+}
+
+void write_json(FILE* f, const Config& c, const std::vector<Result>& rs,
+                uint64_t req_retries, uint64_t crc_errors, const GainRecovery& g) {
+    std::fprintf(f, "{\n  \"config\": {\"iters\": %d, \"loss\": %g, \"corrupt\": %g, \"load\": %d, "
+                    "\"crc\": %s, \"crc_hw\": %s, \"target\": \"%s\", \"hw_threads\": %u},\n",
+                 c.iters, c.loss, c.corrupt, c.load, c.crc ? "true" : "false",
+                 crc32c::hw_accelerated() ? "true" : "false",
+                 c.remote.empty() ? "emulator" : c.remote.c_str(),
+                 std::thread::hardware_concurrency());
+    std::fprintf(f, "  \"req_retries\": %llu,\n  \"rx_crc_errors\": %llu,\n  \"results\": {\n",
+                 static_cast<unsigned long long>(req_retries),
+                 static_cast<unsigned long long>(crc_errors));
+    for (size_t i = 0; i < rs.size(); ++i) {
+        const Result& r = rs[i];
+        double mean = 0.0;
+        for (double v : r.rtt_us) mean += v;
+        if (!r.rtt_us.empty()) mean /= static_cast<double>(r.rtt_us.size());
+        std::fprintf(f, "    \"%s\": {\"iters\": %d, \"ok\": %d, \"fail\": %d, \"ops_per_s\": %.1f, "
+                        "\"rtt_us\": {\"mean\": %.2f, \"p50\": %.2f, \"p99\": %.2f, \"p999\": %.2f, \"max\": %.2f}}%s\n",
+                     r.name.c_str(), r.iters, r.ok, r.iters - r.ok,
+                     r.wall_s > 0 ? r.ok / r.wall_s : 0.0,
+                     mean, pct(r.rtt_us, 0.50), pct(r.rtt_us, 0.99), pct(r.rtt_us, 0.999),
+                     r.rtt_us.empty() ? 0.0 : r.rtt_us.back(),
+                     i + 1 < rs.size() ? "," : "");
+    }
+    std::fprintf(f, "  }");
+    if (g.ran)
+        std::fprintf(f, ",\n  \"gain\": {\"loss\": %g, \"sends\": %d, \"lost_acks\": %d, \"recovered\": %d, "
+                        "\"max_recover_sends\": %d}",
+                     g.loss, g.sends, g.lost_acks, g.recovered, g.max_recover);
+    std::fprintf(f, "\n}\n");
+}
+
+bool has_op(const std::string& ops, const char* op) {
+    size_t cur = 0;
+    while (cur <= ops.size()) {
+        size_t comma = ops.find(',', cur);
+        if (comma == std::string::npos) comma = ops.size();
+        if (ops.compare(cur, comma - cur, op) == 0) return true;
+        cur = comma + 1;
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Config c;
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) { std::cerr << "missing value for " << a << "\n"; std::exit(2); }
+            return argv[++i];
+        };
+        if      (!std::strcmp(a, "--iters"))   c.iters = std::atoi(next());
+        else if (!std::strcmp(a, "--loss"))    c.loss = std::atof(next());
+        else if (!std::strcmp(a, "--corrupt")) c.corrupt = std::atof(next());
+        else if (!std::strcmp(a, "--load"))    c.load = std::atoi(next());
+        else if (!std::strcmp(a, "--crc"))     c.crc = true;
+        else if (!std::strcmp(a, "--ops"))     c.ops = next();
+        else if (!std::strcmp(a, "--port"))    c.port = static_cast<uint16_t>(std::atoi(next()));
+        else if (!std::strcmp(a, "--remote"))  c.remote = next();
+        else if (!std::strcmp(a, "--out"))     c.out = next();
+        else {
+            std::cerr << "usage: " << argv[0]
+                      << " [--iters N] [--loss P] [--corrupt P] [--load N] [--crc]"
+                         " [--ops req,status,mit,mitc,nonrt,gain] [--port N] [--remote IP:PORT] [--out FILE]\n";
+            return 2;
+        }
+    }
+
+    // 대상: 내장 에뮬레이터 또는 외부
+    std::string ip = "127.0.0.1";
+    uint16_t port = c.port;
+    std::unique_ptr<FxEmulator> emu;
+    if (c.remote.empty()) {
+        FxEmulator::Options o;
+        o.port = c.port;
+        o.loss = c.loss;
+        o.corrupt = c.corrupt;
+        emu = std::make_unique<FxEmulator>(o);
+        emu->start();
+    } else {
+        size_t colon = c.remote.find(':');
+        ip = c.remote.substr(0, colon);
+        if (colon != std::string::npos) port = static_cast<uint16_t>(std::atoi(c.remote.c_str() + colon + 1));
+    }
+
+    // 배경 CPU 부하
+    std::atomic<bool> loaded{true};
+    std::vector<std::thread> burners;
+    for (int i = 0; i < c.load; ++i) {
+        burners.emplace_back([&] {
+            volatile uint64_t x = 0;
+            while (loaded.load(std::memory_order_relaxed)) x = x + 1;
+        });
+    }
+
+    FxCli cli(ip, port);
+    cli.set_crc(c.crc);
+
+    const std::vector<uint8_t> ids{1, 2, 3, 4, 5, 6, 7, 8};
+    const std::vector<float> pos(8, 0.1f), vel(8, 0.0f), kp(8, 10.0f), kd(8, 0.5f), tau(8, 0.0f);
+    std::string ack;
+
+    std::vector<Result> results;
+    if (has_op(c.ops, "nonrt")) {
+        // Non-RT: START/STOP 번갈아, ACK 왕복만 (안정화 sleep 제외)
+        int k = 0;
+        results.push_back(run("nonrt", std::max(1, c.iters / 10), [&] {
+            const char* tag = (k++ & 1) ? "STOP" : "START";
+            cli.post_motor_cmd(tag, ids);
+            return cli.collect(tag, ack, clock_type::now() + std::chrono::milliseconds(cli.timeout_ms()));
+        }));
+        cli.post_motor_cmd("START", ids);
+        cli.collect("START", ack, clock_type::now() + std::chrono::milliseconds(cli.timeout_ms()));
+    }
+    if (has_op(c.ops, "req"))
+        results.push_back(run("req", c.iters, [&] { return !cli.req(ids).empty(); }));
+    if (has_op(c.ops, "status"))
+        results.push_back(run("status", c.iters, [&] { return !cli.status().empty(); }));
+    if (has_op(c.ops, "mit"))
+        results.push_back(run("operation_control", c.iters,
+                              [&] { return cli.operation_control(ids, pos, vel, kp, kd, tau); }));
+    if (has_op(c.ops, "mitc")) {
+        cli.set_gain_table(ids, kp, kd);
+        results.push_back(run("operation_control_compact", c.iters,
+                              [&] { return cli.operation_control_compact(ids, pos, vel, tau); }));
+    }
+
+    loaded.store(false);
+    for (auto& t : burners) t.join();
+    if (emu) emu->stop();
+
+    // 손실 링크 전용 에뮬레이터 (--remote에서는 생략)
+    GainRecovery gain;
+    if (has_op(c.ops, "gain") && c.remote.empty())
+        gain = run_gain(static_cast<uint16_t>(c.port + 1), std::max(c.loss, 0.2), c.iters);
+    const bool gain_ok = !gain.ran || (gain.lost_acks > 0 && gain.recovered == gain.lost_acks);
+
+    FILE* f = stdout;
+    if (!c.out.empty()) {
+        f = std::fopen(c.out.c_str(), "w");
+        if (!f) { std::perror("fopen"); return 1; }
+    }
+    write_json(f, c, results, cli.req_retries(), cli.rx_crc_errors(), gain);
+    if (f != stdout) std::fclose(f);
+    return gain_ok ? 0 : 1;
+}
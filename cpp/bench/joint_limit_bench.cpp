@@ -0,0 +1,124 @@
+// joint_limit_bench.cpp
+//
+// JointLimits(SIMD) 관절 한계 검사 비용 측정 + 기존 스칼라 루프와의 결과 일치 확인.
+// 임의 관측(정상 / 한계 근처 / 위반 섞음)에 대해 두 구현의 "첫 위반 관절·종류"를 비교하고,
+// 정상 관측 한 번 검사에 드는 시간(ns)을 JSON으로 출력한다. 불일치가 있으면 exit code 1.
+//
+// Usage:
+//   joint_limit_bench [--iters N] [--out result.json]
+
+#include "joint_limits.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+constexpr size_t kJoints = 12;
+constexpr float kPosMargin = 0.1745f, kVelMargin = 0.3491f, kVelLimit = 8.7275f;
+
+// 관절 범위 (rad, 상대 위치): 비대칭 범위도 섞어 경계 처리를 확인
+constexpr float kLo[kJoints] = {-3.14f, -3.14f, -3.14f, -3.14f, -3.14f, -3.14f, -0.7f, -1.6f, -2.6f, -0.7f, -1.6f, -2.6f};
+constexpr float kHi[kJoints] = { 3.14f,  3.14f,  3.14f,  3.14f,  3.14f,  3.14f,  0.7f,  1.6f,  0.1f,  0.7f,  1.6f,  0.1f};
+
+// 기존 Robot::_check_obs 루프 (관절별 분기, 첫 위반에서 종료). @return joint*4 + kind(1..3), 0: 정상
+int scalar_check(const float* q, const float* dq) {
+    for (size_t i = 0; i < kJoints; ++i) {
+        const float lo = kLo[i] + kPosMargin, hi = kHi[i] - kPosMargin;
+        if (q[i] < lo || q[i] > hi) return static_cast<int>(i) * 4 + 1;
+        if (q[i] < lo + kVelMargin && dq[i] < -kVelLimit) return static_cast<int>(i) * 4 + 2;
+        if (q[i] >= hi - kVelMargin && dq[i] > kVelLimit) return static_cast<int>(i) * 4 + 3;
+    }
+    return 0;
+}
+
+int simd_first(uint64_t m) {
+    using L = JointLimits<kJoints>;
+    if (!m) return 0;
+    const uint64_t mp = m & L::kPosMask, ml = (m >> L::kVelLoShift) & L::kPosMask, mh = (m >> L::kVelHiShift) & L::kPosMask;
+    const int i = std::countr_zero(mp | ml | mh);
+    return i * 4 + ((mp >> i & 1) ? 1 : (ml >> i & 1) ? 2 : 3);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long iters = 5000000;
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--iters") && i + 1 < argc) iters = std::atol(argv[++i]);
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else { std::cerr << "usage: " << argv[0] << " [--iters N] [--out FILE]\n"; return 2; }
+    }
+
+    JointLimits<kJoints> lim;
+    lim.set(kLo, kHi, kPosMargin, kVelMargin, kVelLimit);
+
+    // 1) 일치 확인
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> u(0.0f, 1.0f);
+    alignas(16) float q[kJoints], dq[kJoints];
+    long mismatches = 0, violations = 0;
+    const long n_eq = 200000;
+    for (long t = 0; t < n_eq; ++t) {
+        for (size_t i = 0; i < kJoints; ++i) {
+            // 범위보다 조금 넓게 뽑아 경계/위반을 섞는다
+            const float span = kHi[i] - kLo[i];
+            q[i] = kLo[i] - 0.05f * span + 1.1f * span * u(rng);
+            dq[i] = (u(rng) - 0.5f) * 24.0f;
+            if (u(rng) < 0.6f) q[i] = 0.5f * (kLo[i] + kHi[i]);   // 대부분 관절은 정상
+        }
+        const int a = scalar_check(q, dq), b = simd_first(lim.check(q, dq));
+        mismatches += a != b;
+        violations += a != 0;
+    }
+
+    // 2) 정상 관측 비용 (실제 매 틱 경로): 서로 다른 정상 관측 64개를 돌려 가며 검사
+    constexpr size_t kBatch = 64;
+    alignas(16) static float bq[kBatch][kJoints], bdq[kBatch][kJoints];
+    for (size_t k = 0; k < kBatch; ++k)
+        for (size_t i = 0; i < kJoints; ++i) {
+            bq[k][i] = 0.5f * (kLo[i] + kHi[i]) + 0.1f * (u(rng) - 0.5f);
+            bdq[k][i] = (u(rng) - 0.5f) * 2.0f;
+        }
+    uint64_t acc = 0;
+    int acc2 = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long t = 0; t < iters; ++t) acc += lim.check(bq[t & (kBatch - 1)], bdq[t & (kBatch - 1)]);
+    auto t1 = std::chrono::steady_clock::now();
+    for (long t = 0; t < iters; ++t) acc2 += scalar_check(bq[t & (kBatch - 1)], bdq[t & (kBatch - 1)]);
+    auto t2 = std::chrono::steady_clock::now();
+    const double simd_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / iters;
+    const double scalar_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / iters;
+    if (acc || acc2) ++mismatches;   // 정상 관측에서 위반이 나오면 실패
+
+#if defined(JOINT_LIMITS_SSE)
+    const char* isa = "sse2";
+#elif defined(JOINT_LIMITS_NEON)
+    const char* isa = "neon";
+#else
+    const char* isa = "scalar";
+#endif
+
+    FILE* f = stdout;
+    if (!out.empty()) {
+        f = std::fopen(out.c_str(), "w");
+        if (!f) { std::perror("fopen"); return 1; }
+    }
+    std::fprintf(f,
+        "{\n  \"isa\": \"%s\",\n  \"iters\": %ld,\n"
+        "  \"ns_per_check\": {\"simd\": %.2f, \"scalar_loop\": %.2f},\n"
+        "  \"equivalence\": {\"samples\": %ld, \"violations\": %ld, \"mismatches\": %ld},\n"
+        "  \"ok\": %s\n}\n",
+        isa, iters, simd_ns, scalar_ns, n_eq, violations, mismatches, mismatches == 0 ? "true" : "false");
+    if (f != stdout) std::fclose(f);
+    return mismatches == 0 ? 0 : 1;
+}
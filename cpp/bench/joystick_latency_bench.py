@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+# joystick_latency_bench.py
+#
+# 조이스틱 리더 스레드의 이벤트 지연 측정. Joystick._reader와 같은 형태
+# (select → read)의 리더 스레드가 파이프로 들어오는 타임스탬프 이벤트를 읽고,
+# 메인 스레드는 fx_emulator(front/rear 보드)에 붙은 Robot으로 제어 루프를 돈다.
+# 이벤트 기록 → 리더 수신까지의 지연 분포를 구간별로 JSON 출력한다.
+#
+#   idle    : 제어 루프 없음 (기준선)
+#   control : hz 주기로 get_obs + do_action
+#   wake    : robot.wake() (최대 10 s 블로킹) — --wake 일 때만
+#
+# Robot 호출이 GIL을 잡은 채 블로킹하면 control/wake 구간의 지연이
+# UDP 왕복(또는 wake 전체) 만큼 늘어난다.
+#
+# Usage (build.sh 후 프로젝트 루트에서):
+#   python3 cpp/bench/joystick_latency_bench.py [--seconds 5] [--hz 50] [--rate 200]
+#       [--wake] [--port 15801] [--emulator bin/fx_emulator] [--out result.json]
+
+import argparse
+import json
+import os
+import random
+import select
+import struct
+import subprocess
+import sys
+import threading
+import time
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+sys.path.insert(0, ROOT)
+
+from w4_sdk.classes.robot import Robot, FxBoard  # noqa: E402
+
+EVENT = struct.Struct("<q")   # perf_counter_ns at write
+
+
+class FakeJoystick:
+    """Pipe-fed stand-in for Joystick: writer thread emits events, reader thread times them."""
+
+    def __init__(self, rate_hz):
+        self.rfd, self.wfd = os.pipe()
+        os.set_blocking(self.rfd, False)   # evdev 장치처럼 non-blocking read
+        self.rate_hz = rate_hz
+        self.run = True
+        self.phase = None
+        self.samples = {}
+        self._lock = threading.Lock()
+        self._threads = [threading.Thread(target=self._writer, daemon=True),
+                         threading.Thread(target=self._reader, daemon=True)]
+        for t in self._threads:
+            t.start()
+
+    def _writer(self):
+        # 평균 rate_hz, 지수 분포 간격 (사람 입력처럼 불규칙)
+        while self.run:
+            time.sleep(random.expovariate(self.rate_hz))
+            os.write(self.wfd, EVENT.pack(time.perf_counter_ns()))
+
+    def _reader(self):
+        buf = b""
+        while self.run:
+            select.select([self.rfd], [], [], 0.1)
+            try:
+                buf += os.read(self.rfd, 4096)
+            except BlockingIOError:
+                continue
+            now = time.perf_counter_ns()
+            n = len(buf) // EVENT.size
+            with self._lock:
+                if self.phase is not None:
+                    dst = self.samples.setdefault(self.phase, [])
+                    for i in range(n):
+                        (t0,) = EVENT.unpack_from(buf, i * EVENT.size)
+                        dst.append((now - t0) / 1000.0)
+            buf = buf[n * EVENT.size:]
+
+    def set_phase(self, name):
+        with self._lock:
+            self.phase = name
+
+    def stop(self):
+        self.run = False
+        for t in self._threads:
+            t.join(timeout=1.0)
+
+
+def summarize(v):
+    if not v:
+        return {"n": 0}
+    v = sorted(v)
+    pick = lambda p: v[min(len(v) - 1, int(p * (len(v) - 1) + 0.5))]
+    return {"n": len(v), "p50_us": round(pick(0.50), 1), "p99_us": round(pick(0.99), 1),
+            "p999_us": round(pick(0.999), 1), "max_us": round(v[-1], 1)}
+
+
+def control_loop(robot, seconds, hz):
+    period = 1.0 / hz
+    action = [0.0] * 16
+    next_t = time.perf_counter()
+    end = next_t + seconds
+    ticks = 0
+    while next_t < end:
+        robot.get_obs()
+        robot.do_action(action)
+        ticks += 1
+        next_t += period
+        delay = next_t - time.perf_counter()
+        if delay > 0:
+            time.sleep(delay)
+    return ticks
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--seconds", type=float, default=5.0)
+    ap.add_argument("--hz", type=float, default=50.0)
+    ap.add_argument("--rate", type=float, default=200.0, help="joystick events per second")
+    ap.add_argument("--wake", action="store_true", help="also measure during robot.wake()")
+    ap.add_argument("--port", type=int, default=15801)
+    ap.add_argument("--emulator", default=os.path.join(ROOT, "bin", "fx_emulator"))
+    ap.add_argument("--out", default="")
+    a = ap.parse_args()
+
+    emu = subprocess.Popen([a.emulator,
+                            "--board", f"{a.port}:1-8:noimu",
+                            "--board", f"{a.port + 1}:9-16"])
+    js = FakeJoystick(a.rate)
+    result = {"config": {"seconds": a.seconds, "hz": a.hz, "rate": a.rate}}
+    try:
+        time.sleep(0.2)   # 에뮬레이터 바인드 대기
+        robot = Robot([FxBoard("127.0.0.1", a.port, list(range(1, 9))),
+                       FxBoard("127.0.0.1", a.port + 1, list(range(9, 17)))])
+        kp = [10.0] * 16
+        kd = [0.5] * 16
+        for i in (6, 7, 14, 15):
+            kp[i] = 0.0
+        robot.set_gains(kp, kd)
+
+        js.set_phase("idle")
+        time.sleep(a.seconds)
+
+        js.set_phase("control")
+        result["control_ticks"] = control_loop(robot, a.seconds, a.hz)
+
+        if a.wake:
+            js.set_phase("wake")
+            t0 = time.perf_counter()
+            robot.wake()
+            result["wake_s"] = round(time.perf_counter() - t0, 3)
+        js.set_phase(None)
+    finally:
+        js.stop()
+        emu.terminate()
+        emu.wait()
+
+    result["latency"] = {k: summarize(v) for k, v in js.samples.items()}
+    text = json.dumps(result, indent=2)
+    if a.out:
+        with open(a.out, "w") as f:
+            f.write(text + "\n")
+    else:
+        print(text)
+
+
+if __name__ == "__main__":
+    main()
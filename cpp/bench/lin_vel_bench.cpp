@@ -0,0 +1,168 @@
+// lin_vel_bench.cpp
+//
+// LinVelEstimator를 합성 주행 데이터(정답 속도가 알려진)로 돌려 정확도와 업데이트 비용을 잰다.
+//   - 전진 속도/요 레이트/피치가 섞인 주행, 바퀴 속도(다리 진동 포함)·자이로 잡음
+//   - 주기적으로 한 바퀴가 헛돎(slip), 일부 틱은 REQ 누락(stale → 예측만)
+//
+//   est_rms / raw_rms : 추정기 / 바퀴 4개 평균(raw odometry) 의 lin_vel RMS 오차 (m/s)
+//   slip_est_rms / slip_raw_rms : 헛돎 구간만의 RMS 오차
+//   ns_per_update     : update() 1회 비용 (할당 없음, O(1))
+//
+// 결과를 JSON으로 출력하고, 추정기가 raw odometry보다 나쁘거나 오차가 크면 exit code 1.
+//
+// Usage:
+//   lin_vel_bench [--ticks 30000] [--hz 50] [--reps 20] [--seed 1] [--out result.json]
+
+#include "lin_vel_estimator.hpp"
+#include "obs_frame.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Sample {
+    ObsFrame frame;
+    float truth[3];
+    bool slip;
+};
+
+// 평지 주행: 세계 좌표계 속도 (v, 0, 0)을 피치 θ만큼 기운 몸체 좌표계로 본 값이 정답
+std::vector<Sample> make_drive(long ticks, double hz, const LinVelOptions& o, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> wheel_noise(0.0f, 0.6f), gyro_noise(0.0f, 0.01f);
+    std::uniform_real_distribution<float> u01(0.0f, 1.0f);
+
+    std::vector<Sample> out(ticks);
+    ObsFrame f;
+    f.reset();
+    const double dt = 1.0 / hz;
+    for (long i = 0; i < ticks; ++i) {
+        const double t = i * dt;
+        const double v   = 1.2 * std::sin(2 * M_PI * 0.1 * t) + 0.5 * std::sin(2 * M_PI * 0.37 * t);
+        const double yaw = 0.8 * std::sin(2 * M_PI * 0.05 * t);
+        const double th  = 0.1 * std::sin(2 * M_PI * 0.2 * t);
+        const double dth = 0.1 * 2 * M_PI * 0.2 * std::cos(2 * M_PI * 0.2 * t);
+        const bool slip  = std::fmod(t, 10.0) > 9.4;   // 10초마다 0.6초 앞왼쪽 바퀴 헛돎
+
+        Sample& s = out[i];
+        s.truth[0] = static_cast<float>(v * std::cos(th));
+        s.truth[1] = 0.0f;
+        s.truth[2] = static_cast<float>(v * std::sin(th));
+        s.slip = slip;
+
+        f.stamp_ns = static_cast<int64_t>(t * 1e9) + 1;
+        const bool fresh = u01(rng) > 0.03f;   // 3% REQ 누락: 이전 값 유지
+        f.fresh = fresh ? 1 : 0;
+        if (fresh) {
+            f.rx_ns = f.stamp_ns;
+            const double rim[4] = {v - yaw * o.track_width / 2, v + yaw * o.track_width / 2,
+                                   v - yaw * o.track_width / 2, v + yaw * o.track_width / 2};
+            for (size_t w = 0; w < 4; ++w) {
+                float omega = static_cast<float>(rim[w] / o.wheel_radius) + wheel_noise(rng);
+                if (slip && w == 0) omega += 8.0f;
+                f.dof_vel[o.wheel_index[w]] = o.wheel_sign[w] * omega;
+            }
+            f.ang_vel[0] = gyro_noise(rng);
+            f.ang_vel[1] = static_cast<float>(dth) + gyro_noise(rng);
+            f.ang_vel[2] = static_cast<float>(yaw) + gyro_noise(rng);
+            f.proj_grav[0] = static_cast<float>(std::sin(th));
+            f.proj_grav[1] = 0.0f;
+            f.proj_grav[2] = static_cast<float>(-std::cos(th));
+        }
+        s.frame = f;
+    }
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long ticks = 30000;
+    double hz = 50.0;
+    int reps = 20;
+    uint32_t seed = 1;
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--ticks") && i + 1 < argc) ticks = std::atol(argv[++i]);
+        else if (!std::strcmp(argv[i], "--hz") && i + 1 < argc) hz = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--reps") && i + 1 < argc) reps = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = static_cast<uint32_t>(std::atol(argv[++i]));
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else {
+            std::cerr << "usage: " << argv[0] << " [--ticks N] [--hz HZ] [--reps N] [--seed S] [--out FILE]\n";
+            return 2;
+        }
+    }
+
+    LinVelOptions opt;
+    opt.wheel_radius = 0.08f;
+    opt.track_width = 0.45f;
+    std::vector<Sample> drive = make_drive(ticks, hz, opt, seed);
+
+    // 1) 정확도 (첫 1초 수렴 구간 제외)
+    LinVelEstimator est(opt);
+    double se = 0.0, se_raw = 0.0, se_slip = 0.0, se_slip_raw = 0.0;
+    long n = 0, n_slip = 0;
+    float raw = 0.0f;
+    for (long i = 0; i < ticks; ++i) {
+        ObsFrame f = drive[i].frame;
+        est.update(f);
+        if (f.fresh) {
+            raw = 0.0f;
+            for (size_t w = 0; w < 4; ++w)
+                raw += opt.wheel_sign[w] * f.dof_vel[opt.wheel_index[w]] * opt.wheel_radius / 4.0f;
+        }
+        if (i < static_cast<long>(hz)) continue;
+        const float* tr = drive[i].truth;
+        double e = 0.0, e_raw = 0.0;
+        for (size_t a = 0; a < 3; ++a) {
+            e += (f.lin_vel[a] - tr[a]) * (f.lin_vel[a] - tr[a]);
+            const float r = a == 0 ? raw : 0.0f;   // raw odometry: 전진 성분만
+            e_raw += (r - tr[a]) * (r - tr[a]);
+        }
+        se += e; se_raw += e_raw; ++n;
+        if (drive[i].slip) { se_slip += e; se_slip_raw += e_raw; ++n_slip; }
+    }
+    const double est_rms = std::sqrt(se / n), raw_rms = std::sqrt(se_raw / n);
+    const double slip_est_rms = n_slip ? std::sqrt(se_slip / n_slip) : 0.0;
+    const double slip_raw_rms = n_slip ? std::sqrt(se_slip_raw / n_slip) : 0.0;
+
+    // 2) 업데이트 비용
+    std::vector<ObsFrame> frames(ticks);
+    for (long i = 0; i < ticks; ++i) frames[i] = drive[i].frame;
+    est.reset();
+    volatile float sink = 0.0f;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) {
+        for (ObsFrame& f : frames) est.update(f);
+        sink = sink + est.velocity()[0];
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    const double ns_per_update = ns / (static_cast<double>(ticks) * reps);
+
+    const bool ok = est_rms < raw_rms && slip_est_rms < slip_raw_rms && est_rms < 0.1;
+
+    FILE* f = stdout;
+    if (!out.empty()) {
+        f = std::fopen(out.c_str(), "w");
+        if (!f) { std::perror("fopen"); return 1; }
+    }
+    std::fprintf(f,
+        "{\n  \"config\": {\"ticks\": %ld, \"hz\": %.1f, \"reps\": %d, \"seed\": %u},\n"
+        "  \"est_rms\": %.4f,\n  \"raw_rms\": %.4f,\n"
+        "  \"slip_est_rms\": %.4f,\n  \"slip_raw_rms\": %.4f,\n"
+        "  \"ns_per_update\": %.1f,\n"
+        "  \"ok\": %s\n}\n",
+        ticks, hz, reps, seed, est_rms, raw_rms, slip_est_rms, slip_raw_rms, ns_per_update,
+        ok ? "true" : "false");
+    if (f != stdout) std::fclose(f);
+    return ok ? 0 : 1;
+}
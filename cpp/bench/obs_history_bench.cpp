@@ -0,0 +1,145 @@
+// obs_history_bench.cpp
+//
+// Robot의 관측 이력 링(SeqRing<ObsFrame, 128>)을 writer 1개 + reader 여러 개로 두드린다.
+// writer는 프레임 i의 모든 float 필드를 i로 채우고 seq = i + 1로 push한다.
+// reader는 read_latest(stack)으로 최신 프레임 묶음을 복사해
+//   - 각 프레임이 찢어지지 않았는지 (모든 float == seq - 1)
+//   - 묶음이 seq 순서대로 이어지는지
+// 를 확인한다 (슬롯별 seq 확인이 찢어진/덮어쓰인 복사를 걸러야 함).
+//
+//   push_ns        : push() 1회 (미러 포함 2회 memcpy)
+//   read_ns        : read_latest(stack) 1회 (경합 없이)
+//   short_reads    : 복사 중 덮어쓰여 stack보다 적게 돌려준 횟수 (오류 아님)
+//   torn / gaps    : 일관성 위반 (0이어야 함)
+//
+// 결과를 JSON으로 출력하고, 위반이 있으면 exit code 1.
+//
+// Usage:
+//   obs_history_bench [--pushes 2000000] [--readers 3] [--stack 8] [--out result.json]
+
+#include "obs_frame.hpp"
+#include "seq_ring.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Ring = SeqRing<ObsFrame, 128>;
+
+constexpr size_t kFloats = kObsFields[std::size(kObsFields) - 1].offset + kObsFields[std::size(kObsFields) - 1].len;
+
+struct ReaderStats {
+    uint64_t reads = 0, frames = 0, short_reads = 0, torn = 0, gaps = 0;
+};
+
+void reader(const Ring& ring, size_t stack, const std::atomic<bool>& run, ReaderStats& st) {
+    std::vector<ObsFrame> buf(stack);
+    while (run.load(std::memory_order_relaxed)) {
+        const size_t k = ring.read_latest(buf.data(), stack);
+        ++st.reads;
+        st.frames += k;
+        if (k < stack && ring.count() >= stack) ++st.short_reads;
+        for (size_t j = 0; j < k; ++j) {
+            const ObsFrame& f = buf[j];
+            const float* p = reinterpret_cast<const float*>(&f);
+            const float want = static_cast<float>(f.seq - 1);
+            for (size_t x = 0; x < kFloats; ++x) {
+                if (p[x] != want) { ++st.torn; break; }
+            }
+            if (j && f.seq != buf[j - 1].seq + 1) ++st.gaps;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long pushes = 2000000;
+    int readers = 3;
+    size_t stack = 8;
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--pushes") && i + 1 < argc) pushes = std::atol(argv[++i]);
+        else if (!std::strcmp(argv[i], "--readers") && i + 1 < argc) readers = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--stack") && i + 1 < argc) stack = static_cast<size_t>(std::atol(argv[++i]));
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else {
+            std::cerr << "usage: " << argv[0] << " [--pushes N] [--readers N] [--stack N] [--out FILE]\n";
+            return 2;
+        }
+    }
+    if (stack < 1 || stack > Ring::kCapacity) { std::cerr << "stack must be in [1, 128]\n"; return 2; }
+
+    auto ring = std::make_unique<Ring>();
+    std::atomic<bool> run{true};
+    std::vector<ReaderStats> st(readers);
+    std::vector<std::thread> th;
+    for (int r = 0; r < readers; ++r) th.emplace_back(reader, std::cref(*ring), stack, std::cref(run), std::ref(st[r]));
+
+    ObsFrame f;
+    f.reset();
+    float* p = reinterpret_cast<float*>(&f);
+    const auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < pushes; ++i) {
+        for (size_t x = 0; x < kFloats; ++x) p[x] = static_cast<float>(i);
+        f.seq = static_cast<uint64_t>(i) + 1;
+        ring->push(f);
+    }
+    const double push_wall = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    run = false;
+    for (auto& t : th) t.join();
+
+    // 단독 비용 (경합 / 채우기 제외)
+    Ring solo;
+    auto t1 = std::chrono::steady_clock::now();
+    for (long i = 0; i < pushes; ++i) { f.seq = static_cast<uint64_t>(i) + 1; solo.push(f); }
+    const double push_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t1).count() / pushes;
+    std::vector<ObsFrame> buf(stack);
+    const long n_reads = std::max(1L, pushes / 10);
+    size_t got = 0;
+    t1 = std::chrono::steady_clock::now();
+    for (long i = 0; i < n_reads; ++i) got += solo.read_latest(buf.data(), stack);
+    const double read_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t1).count() / n_reads;
+
+    ReaderStats sum;
+    for (const auto& s : st) {
+        sum.reads += s.reads; sum.frames += s.frames; sum.short_reads += s.short_reads;
+        sum.torn += s.torn; sum.gaps += s.gaps;
+    }
+
+    // window(): 미러 덕분에 최신 stack개가 항상 연속
+    uint64_t first = 0;
+    const ObsFrame* w = ring->window(stack, &first);
+    bool window_ok = w != nullptr && first == static_cast<uint64_t>(pushes) - stack;
+    for (size_t j = 0; w && j < stack; ++j) window_ok &= w[j].seq == first + j + 1;
+
+    const bool ok = sum.torn == 0 && sum.gaps == 0 && window_ok && sum.frames > 0 &&
+                    got == static_cast<size_t>(n_reads) * stack;
+
+    FILE* fo = stdout;
+    if (!out.empty()) {
+        fo = std::fopen(out.c_str(), "w");
+        if (!fo) { std::perror("fopen"); return 1; }
+    }
+    std::fprintf(fo,
+        "{\n  \"config\": {\"pushes\": %ld, \"readers\": %d, \"stack\": %zu, \"frame_bytes\": %zu},\n"
+        "  \"push_ns\": %.1f,\n  \"push_wall_ms\": %.1f,\n  \"read_ns\": %.1f,\n"
+        "  \"reads\": %llu,\n  \"frames_read\": %llu,\n  \"short_reads\": %llu,\n"
+        "  \"torn\": %llu,\n  \"gaps\": %llu,\n  \"window_ok\": %s,\n"
+        "  \"ok\": %s\n}\n",
+        pushes, readers, stack, sizeof(ObsFrame), push_ns, push_wall / 1e6, read_ns,
+        static_cast<unsigned long long>(sum.reads), static_cast<unsigned long long>(sum.frames),
+        static_cast<unsigned long long>(sum.short_reads), static_cast<unsigned long long>(sum.torn),
+        static_cast<unsigned long long>(sum.gaps), window_ok ? "true" : "false", ok ? "true" : "false");
+    if (fo != stdout) std::fclose(fo);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+// precise_stop_bench.cpp
+//
+// Robot::precise_stop()을 SimBackend 위에서 돌린다 (가상 시계, 500 Hz 스트리밍).
+// 50 Hz 위치 제어로 바퀴를 돌리며 다리를 흔들다가 (바퀴 좌우 속도가 달라 회전 중)
+//   - hold   : 다리 자세 유지
+//   - crouch : 다리를 crouch 자세로
+// 로 멈춰서
+//   - 보낸 바퀴 속도 목표의 최대 감속 / 저크가 한계 안인지 (StopOptions::wheel_decel / wheel_jerk)
+//   - 바퀴 좌우 비율이 유지되는지 (ratio_err: 감속 중 좌/우 목표 비율의 최대 변화)
+//   - 최단 시간(v0 / A + A / J)에 가깝게 멈추는지 (hold), estop 없이 한계 검사를 통과하는지
+//   - 다리가 목표 자세에 도달하는지 (leg_err)
+// 를 확인한다.
+//
+// 결과를 JSON으로 출력하고, 확인이 하나라도 실패하면 exit code 1.
+//
+// Usage:
+//   precise_stop_bench [--wheel 6] [--out result.json]
+
+#include "robot.hpp"
+#include "sim_backend.hpp"
+
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Topo = robot::Robot::Topology;
+
+// SimBackend 앞에서 바퀴 속도 목표를 가로채 감속 / 저크를 잰다
+class Recorder final : public robot::RobotBackend {
+public:
+    explicit Recorder(std::unique_ptr<robot::SimBackend> sim) : _sim(std::move(sim)) {}
+
+    const char* name() const override { return "recorder"; }
+    const std::vector<std::vector<uint8_t>>& boards() const override { return _sim->boards(); }
+    size_t motor_cmd(const char* tag, const std::vector<char>& sel, std::vector<char>& ok) override {
+        return _sim->motor_cmd(tag, sel, ok);
+    }
+    void estop_nowait() override { _sim->estop_nowait(); }
+    void status(MotorHealth* m, BoardHealth* b) override { _sim->status(m, b); }
+    bool req(ReqMotorState* m, ReqImu& imu, bool& has_imu, robot::BoardStamp* st) override {
+        return _sim->req(m, imu, has_imu, st);
+    }
+    void send(const robot::MotorTargets& t) override {
+        if (recording) {
+            std::array<float, Topo::kWheels> v;
+            for (size_t w = 0; w < Topo::kWheels; ++w) v[w] = t.vel[Topo::kWheelMotor[w]];
+            wheel.push_back(v);
+        }
+        _sim->send(t);
+    }
+    void set_control_period(double period_ms) override { _sim->set_control_period(period_ms); }
+
+    robot::SimBackend& sim() { return *_sim; }
+
+    bool recording = false;
+    std::vector<std::array<float, Topo::kWheels>> wheel;   // 송신마다 바퀴 속도 목표
+
+private:
+    std::unique_ptr<robot::SimBackend> _sim;
+};
+
+struct Result {
+    double stop_ms = 0.0, min_ms = 0.0;
+    double max_decel = 0.0, max_jerk = 0.0, ratio_err = 0.0;
+    double final_wheel = 0.0, leg_err = 0.0;
+    uint32_t ticks = 0, missed = 0;
+    std::string error;
+};
+
+Result run(float wheel_speed, bool crouch, const StopOptions& base) {
+    Result res;
+    robot::SimOptions so;
+    so.gravity_load = 1.0;   // 다리에 하중 (자세 유지에 gain이 필요)
+    auto rec = std::make_unique<Recorder>(std::make_unique<robot::SimBackend>(so));
+    Recorder* r = rec.get();
+    robot::Robot robot(std::move(rec), std::make_shared<rt::VirtualClock>());
+
+    constexpr auto kp = Topo::per_motor(20.0f, 0.0f);
+    constexpr auto kd = Topo::per_motor(0.5f, 2.0f);
+    robot.set_gains({kp.begin(), kp.end()}, {kd.begin(), kd.end()});
+
+    StopOptions opt = base;
+    if (crouch) opt.crouch.assign(Topo::kJoints, 0.25f);
+
+    try {
+        // 2초 주행: 다리 사인, 바퀴 왼쪽 v / 오른쪽 0.6 v (회전 중)
+        std::vector<float> action(Topo::kMotors, 0.0f);
+        for (long t = 0; t < 100; ++t) {
+            robot.get_obs();
+            for (size_t g = 0; g < Topo::kMotors; ++g) {
+                const bool left = g % 2 == 0;
+                action[g] = Topo::is_wheel(g) ? (left ? 1.0f : 0.6f) * wheel_speed
+                                              : static_cast<float>(0.1 * std::sin(0.2 * t + 0.4 * g));
+            }
+            robot.do_action(action);
+        }
+
+        r->recording = true;
+        robot.precise_stop(opt);
+        r->recording = false;
+        const StopStatus& st = robot.stop_status();
+        res.stop_ms = st.elapsed_ms;
+        res.ticks = st.tick;
+        res.missed = st.missed;
+
+        const robot::SimSnapshot sn = r->sim().snapshot();
+        for (size_t w = 0; w < Topo::kWheels; ++w)
+            res.final_wheel = std::max<double>(res.final_wheel, std::fabs(sn.dq[Topo::kWheelMotor[w]]));
+        const ObsFrame& obs = robot.get_obs();
+        if (crouch)
+            for (size_t j = 0; j < Topo::kJoints; ++j)
+                res.leg_err = std::max<double>(res.leg_err, std::fabs(obs.dof_pos[j] - opt.crouch[j]));
+    } catch (const std::exception& e) {
+        res.error = e.what();
+    }
+
+    // 보낸 바퀴 목표: 감속 / 저크 / 좌우 비율 (가장 빠른 바퀴 기준)
+    const double dt = 1.0 / opt.rate_hz;
+    const auto& wv = r->wheel;
+    double v0 = 0.0;
+    size_t fast = 0;
+    if (!wv.empty())
+        for (size_t w = 0; w < Topo::kWheels; ++w)
+            if (std::fabs(wv[0][w]) > v0) { v0 = std::fabs(wv[0][w]); fast = w; }
+    double a_prev = 0.0;
+    for (size_t i = 1; i < wv.size(); ++i) {
+        const double a = (wv[i][fast] - wv[i - 1][fast]) / dt;
+        res.max_decel = std::max(res.max_decel, std::fabs(a));
+        res.max_jerk = std::max<double>(res.max_jerk, std::fabs(a - a_prev) / dt);
+        a_prev = a;
+        if (std::fabs(wv[i][fast]) > 0.05 * v0)
+            for (size_t w = 0; w < Topo::kWheels; ++w)
+                res.ratio_err = std::max<double>(res.ratio_err,
+                                         std::fabs(wv[i][w] / wv[i][fast] - wv[0][w] / wv[0][fast]));
+    }
+    res.min_ms = 1e3 * (v0 / opt.wheel_decel + opt.wheel_decel / opt.wheel_jerk);
+    return res;
+}
+
+void print(FILE* f, const char* name, const Result& r) {
+    std::fprintf(f,
+        "  \"%s\": {\"stop_ms\": %.1f, \"min_brake_ms\": %.1f, \"ticks\": %u, \"missed\": %u, "
+        "\"max_decel\": %.4f, \"max_jerk\": %.3f, \"ratio_err\": %.5f, \"final_wheel\": %.4f, "
+        "\"leg_err\": %.4f, \"error\": \"%s\"},\n",
+        name, r.stop_ms, r.min_ms, r.ticks, r.missed, r.max_decel, r.max_jerk, r.ratio_err,
+        r.final_wheel, r.leg_err, r.error.c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    float wheel = 6.0f;
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--wheel") && i + 1 < argc) wheel = static_cast<float>(std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else { std::cerr << "usage: " << argv[0] << " [--wheel RAD_S] [--out FILE]\n"; return 2; }
+    }
+
+    StopOptions opt;
+    opt.fifo_prio = 0;
+    const Result hold = run(wheel, false, opt);
+    const Result crouch = run(wheel, true, opt);
+
+    // 감속 / 저크 한계: 송신한 float 속도 목표의 반올림(v0의 몇 ulp, 두 번 차분 → / dt²)만큼만 여유.
+    // 정지 시간은 hold만 본다 (crouch는 다리 궤적 길이가 정한다)
+    const double dt = 1.0 / opt.rate_hz;
+    auto good = [&](const Result& r) {
+        const double ulp = 4.0 * FLT_EPSILON * wheel;
+        return r.error.empty() && r.missed == 0 &&
+               r.max_decel <= opt.wheel_decel + ulp / dt &&
+               r.max_jerk <= opt.wheel_jerk + 2.0 * ulp / (dt * dt) &&
+               r.ratio_err < 1e-3 && r.final_wheel < opt.vel_eps;
+    };
+    const bool ok = good(hold) && good(crouch) && crouch.leg_err < 0.05 &&
+                    hold.stop_ms <= hold.min_ms + opt.settle_ms + 200.0;
+
+    FILE* f = stdout;
+    if (!out.empty()) {
+        f = std::fopen(out.c_str(), "w");
+        if (!f) { std::perror("fopen"); return 1; }
+    }
+    std::fprintf(f, "{\n  \"config\": {\"wheel\": %.2f, \"rate_hz\": %.0f, \"wheel_decel\": %.1f, \"wheel_jerk\": %.1f},\n",
+                 wheel, opt.rate_hz, opt.wheel_decel, opt.wheel_jerk);
+    print(f, "hold", hold);
+    print(f, "crouch", crouch);
+    std::fprintf(f, "  \"ok\": %s\n}\n", ok ? "true" : "false");
+    if (f != stdout) std::fclose(f);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+// req_parse_bench.cpp
+//
+// OK<REQ> 파서 마이크로벤치마크: 단일 패스 ReqParser vs 기존 Robot 파서
+// (_scan_motor_pos + _check_mcu_data + std::stof(substr)) 를 캡처한 REQ 응답
+// (앞 보드 8모터, 뒤 보드 8모터 + IMU)에 대해 비교한다. 틱당 시간과 할당 횟수를
+// JSON으로 출력하고, 두 파서의 결과가 같은지도 확인한다.
+//
+// Usage:
+//   req_parse_bench [--iters N] [--out result.json]
+
+#include "req_parser.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+// ──────────────── 할당 횟수 측정 ────────────────
+static std::atomic<uint64_t> g_allocs{0};
+
+// new / delete 전체를 같은 malloc / free 쌍으로 (noinline: GCC가 내장 new와 free를 짝지어
+// -Wmismatched-new-delete를 내지 않도록)
+__attribute__((noinline)) static void* counted_alloc(std::size_t n) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+__attribute__((noinline)) static void counted_free(void* p) noexcept { std::free(p); }
+
+void* operator new(std::size_t n) { return counted_alloc(n); }
+void* operator new[](std::size_t n) { return counted_alloc(n); }
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// 실제 보드 응답 형식 캡처
+const std::string kFront =
+    "OK <REQ> M1 p:0.012345 v:-0.001200 t:0.110000; M2 p:-0.523599 v:0.000000 t:-0.020000;"
+    " M3 p:1.047198 v:0.250000 t:0.330000; M4 p:-1.047198 v:-0.250000 t:-0.330000;"
+    " M5 p:-2.094395 v:0.010000 t:1.200000; M6 p:2.094395 v:-0.010000 t:-1.200000;"
+    " M7 p:12.345678 v:3.141593 t:0.050000; M8 p:-12.345678 v:-3.141593 t:-0.050000;"
+    " SEQ_NUM: cnt:123456;";
+const std::string kRear =
+    "OK <REQ> M9 p:0.002000 v:0.000100 t:0.010000; M10 p:-0.002000 v:-0.000100 t:-0.010000;"
+    " M11 p:0.785398 v:0.120000 t:0.400000; M12 p:-0.785398 v:-0.120000 t:-0.400000;"
+    " M13 p:-1.570796 v:0.030000 t:0.900000; M14 p:1.570796 v:-0.030000 t:-0.900000;"
+    " M15 p:5.000000 v:2.000000 t:0.020000; M16 p:-5.000000 v:-2.000000 t:-0.020000;"
+    " IMU gx:0.010000 gy:-0.020000 gz:0.030000 pgx:0.001000 pgy:-0.002000 pgz:-0.999900;"
+    " SEQ_NUM: cnt:123457;";
+
+const std::vector<uint8_t> kFrontIds{1, 2, 3, 4, 5, 6, 7, 8};
+const std::vector<uint8_t> kRearIds{9, 10, 11, 12, 13, 14, 15, 16};
+
+struct Obs {
+    float dof_pos[12];
+    float dof_vel[16];
+    float ang_vel[3];
+    float proj_grav[3];
+};
+
+// ──────────────── 기존 파서 (robot.hpp 에서 옮겨 옴) ────────────────
+void scan_motor_pos(const std::string& s, std::vector<std::size_t>& motor_pos) {
+    std::fill(motor_pos.begin(), motor_pos.end(), 0);
+    std::size_t cur = 0;
+    const std::size_t n = s.size();
+    while (cur < n) {
+        std::size_t mpos = s.find('M', cur);
+        if (mpos == std::string::npos) break;
+        std::size_t p = mpos + 1, num = 0;
+        bool has_digit = false;
+        while (p < n && s[p] >= '0' && s[p] <= '9') { has_digit = true; num = num * 10 + (s[p] - '0'); ++p; }
+        if (has_digit && num >= 1 && num < motor_pos.size()) motor_pos[num] = mpos;
+        cur = p;
+    }
+}
+
+bool check_mcu_data(const std::string& s, const std::vector<uint8_t>& ids, std::vector<std::size_t>& motor_pos) {
+    if (s.find("OK <REQ>") == std::string::npos) return false;
+    scan_motor_pos(s, motor_pos);
+    static constexpr const char* kKeys[] = { "p:", "v:", "t:" };
+    for (uint8_t id : ids) {
+        std::size_t mid_pos = (id < motor_pos.size()) ? motor_pos[id] : 0;
+        if (id == 0 || mid_pos == 0) return false;
+        for (const char* key : kKeys) {
+            std::size_t pos = s.find(key, mid_pos);
+            if (pos == std::string::npos) return false;
+            if (pos + 2 < s.size() && s[pos + 2] == 'N') return false;
+        }
+    }
+    return true;
+}
+
+struct Legacy {
+    std::vector<std::size_t> front_pos = std::vector<std::size_t>(17, 0);
+    std::vector<std::size_t> rear_pos = std::vector<std::size_t>(17, 0);
+
+    bool parse(const std::string& front, const std::string& rear, Obs& o) {
+        if (!check_mcu_data(front, kFrontIds, front_pos)) return false;
+        if (!check_mcu_data(rear, kRearIds, rear_pos)) return false;
+        for (int g = 0; g < 16; ++g) {
+            const std::string& str = g < 8 ? front : rear;
+            std::size_t base = (g < 8 ? front_pos : rear_pos)[g + 1];
+            if (g % 8 < 6) {
+                std::size_t ppos = str.find("p:", base);
+                o.dof_pos[g < 8 ? g : g - 2] = std::stof(str.substr(ppos + 2));
+            }
+            std::size_t vpos = str.find("v:", base);
+            o.dof_vel[g] = std::stof(str.substr(vpos + 2));
+        }
+        std::size_t imu = rear.rfind("IMU");
+        const char* keys[] = {"gx:", "gy:", "gz:", "pgx:", "pgy:", "pgz:"};
+        float* dst[] = {&o.ang_vel[0], &o.ang_vel[1], &o.ang_vel[2],
+                        &o.proj_grav[0], &o.proj_grav[1], &o.proj_grav[2]};
+        for (int i = 0; i < 6; ++i) {
+            std::size_t p = rear.find(keys[i], imu);
+            *dst[i] = std::stof(rear.substr(p + std::strlen(keys[i])));
+        }
+        return true;
+    }
+};
+
+// ──────────────── 단일 패스 파서 ────────────────
+struct SinglePass {
+    ReqParser front_p{kFrontIds}, rear_p{kRearIds};
+    ReqMotorState fm[8], rm[8];
+    ReqImu fi, ri;
+
+    bool parse(const std::string& front, const std::string& rear, Obs& o) {
+        bool fimu = false, rimu = false;
+        if (!front_p.parse(front, fm, fi, fimu)) return false;
+        if (!rear_p.parse(rear, rm, ri, rimu)) return false;
+        for (int g = 0; g < 16; ++g) {
+            const ReqMotorState& m = g < 8 ? fm[g] : rm[g - 8];
+            if (g % 8 < 6) o.dof_pos[g < 8 ? g : g - 2] = m.p;
+            o.dof_vel[g] = m.v;
+        }
+        o.ang_vel[0] = ri.gx;   o.ang_vel[1] = ri.gy;   o.ang_vel[2] = ri.gz;
+        o.proj_grav[0] = ri.pgx; o.proj_grav[1] = ri.pgy; o.proj_grav[2] = ri.pgz;
+        return true;
+    }
+};
+
+struct Stat { double ns_per_tick; double allocs_per_tick; };
+
+template <class P>
+Stat bench(P& parser, int iters, Obs& o) {
+    const uint64_t a0 = g_allocs.load();
+    const auto t0 = clock_type::now();
+    for (int i = 0; i < iters; ++i) {
+        if (!parser.parse(kFront, kRear, o)) { std::cerr << "parse failed\n"; std::exit(1); }
+        asm volatile("" : : "g"(&o) : "memory");   // 결과 사용 (최적화로 제거 방지)
+    }
+    const double ns = std::chrono::duration<double, std::nano>(clock_type::now() - t0).count();
+    return { ns / iters, static_cast<double>(g_allocs.load() - a0) / iters };
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iters = 200000;
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--iters") && i + 1 < argc) iters = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else { std::cerr << "usage: " << argv[0] << " [--iters N] [--out FILE]\n"; return 2; }
+    }
+
+    Legacy legacy;
+    SinglePass single;
+    Obs a{}, b{};
+
+    // 결과 일치 확인
+    if (!legacy.parse(kFront, kRear, a) || !single.parse(kFront, kRear, b) ||
+        std::memcmp(&a, &b, sizeof(Obs)) != 0) {
+        std::cerr << "parsers disagree\n";
+        return 1;
+    }
+
+    bench(legacy, iters / 10, a);   // warm-up
+    bench(single, iters / 10, b);
+    const Stat ls = bench(legacy, iters, a);
+    const Stat ss = bench(single, iters, b);
+
+    FILE* f = stdout;
+    if (!out.empty()) {
+        f = std::fopen(out.c_str(), "w");
+        if (!f) { std::perror("fopen"); return 1; }
+    }
+    std::fprintf(f,
+        "{\n  \"iters\": %d,\n  \"bytes_per_tick\": %zu,\n"
+        "  \"legacy\": {\"ns_per_tick\": %.1f, \"allocs_per_tick\": %.2f},\n"
+        "  \"single_pass\": {\"ns_per_tick\": %.1f, \"allocs_per_tick\": %.2f},\n"
+        "  \"speedup\": %.2f\n}\n",
+        iters, kFront.size() + kRear.size(),
+        ls.ns_per_tick, ls.allocs_per_tick, ss.ns_per_tick, ss.allocs_per_tick,
+        ls.ns_per_tick / ss.ns_per_tick);
+    if (f != stdout) std::fclose(f);
+    return 0;
+}
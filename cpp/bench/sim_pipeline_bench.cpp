@@ -0,0 +1,115 @@
+// sim_pipeline_bench.cpp
+//
+// 하드웨어 없이 50 Hz 제어 파이프라인(get_obs → 정책 → do_action → check_safety) 전체를
+// SimBackend 위에서 실시간보다 빠르게 돌린다. 정책 자리는 다리 사인 궤적 + 바퀴 일정 속도.
+//
+//   ticks_per_s    : 초당 처리한 제어 틱 (벽시계 기준)
+//   realtime_factor: plant 시간 / 벽시계 시간
+//   track_rms      : 다리 관절 목표 대비 관측 위치 RMS (rad) — plant가 제어를 따라오는지 확인
+//   estop_ticks    : REQ 응답을 끊은 뒤 RobotEStopError까지 걸린 틱 수 (200 ms 타임아웃 = 10틱 기대)
+//
+// 결과를 JSON으로 출력하고, 실시간보다 느리거나 추종/estop 확인이 실패하면 exit code 1.
+//
+// Usage:
+//   sim_pipeline_bench [--ticks 20000] [--hz 50] [--out result.json]
+
+#include "robot.hpp"
+#include "sim_backend.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+    long ticks = 20000;
+    double hz = 50.0;
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--ticks") && i + 1 < argc) ticks = std::atol(argv[++i]);
+        else if (!std::strcmp(argv[i], "--hz") && i + 1 < argc) hz = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else { std::cerr << "usage: " << argv[0] << " [--ticks N] [--hz HZ] [--out FILE]\n"; return 2; }
+    }
+
+    robot::SimOptions so;
+    so.dt_ms = 1000.0 / hz;
+    auto backend = std::make_unique<robot::SimBackend>(so);
+    robot::SimBackend* sim = backend.get();
+    robot::Robot r(std::move(backend));
+    r.set_control_period(1000.0 / hz);
+
+    std::vector<float> kp(16, 20.0f), kd(16, 0.5f);
+    kp[6] = kp[7] = kp[14] = kp[15] = 0.0f;
+    r.set_gains(kp, kd);
+
+    // 1) 정상 제어: 다리 0.3 rad / 0.5 Hz 사인, 바퀴 2 rad/s
+    std::vector<float> action(16, 0.0f);
+    double se = 0.0;
+    long n_err = 0;
+    const long warmup = static_cast<long>(hz);   // 첫 1초는 과도 응답이므로 추종 오차에서 제외
+    const auto t0 = std::chrono::steady_clock::now();
+    for (long t = 0; t < ticks; ++t) {
+        const ObsFrame& obs = r.get_obs();
+        if (t > warmup) {
+            // 관측은 직전 목표를 한 틱 동안 따라간 결과
+            for (size_t j = 0; j < ObsFrame::kDofPos; ++j) {
+                const size_t a = j < 6 ? j : j + 2;
+                const double e = obs.dof_pos[j] - action[a];
+                se += e * e;
+                ++n_err;
+            }
+        }
+        const double ph = 2.0 * M_PI * 0.5 * t / hz;
+        for (size_t i = 0; i < 16; ++i) {
+            const bool wheel = i % 8 >= 6;
+            action[i] = wheel ? 2.0f : static_cast<float>(0.3 * std::sin(ph + 0.4 * i));
+        }
+        r.do_action(action);
+    }
+    const double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    const robot::SimSnapshot st = sim->snapshot();
+    const double sim_s = st.t_ns * 1e-9;
+    const double track_rms = n_err ? std::sqrt(se / n_err) : 0.0;
+
+    // 2) 응답 끊김 → 연결 타임아웃 RobotEStopError → 호출자가 estop()
+    sim->drop_reqs(1000000);
+    long estop_ticks = -1;
+    for (long t = 0; t < 100; ++t) {
+        try {
+            r.get_obs();
+            r.do_action(action);
+        } catch (const robot::RobotEStopError& e) {
+            estop_ticks = t + 1;
+            try { r.estop(e.what()); } catch (const robot::RobotEStopError&) {}   // play.py / ControlLoop처럼 보드 정지
+            break;
+        }
+    }
+    const bool estopped = sim->snapshot().estopped;
+
+    const double rtf = wall_s > 0.0 ? sim_s / wall_s : 0.0;
+    const bool ok = rtf > 1.0 && track_rms < 0.1 && estop_ticks > 0 && estopped;
+
+    FILE* f = stdout;
+    if (!out.empty()) {
+        f = std::fopen(out.c_str(), "w");
+        if (!f) { std::perror("fopen"); return 1; }
+    }
+    std::fprintf(f,
+        "{\n  \"config\": {\"ticks\": %ld, \"hz\": %.1f},\n"
+        "  \"wall_s\": %.3f,\n  \"sim_s\": %.3f,\n"
+        "  \"ticks_per_s\": %.0f,\n  \"realtime_factor\": %.1f,\n"
+        "  \"us_per_tick\": %.2f,\n"
+        "  \"track_rms\": %.4f,\n"
+        "  \"estop_ticks\": %ld,\n  \"plant_estopped\": %s,\n"
+        "  \"ok\": %s\n}\n",
+        ticks, hz, wall_s, sim_s, ticks / wall_s, rtf, wall_s * 1e6 / ticks,
+        track_rms, estop_ticks, estopped ? "true" : "false", ok ? "true" : "false");
+    if (f != stdout) std::fclose(f);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+// topology_bench.cpp
+//
+// 컴파일 타임 topology(topology.hpp)로 같은 Robot 코드를 두 기구에 대해 특수화해 돌린다.
+//   - W4Topology    : 보드 2 × (다리 6 + 바퀴 2) = 16 모터 (기본 Robot)
+//   - W2Topology    : 보드 1 × (다리 4 + 바퀴 2) =  6 모터 (예시용 두 번째 기구)
+//
+// 각각 SimBackend 위에서 get_obs → do_action 파이프라인을 돌려
+//   - 관측 조립이 topology 표대로인지 (dof_pos[j] == plant q[kJointMotor[j]], dof_vel == dq)
+//   - 바퀴는 속도, 관절은 위치 목표로 나가는지 (plant가 관절은 목표 자세, 바퀴는 목표 속도로 수렴)
+// 를 확인하고 틱당 시간(ns)을 잰다.
+//
+// 결과를 JSON으로 출력하고, 매핑/수렴 확인이 실패하면 exit code 1.
+//
+// Usage:
+//   topology_bench [--ticks 20000] [--out result.json]
+
+#include "robot.hpp"
+#include "sim_backend.hpp"
+#include "topology.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 한 보드에 다리 4관절 + 바퀴 2개
+struct W2Topology : Topology<1, 4, 2> {
+    static constexpr std::array<std::string_view, kJoints> kJointNames = {
+        "left_hip", "right_hip", "left_leg", "right_leg",
+    };
+};
+
+struct Result {
+    double ns_per_tick = 0.0;
+    double max_map_err = 0.0;    // 관측 ↔ plant 상태 (매핑 확인)
+    double max_track_err = 0.0;  // 목표 ↔ plant 상태 (관절 위치 rad / 바퀴 속도 비율)
+    size_t motors = 0, joints = 0;
+    std::string error;
+};
+
+template <class Topo>
+Result run(long ticks) {
+    using R = robot::BasicRobot<Topo>;
+    Result res;
+    res.motors = Topo::kMotors;
+    res.joints = Topo::kJoints;
+
+    robot::SimOptions so;
+    so.wheels_per_board = Topo::kWheelsPerBoard;
+    auto backend = std::make_unique<robot::SimBackend>(so, Topo::board_ids());
+    robot::SimBackend* sim = backend.get();
+    R r(std::move(backend), std::make_shared<rt::VirtualClock>());
+
+    // 관절: 위치 gain, 바퀴: 속도 gain만 (kp 0)
+    constexpr auto kp = Topo::per_motor(20.0f, 0.0f);
+    constexpr auto kd = Topo::per_motor(0.5f, 2.0f);
+    r.set_gains({kp.begin(), kp.end()}, {kd.begin(), kd.end()});
+
+    // 관절 j → 0.05 (j+1) rad, 바퀴 w → 1 + w rad/s
+    std::vector<float> action(Topo::kMotors);
+    for (size_t j = 0; j < Topo::kJoints; ++j) action[Topo::kJointMotor[j]] = 0.05f * (j + 1);
+    for (size_t w = 0; w < Topo::kWheels; ++w) action[Topo::kWheelMotor[w]] = 1.0f + w;
+
+    try {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (long i = 0; i < ticks; ++i) {
+            const typename R::Frame& obs = r.get_obs();
+            if (i + 1 == ticks) {   // 마지막 틱: 관측이 plant 상태를 topology 표대로 옮겼는지
+                const robot::SimSnapshot st = sim->snapshot();
+                for (size_t j = 0; j < Topo::kJoints; ++j)
+                    res.max_map_err = std::max<double>(res.max_map_err,
+                                               std::fabs(obs.dof_pos[j] - st.q[Topo::kJointMotor[j]]));
+                for (size_t g = 0; g < Topo::kMotors; ++g)
+                    res.max_map_err = std::max<double>(res.max_map_err, std::fabs(obs.dof_vel[g] - st.dq[g]));
+                for (size_t j = 0; j < Topo::kJoints; ++j)
+                    res.max_track_err = std::max<double>(res.max_track_err,
+                                                 std::fabs(obs.dof_pos[j] - action[Topo::kJointMotor[j]]));
+                for (size_t w = 0; w < Topo::kWheels; ++w) {   // 바퀴: 점성 마찰만큼 목표보다 느림 → 비율로
+                    const size_t g = Topo::kWheelMotor[w];
+                    res.max_track_err = std::max<double>(res.max_track_err, std::fabs(obs.dof_vel[g] / action[g] - 1.0f));
+                }
+            }
+            r.do_action(action);
+        }
+        res.ns_per_tick = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / ticks;
+    } catch (const std::exception& e) {
+        res.error = e.what();
+    }
+    return res;
+}
+
+void print(FILE* f, const char* name, const Result& r, bool last) {
+    std::fprintf(f,
+        "  \"%s\": {\"motors\": %zu, \"joints\": %zu, \"ns_per_tick\": %.1f, "
+        "\"max_map_err\": %.6f, \"max_track_err\": %.4f, \"error\": \"%s\"}%s\n",
+        name, r.motors, r.joints, r.ns_per_tick, r.max_map_err, r.max_track_err, r.error.c_str(), last ? "" : ",");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long ticks = 20000;
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--ticks") && i + 1 < argc) ticks = std::atol(argv[++i]);
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else { std::cerr << "usage: " << argv[0] << " [--ticks N] [--out FILE]\n"; return 2; }
+    }
+    if (ticks < 500) ticks = 500;   // 수렴 확인에 최소 10초 (50 Hz)
+
+    const Result w4 = run<W4Topology>(ticks);
+    const Result w2 = run<W2Topology>(ticks);
+
+    auto good = [](const Result& r) { return r.error.empty() && r.max_map_err < 1e-6 && r.max_track_err < 0.05; };
+    const bool ok = good(w4) && good(w2);
+
+    FILE* f = stdout;
+    if (!out.empty()) {
+        f = std::fopen(out.c_str(), "w");
+        if (!f) { std::perror("fopen"); return 1; }
+    }
+    std::fprintf(f, "{\n  \"config\": {\"ticks\": %ld},\n", ticks);
+    print(f, "w4", w4, false);
+    print(f, "w2", w2, false);
+    std::fprintf(f, "  \"ok\": %s\n}\n", ok ? "true" : "false");
+    if (f != stdout) std::fclose(f);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+// torque_mode_bench.cpp
+//
+// 네이티브 토크 모드(Robot::do_torque, 관절 임피던스 법칙 → tau만 송신)를 SimBackend 위에서
+// 같은 gain으로 두 주기에 돌려 비교한다 (가상 시계, 시간 = REQ 횟수 × 주기).
+//   - 50 Hz  : 토크를 정책 주기로만 계산 (Python 루프에서 do_action(torque_ctrl=True)로 보내던 것과 같은 속도)
+//   - 500 Hz : 전송 주기마다 최신 상태로 다시 계산, setpoint는 50 Hz로만 갱신 (ControlLoop multi-rate + torque)
+//
+// 정책 자리: 다리 0.3 rad / 0.5 Hz 사인, 바퀴 2 rad/s. 기본 gain(kp 200, kd 3)은 보드 MIT 루프라면
+// 문제없는 강성이지만, 토크를 20 ms 동안 붙잡고 있으면 (kp dt^2 / J ≈ 4) 진동한다.
+//
+//   track_rms   : setpoint 대비 다리 관측 위치 RMS (rad, 첫 1초 제외)
+//   max_err     : 다리 최대 오차 (rad) — 50 Hz에서는 토크 유지 시간이 길어 진동 / 발산
+//   do_torque_ns: get_obs 제외 do_torque 1회 (법칙 계산 + 송신 + check_safety, sim)
+//
+// 결과를 JSON으로 출력하고, 500 Hz가 추종하지 못하거나 50 Hz보다 나쁘면 exit code 1.
+//
+// Usage:
+//   torque_mode_bench [--seconds 20] [--kp 200] [--kd 3] [--out result.json]
+
+#include "robot.hpp"
+#include "sim_backend.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Topo = robot::Robot::Topology;
+
+struct Result {
+    double track_rms = 0.0, max_err = 0.0, do_torque_ns = 0.0;
+    std::string error;
+};
+
+Result run(double hz, double policy_hz, double seconds, float kp, float kd) {
+    Result res;
+    const double period_ms = 1000.0 / hz;
+    robot::SimOptions so;
+    so.dt_ms = period_ms;
+    robot::Robot r(std::make_unique<robot::SimBackend>(so), std::make_shared<rt::VirtualClock>());
+    r.set_control_period(period_ms);
+
+    ImpedanceOptions io;
+    io.kp.assign(Topo::kMotors, 0.0f);
+    io.kd.assign(Topo::kMotors, 0.0f);
+    io.tau_limit.assign(Topo::kMotors, 30.0f);
+    for (size_t g = 0; g < Topo::kMotors; ++g) {
+        io.kp[g] = Topo::is_wheel(g) ? 0.0f : kp;
+        io.kd[g] = Topo::is_wheel(g) ? 2.0f : kd;
+    }
+    r.set_impedance(io);
+
+    const long ticks = static_cast<long>(seconds * hz);
+    const long per_policy = std::max(1L, std::lround(hz / policy_hz));
+    std::vector<float> sp(Topo::kMotors, 0.0f);
+    double se = 0.0, ns = 0.0;
+    long n_err = 0;
+    try {
+        for (long t = 0; t < ticks; ++t) {
+            const ObsFrame& obs = r.get_obs();
+            if (t > static_cast<long>(hz)) {
+                for (size_t j = 0; j < Topo::kJoints; ++j) {
+                    const double e = obs.dof_pos[j] - sp[Topo::kJointMotor[j]];
+                    se += e * e;
+                    ++n_err;
+                    res.max_err = std::max(res.max_err, std::fabs(e));
+                }
+            }
+            if (t % per_policy == 0) {   // 정책 틱: setpoint 갱신
+                const double ph = 2.0 * M_PI * 0.5 * t / hz;
+                for (size_t g = 0; g < Topo::kMotors; ++g)
+                    sp[g] = Topo::is_wheel(g) ? 2.0f : static_cast<float>(0.3 * std::sin(ph + 0.4 * g));
+            }
+            const auto t0 = std::chrono::steady_clock::now();
+            r.do_torque(sp);
+            ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        }
+    } catch (const std::exception& e) {
+        res.error = e.what();
+    }
+    res.track_rms = n_err ? std::sqrt(se / n_err) : 0.0;
+    res.do_torque_ns = ticks ? ns / ticks : 0.0;
+    return res;
+}
+
+void print(FILE* f, const char* name, const Result& r) {
+    std::fprintf(f,
+        "  \"%s\": {\"track_rms\": %.4f, \"max_err\": %.4f, \"do_torque_ns\": %.1f, \"error\": \"%s\"},\n",
+        name, r.track_rms, r.max_err, r.do_torque_ns, r.error.c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = 20.0;
+    float kp = 200.0f, kd = 3.0f;
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--kp") && i + 1 < argc) kp = static_cast<float>(std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--kd") && i + 1 < argc) kd = static_cast<float>(std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else {
+            std::cerr << "usage: " << argv[0] << " [--seconds S] [--kp KP] [--kd KD] [--out FILE]\n";
+            return 2;
+        }
+    }
+    if (seconds < 3.0) seconds = 3.0;
+
+    const Result slow = run(50.0, 50.0, seconds, kp, kd);
+    const Result fast = run(500.0, 50.0, seconds, kp, kd);
+
+    const bool ok = fast.error.empty() && fast.track_rms < 0.05 && fast.track_rms < slow.track_rms;
+
+    FILE* f = stdout;
+    if (!out.empty()) {
+        f = std::fopen(out.c_str(), "w");
+        if (!f) { std::perror("fopen"); return 1; }
+    }
+    std::fprintf(f, "{\n  \"config\": {\"seconds\": %.1f, \"kp\": %.2f, \"kd\": %.2f},\n", seconds, kp, kd);
+    print(f, "torque_50hz", slow);
+    print(f, "torque_500hz", fast);
+    std::fprintf(f, "  \"ok\": %s\n}\n", ok ? "true" : "false");
+    if (f != stdout) std::fclose(f);
+    return ok ? 0 : 1;
+}
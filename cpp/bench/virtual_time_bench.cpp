@@ -0,0 +1,154 @@
+// virtual_time_bench.cpp
+//
+// 가상 시계(rt::VirtualClock) 위에서 wake() 램프 + ControlLoop(lockstep, max_ticks)를
+// SimBackend로 끝까지 돌린다. 대기는 시각만 넘기므로 7초 램프와 수만 틱이 CPU 속도로 끝난다.
+// 같은 설정으로 두 번 돌려 최종 plant 상태가 비트 단위로 같은지(재현성)도 확인한다.
+//
+//   wake_wall_ms   : wake() 벽시계 시간 (wake_virtual_ms: 같은 구간의 가상 시각)
+//   ticks_per_s    : ControlLoop가 초당 처리한 틱 (벽시계 기준)
+//   speedup        : 가상 시각 / 벽시계 시간
+//   step_ns_last   : 마지막 틱의 get_obs → 정책 → do_action 벽시계 시간 (telemetry.step_ns)
+//   reproducible   : 두 실행의 최종 q/dq/rpy와 틱 수가 동일
+//
+// 결과를 JSON으로 출력하고, 실시간보다 느리거나 재현성/틱 수 확인이 실패하면 exit code 1.
+//
+// Usage:
+//   virtual_time_bench [--ticks 100000] [--hz 50] [--out result.json]
+
+#include "control_loop.hpp"
+#include "robot.hpp"
+#include "rt_clock.hpp"
+#include "sim_backend.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct RunResult {
+    double wake_wall_s = 0.0;
+    double wake_virtual_s = 0.0;
+    double loop_wall_s = 0.0;
+    double virtual_s = 0.0;
+    uint64_t ticks = 0;
+    uint64_t overruns = 0;
+    int64_t step_ns_last = 0;
+    std::string error;
+    robot::SimSnapshot st;
+};
+
+RunResult run(long ticks, double hz) {
+    RunResult res;
+
+    robot::SimOptions so;
+    so.dt_ms = 1000.0 / hz;
+    so.pos_noise = 1e-3;   // 잡음까지 seed로 고정되어야 재현됨
+    so.vel_noise = 1e-2;
+    so.seed = 7;
+    auto backend = std::make_unique<robot::SimBackend>(so);
+    robot::SimBackend* sim = backend.get();
+    auto clock = std::make_shared<rt::VirtualClock>();
+    robot::Robot r(std::move(backend), clock);
+    r.set_control_period(1000.0 / hz);
+
+    std::vector<float> kp(16, 20.0f), kd(16, 0.5f);
+    kp[6] = kp[7] = kp[14] = kp[15] = 0.0f;
+    r.set_gains(kp, kd);
+
+    // 1) wake(): 램프/대기가 모두 가상 시각
+    auto t0 = std::chrono::steady_clock::now();
+    r.wake();
+    res.wake_wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    res.wake_virtual_s = clock->now_ns() * 1e-9;
+
+    // 2) ControlLoop: 다리 사인 + 바퀴 일정 속도, max_ticks에서 스스로 종료
+    long n = 0;
+    robot::ControlLoop::Step step = [&](const ObsFrame&, const robot::LoopCommand&, std::span<float> action) {
+        const double ph = 2.0 * M_PI * 0.5 * n++ / hz;
+        for (size_t i = 0; i < action.size(); ++i) {
+            const bool wheel = i % 8 >= 6;
+            action[i] = wheel ? 2.0f : static_cast<float>(0.3 * std::sin(ph + 0.4 * i));
+        }
+    };
+    robot::LoopOptions lo;
+    lo.hz = hz;
+    lo.fifo_prio = 0;
+    lo.max_ticks = static_cast<uint64_t>(ticks);
+    robot::ControlLoop loop(r, step, lo);
+
+    const int64_t v0 = clock->now_ns();
+    t0 = std::chrono::steady_clock::now();
+    loop.start();
+    loop.wait();
+    res.loop_wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    res.virtual_s = (clock->now_ns() - v0) * 1e-9;
+
+    const robot::LoopTelemetry tm = loop.telemetry();
+    res.ticks = tm.tick;
+    res.overruns = tm.overruns;
+    res.step_ns_last = tm.step_ns;
+    res.error = loop.error();
+    res.st = sim->snapshot();
+    return res;
+}
+
+bool same_state(const robot::SimSnapshot& a, const robot::SimSnapshot& b) {
+    return a.t_ns == b.t_ns && a.q == b.q && a.dq == b.dq && a.rpy == b.rpy && a.reqs == b.reqs;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long ticks = 100000;
+    double hz = 50.0;
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--ticks") && i + 1 < argc) ticks = std::atol(argv[++i]);
+        else if (!std::strcmp(argv[i], "--hz") && i + 1 < argc) hz = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else { std::cerr << "usage: " << argv[0] << " [--ticks N] [--hz HZ] [--out FILE]\n"; return 2; }
+    }
+
+    RunResult a, b;
+    try {
+        a = run(ticks, hz);
+        b = run(ticks, hz);
+    } catch (const std::exception& e) {
+        std::cerr << "virtual_time_bench: " << e.what() << "\n";
+        return 1;
+    }
+
+    const bool reproducible = same_state(a.st, b.st) && a.ticks == b.ticks;
+    const double speedup = a.loop_wall_s > 0.0 ? a.virtual_s / a.loop_wall_s : 0.0;
+    const bool ok = a.error.empty() && a.ticks == static_cast<uint64_t>(ticks) && a.overruns == 0 &&
+                    speedup > 1.0 && reproducible;
+
+    FILE* f = stdout;
+    if (!out.empty()) {
+        f = std::fopen(out.c_str(), "w");
+        if (!f) { std::perror("fopen"); return 1; }
+    }
+    std::fprintf(f,
+        "{\n  \"config\": {\"ticks\": %ld, \"hz\": %.1f},\n"
+        "  \"wake_wall_ms\": %.3f,\n  \"wake_virtual_ms\": %.1f,\n"
+        "  \"loop_wall_s\": %.3f,\n  \"virtual_s\": %.3f,\n"
+        "  \"ticks_per_s\": %.0f,\n  \"speedup\": %.1f,\n"
+        "  \"step_ns_last\": %lld,\n"
+        "  \"ticks\": %llu,\n  \"overruns\": %llu,\n"
+        "  \"reproducible\": %s,\n  \"error\": \"%s\",\n"
+        "  \"ok\": %s\n}\n",
+        ticks, hz, a.wake_wall_s * 1e3, a.wake_virtual_s * 1e3, a.loop_wall_s, a.virtual_s,
+        a.loop_wall_s > 0.0 ? a.ticks / a.loop_wall_s : 0.0, speedup,
+        static_cast<long long>(a.step_ns_last),
+        static_cast<unsigned long long>(a.ticks), static_cast<unsigned long long>(a.overruns),
+        reproducible ? "true" : "false", a.error.c_str(), ok ? "true" : "false");
+    if (f != stdout) std::fclose(f);
+    return ok ? 0 : 1;
+}
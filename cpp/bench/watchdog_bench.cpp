@@ -0,0 +1,137 @@
+// watchdog_bench.cpp
+//
+// Robot watchdog 반응 시간 측정. 내장 FxEmulator 두 대(앞/뒤 보드)에 Robot을 붙이고
+// 매 시행마다 50 Hz로 get_obs + do_action 을 잠깐 돌린 뒤 호출을 멈춘다 (Python 정지 흉내).
+// watchdog이 action 타임아웃을 감지해 보낸 AT+ESTOP이 에뮬레이터에 도착한 시각과
+// 타임아웃 마감 시각의 차이를 반응 시간으로 기록한다.
+//
+//   reaction   : 마감 → 보드가 ESTOP 수신
+//   detect     : 마감 → watchdog 감지 (주기 + 스케줄링 지연)
+//   estop_post : 감지 → 모든 보드에 ESTOP 송신 완료
+//
+// 시행마다 다음 do_action()이 RobotEStopError를 던지는지(래치)도 확인한다.
+// 결과를 JSON으로 출력하고, 감지 실패/래치 실패가 있으면 exit code 1.
+//
+// Usage:
+//   watchdog_bench [--trials 20] [--timeout-ms 50] [--period-ms 1] [--port 15901] [--out result.json]
+
+#include "robot.hpp"
+#include "fx_emulator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Summary { double p50, p99, max; };
+
+Summary summarize(std::vector<double> v) {
+    if (v.empty()) return {0, 0, 0};
+    std::sort(v.begin(), v.end());
+    auto pick = [&](double p) { return v[std::min(v.size() - 1, static_cast<size_t>(p * (v.size() - 1) + 0.5))]; };
+    return {pick(0.50), pick(0.99), v.back()};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int trials = 20;
+    double timeout_ms = 50.0, period_ms = 1.0;
+    uint16_t port = 15901;
+    std::string out;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--trials") && i + 1 < argc) trials = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--timeout-ms") && i + 1 < argc) timeout_ms = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--period-ms") && i + 1 < argc) period_ms = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--port") && i + 1 < argc) port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) out = argv[++i];
+        else {
+            std::cerr << "usage: " << argv[0] << " [--trials N] [--timeout-ms MS] [--period-ms MS] [--port N] [--out FILE]\n";
+            return 2;
+        }
+    }
+
+    FxEmulator::Options fo, ro;
+    fo.port = port;                         fo.motor_ids = {1, 2, 3, 4, 5, 6, 7, 8};  fo.imu = false;
+    ro.port = static_cast<uint16_t>(port + 1); ro.motor_ids = {9, 10, 11, 12, 13, 14, 15, 16};
+    FxEmulator front(fo), rear(ro);
+    std::atomic<bool> run{true};
+    std::thread emu([&] { FxEmulator::serve_all({&front, &rear}, run); });
+
+    std::vector<double> reaction_us, detect_us, post_us;
+    int64_t max_gap_ns = 0;
+    int missed = 0, unlatched = 0;
+    WatchdogOptions wo;
+    wo.period_ms = period_ms;
+    wo.action_timeout_ms = timeout_ms;
+    wo.obs_timeout_ms = timeout_ms;
+    const std::vector<float> action(16, 0.0f);
+
+    for (int t = 0; t < trials; ++t) {
+        // 시행마다 새 Robot: 생성자가 AT+START로 ESTOP 상태를 풀어 준다
+        robot::Robot r({{"127.0.0.1", fo.port, fo.motor_ids}, {"127.0.0.1", ro.port, ro.motor_ids}});
+        std::vector<float> kp(16, 10.0f), kd(16, 0.5f);
+        kp[6] = kp[7] = kp[14] = kp[15] = 0.0f;
+        r.set_gains(kp, kd);
+
+        r.start_watchdog(wo);
+        for (int i = 0; i < 10; ++i) {   // 정상 제어 200 ms
+            r.get_obs();
+            r.do_action(action);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+
+        // 호출 중단 → watchdog 발동 대기 (마감 + 여유)
+        const uint64_t n0 = rear.estop_count();
+        const auto give_up = std::chrono::steady_clock::now() + std::chrono::milliseconds(static_cast<int>(timeout_ms * 4) + 200);
+        while (rear.estop_count() == n0 && std::chrono::steady_clock::now() < give_up)
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+
+        const Watchdog* wd = r.watchdog();
+        if (!wd->tripped() || rear.estop_count() == n0) { ++missed; continue; }
+        const WatchdogTrip tr = wd->trip();
+        const int64_t arrived = std::min(front.last_estop_ns(), rear.last_estop_ns());
+        reaction_us.push_back((arrived - tr.deadline_ns) / 1000.0);
+        detect_us.push_back((tr.detect_ns - tr.deadline_ns) / 1000.0);
+        post_us.push_back(tr.estop_ns / 1000.0);
+        max_gap_ns = std::max(max_gap_ns, wd->stats().max_gap_ns);
+
+        try {
+            r.do_action(action);   // 래치: 정식 estop → 예외
+            ++unlatched;
+        } catch (const robot::RobotEStopError&) {}
+    }
+    run = false;
+    emu.join();
+
+    const Summary rs = summarize(reaction_us), ds = summarize(detect_us), ps = summarize(post_us);
+    const bool ok = missed == 0 && unlatched == 0;
+
+    FILE* f = stdout;
+    if (!out.empty()) {
+        f = std::fopen(out.c_str(), "w");
+        if (!f) { std::perror("fopen"); return 1; }
+    }
+    std::fprintf(f,
+        "{\n  \"config\": {\"trials\": %d, \"timeout_ms\": %.1f, \"period_ms\": %.2f},\n"
+        "  \"reaction_us\": {\"p50\": %.1f, \"p99\": %.1f, \"max\": %.1f},\n"
+        "  \"detect_us\": {\"p50\": %.1f, \"p99\": %.1f, \"max\": %.1f},\n"
+        "  \"estop_post_us\": {\"p50\": %.1f, \"p99\": %.1f, \"max\": %.1f},\n"
+        "  \"max_check_gap_us\": %.1f,\n"
+        "  \"bound_us\": %.1f,\n"
+        "  \"missed\": %d,\n  \"unlatched\": %d,\n  \"ok\": %s\n}\n",
+        trials, timeout_ms, period_ms,
+        rs.p50, rs.p99, rs.max, ds.p50, ds.p99, ds.max, ps.p50, ps.p99, ps.max,
+        max_gap_ns / 1000.0, (max_gap_ns / 1000.0) + ps.max,
+        missed, unlatched, ok ? "true" : "false");
+    if (f != stdout) std::fclose(f);
+    return ok ? 0 : 1;
+}
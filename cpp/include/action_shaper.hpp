@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+struct ShaperOptions {
+  std::vector<float> max_rate;   ///< per action entry, units/s (joints rad/s, wheels rad/s^2); empty / <= 0: no limit
+  float smooth_ms = 0.0f;        ///< first-order smoothing time constant (0: off)
+  int   sub_ticks = 1;           ///< MIT frames per control period, targets interpolated linearly across them
+};
+
+/**
+ * @brief Shapes policy actions into MIT targets between do_action() and the send.
+ *
+ * A new target (set_target(), once per control period) is not sent as a step:
+ * each of the period's sub_ticks frames (step()) moves the output y toward it
+ *
+ *   ref  = from + (to - from) * k / sub_ticks   (linear interpolation, k = 1..sub_ticks)
+ *   y   += alpha (ref - y)                      (first order, alpha = 1 - exp(-dt / smooth))
+ *   y   += clamp(Δy, ±max_rate dt)              (slew-rate limit per action entry)
+ *
+ * with dt = control period / sub_ticks; from is where the interpolation had got
+ * to when the target arrived, so an early target continues from there. After
+ * the last sub-tick ref holds the target while smoothing / slew catch up.
+ *
+ * State lives in fixed, 16-byte aligned arrays padded to a multiple of 4
+ * lanes and the per-frame loop is branch-free (min / max), so it vectorizes;
+ * no allocation after configure(). Units are those of the action (joint
+ * position before offsets, wheel velocity).
+ */
+template <size_t N>
+class ActionShaper {
+public:
+  static constexpr size_t kLanes = 4;
+  static constexpr size_t kPadded = (N + kLanes - 1) / kLanes * kLanes;
+  static constexpr int kMaxSubTicks = 16;
+
+  ActionShaper() { configure({}, 20.0); }
+
+  /// @param opt options (validated by the caller: max_rate empty or N entries, sub_ticks in [1, kMaxSubTicks])
+  void configure(const ShaperOptions& opt, double period_ms) {
+    _sub_ticks = opt.sub_ticks;
+    _smooth_ms = opt.smooth_ms;
+    for (size_t i = 0; i < kPadded; ++i)
+      _rate[i] = i < opt.max_rate.size() && opt.max_rate[i] > 0.0f ? opt.max_rate[i] : 0.0f;
+    set_period(period_ms);
+    reset();
+  }
+
+  /// @brief Control period changed (Robot::set_control_period): recompute per-frame gain and steps.
+  void set_period(double period_ms) {
+    const double dt_ms = period_ms / _sub_ticks;
+    _alpha = _smooth_ms > 0.0f ? static_cast<float>(1.0 - std::exp(-dt_ms / _smooth_ms)) : 1.0f;
+    for (size_t i = 0; i < kPadded; ++i)   // 제한 없음: 큰 유한값 (-ffast-math에서도 안전)
+      _step[i] = _rate[i] > 0.0f ? static_cast<float>(_rate[i] * dt_ms * 1e-3) : 1e30f;
+  }
+
+  /// @brief Forget the output; the next set_target() (or prime()) starts from its value.
+  void reset() { _primed = false; }
+
+  /// @brief Start from @p y (N values) without ramping toward it.
+  void prime(const float* y) {
+    std::fill(std::begin(_y), std::end(_y), 0.0f);
+    std::copy(y, y + N, _y);
+    std::copy(std::begin(_y), std::end(_y), _from);
+    std::copy(std::begin(_y), std::end(_y), _to);
+    _k = _sub_ticks;
+    _primed = true;
+  }
+
+  bool primed() const { return _primed; }
+  int sub_ticks() const { return _sub_ticks; }
+
+  /// @brief New target (N values). The first one after reset() is taken as-is.
+  void set_target(const float* a) {
+    if (!_primed) prime(a);
+    // 보간 시작점 = 지금까지 간 지점 (주기 중간에 새 목표가 와도 튀지 않음)
+    const float s = static_cast<float>(_k) / _sub_ticks;
+    for (size_t i = 0; i < kPadded; ++i) _from[i] += (_to[i] - _from[i]) * s;
+    std::copy(a, a + N, _to);
+    _k = 0;
+  }
+
+  /// @brief Next frame of the current period; @return the output (N values, valid until the next call).
+  const float* step() {
+    if (_k < _sub_ticks) ++_k;
+    const float s = static_cast<float>(_k) / _sub_ticks;
+    const float alpha = _alpha;
+    for (size_t i = 0; i < kPadded; ++i) {
+      const float ref = _from[i] + (_to[i] - _from[i]) * s;
+      const float d = alpha * (ref - _y[i]);
+      _y[i] += std::min(std::max(d, -_step[i]), _step[i]);
+    }
+    return _y;
+  }
+
+  /// @brief Last output (N values).
+  const float* output() const { return _y; }
+
+private:
+  alignas(16) float _y[kPadded] = {};      // 출력 (마지막으로 보낸 값)
+  alignas(16) float _from[kPadded] = {};   // 보간 시작
+  alignas(16) float _to[kPadded] = {};     // 목표
+  alignas(16) float _rate[kPadded] = {};   // max_rate (0: 제한 없음)
+  alignas(16) float _step[kPadded] = {};   // 프레임당 최대 변화 = rate * dt
+  float _alpha = 1.0f;
+  float _smooth_ms = 0.0f;
+  int _sub_ticks = 1;
+  int _k = 1;                               // 이번 주기에 보낸 sub-tick 수
+  bool _primed = false;
+};
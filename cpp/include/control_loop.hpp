@@ -0,0 +1,491 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "robot.hpp"      // Robot, RobotEStopError, RobotSleepError
+#include "obs_frame.hpp"
+#include "rt_clock.hpp"     // 루프 시각: Robot과 같은 시계 (가상 시계면 lockstep 가속)
+#include "rt_thread.hpp"
+#include "seq_slot.hpp"   // lock-free command / telemetry slots
+
+namespace robot {
+
+/// @brief Command pushed from Python (or any non-RT thread) to the loop.
+struct LoopCommand {
+    static constexpr size_t kMaxCmd = 8;
+
+    float    cmd[kMaxCmd];   ///< cmd_vector (joystick: vx, vy, yaw, ...)
+    uint32_t cmd_len;
+    int32_t  mode_id;        ///< -1: no mode change
+    uint64_t seq;            ///< set_command() counter
+};
+
+/// @brief Snapshot published by the loop after every (I/O) tick.
+struct LoopTelemetry {
+    ObsFrame obs;                    ///< observation used this tick
+    float    action[ObsFrame::kLastAction];   ///< targets sent this tick (interpolated in multi-rate mode)
+    uint64_t tick;
+    uint64_t overruns;               ///< ticks that finished after the next deadline
+    int64_t  jitter_ns;              ///< wake-up time - deadline, this tick
+    int64_t  max_jitter_ns;          ///< max |jitter_ns| since start()
+    int64_t  step_ns;                ///< lockstep: get_obs → do_action; multi-rate: get_obs + do_action (wall time)
+    uint64_t policy_tick;            ///< step() calls (== tick in lockstep mode)
+    uint64_t policy_overruns;        ///< multi-rate: policy ticks that missed their deadline
+    int64_t  policy_step_ns;         ///< multi-rate: step() time of the latest policy tick
+    int64_t  obs_to_action_ns;       ///< board reply received → targets sent, this tick (Robot::obs_to_action_ns)
+    int64_t  max_obs_to_action_ns;   ///< max obs_to_action_ns since start()
+    uint8_t  running;
+    uint8_t  waking;                 ///< this tick advanced Robot::wake_step() instead of the policy
+    uint8_t  reserved_[6];
+};
+
+/// @brief How the I/O loop moves toward the latest policy target (multi-rate mode).
+enum class LoopInterp : uint8_t {
+    Zero,        ///< hold the target as-is until the next one
+    Linear,      ///< ramp from the last sent action to the new target over one policy period
+    FirstOrder,  ///< first-order hold: extrapolate along the last two targets, at most one period ahead
+};
+
+struct LoopOptions {
+    double  hz = 50.0;          ///< policy (step) rate
+    int64_t spin_ns = 200000;   ///< busy-spin this long before each deadline (0: sleep only)
+    int     fifo_prio = 80;     ///< SCHED_FIFO priority (0: keep the default policy)
+    int     cpu = -1;           ///< pin the loop thread to this CPU (-1: no pinning)
+    bool    lock_memory = false; ///< mlockall(MCL_CURRENT | MCL_FUTURE) on start
+
+    /// 0: lockstep (one get_obs/step/do_action per 1/hz).
+    /// >hz: multi-rate — get_obs/do_action at inner_hz, step at hz on a second thread.
+    double     inner_hz = 0.0;
+    LoopInterp interp = LoopInterp::Linear;
+
+    /// Send the step output through Robot::do_torque (native impedance / torque law on the
+    /// tick's observation, tau-only frames) instead of do_action. With inner_hz the law runs at
+    /// inner_hz on every fresh state while step() only moves the setpoints.
+    bool torque = false;
+
+    uint64_t max_ticks = 0;     ///< stop by itself after this many (I/O) ticks (0: run until stop())
+};
+
+/**
+ * @brief Native fixed-rate control loop: get_obs → step → do_action.
+ *
+ * Runs on a dedicated thread (SCHED_FIFO when permitted) and schedules each
+ * tick on an absolute CLOCK_MONOTONIC deadline with clock_nanosleep
+ * (TIMER_ABSTIME), optionally finishing with a short busy-spin, so the period
+ * does not drift and wake-up jitter stays in the microsecond range.
+ *
+ * Multi-rate mode (LoopOptions::inner_hz > hz): the RT thread exchanges
+ * REQ/MIT with the boards at inner_hz (200-1000 Hz) and moves toward the
+ * latest policy target with LoopOptions::interp, while step() runs at hz on a
+ * second thread on the newest observation. Actuation is smoother and
+ * check_safety() runs every inner tick, without running inference faster.
+ * step() sees obs.last_action = its own previous output, as in lockstep mode.
+ *
+ * The policy is the @p step callable: it receives the tick's observation and
+ * the latest command and writes the action. Other threads only talk to the
+ * loop through lock-free slots: set_command() in, telemetry() out.
+ *
+ * With LoopOptions::torque the targets go through Robot::do_torque(): the
+ * robot's impedance (or custom torque) law is evaluated in C++ on the
+ * observation just read and only tau is sent. Combined with inner_hz this
+ * closes a torque-level loop at transport rate (500-1000 Hz) around the
+ * policy's setpoints, which a 50 Hz Python loop cannot.
+ *
+ * With an action shaper (Robot::set_action_shaper) of sub_ticks > 1, a
+ * lockstep tick also sends the shaper's remaining sub-tick frames with
+ * Robot::action_subtick() on deadlines splitting the period evenly.
+ *
+ * While Robot::waking() (after Robot::begin_wake()) a tick advances the wake
+ * ramp with Robot::wake_step() instead of calling step / do_action; the
+ * policy takes over on the first tick after the ramp ends. Start-up can
+ * thus run on the loop's own deadlines while the caller does other work.
+ *
+ * Deadlines follow Robot::clock(). On a rt::VirtualClock (lockstep mode
+ * only) sleeping just advances virtual time, so a simulated or replayed
+ * robot runs tick for tick as fast as the CPU allows; step_ns stays wall
+ * time for profiling. Combine with max_ticks and wait() for fixed-length runs.
+ *
+ * Robot calls take Robot::call_mutex(), so Python threads may still use the
+ * same Robot (e.g. estop()) while the loop runs. On RobotEStopError or any
+ * other error the loop e-stops the robot and exits; on RobotSleepError it
+ * exits without e-stop. error() tells why it stopped.
+ */
+class ControlLoop {
+public:
+    using Step = std::function<void(const ObsFrame& obs, const LoopCommand& cmd, std::span<float> action)>;
+
+    ControlLoop(Robot& robot, Step step, LoopOptions opt = {})
+        : _robot(robot), _step(std::move(step)), _opt(opt), _clock(robot.clock())
+    {
+        if (!_step) throw std::invalid_argument("ControlLoop: step must not be empty");
+        if (!(_opt.hz > 0.0)) throw std::invalid_argument("ControlLoop: hz must be greater than 0");
+        if (_opt.spin_ns < 0) throw std::invalid_argument("ControlLoop: spin_ns must be non-negative");
+        if (_opt.inner_hz < 0.0 || (_opt.inner_hz > 0.0 && _opt.inner_hz < _opt.hz))
+            throw std::invalid_argument("ControlLoop: inner_hz must be 0 or >= hz");
+        if (_clock->is_virtual() && multi_rate())   // 두 스레드가 한 가상 시계를 밀면 순서가 정해지지 않음
+            throw std::invalid_argument("ControlLoop: multi-rate mode needs the system clock");
+        _period_ns = static_cast<int64_t>(1e9 / _opt.hz);
+        _io_period_ns = multi_rate() ? static_cast<int64_t>(1e9 / _opt.inner_hz) : _period_ns;
+        _opt.spin_ns = std::min(_opt.spin_ns, _io_period_ns);
+
+        LoopCommand c{};
+        c.mode_id = -1;
+        _cmd.store(c);
+    }
+
+    ~ControlLoop() { stop(); }
+
+    ControlLoop(const ControlLoop&) = delete;
+    ControlLoop& operator=(const ControlLoop&) = delete;
+
+    void start() {
+        if (_thread.joinable()) {
+            if (_running.load(std::memory_order_acquire)) return;
+            _join();   // 이전 실행이 스스로 끝난 경우
+        }
+        {
+            std::lock_guard<std::mutex> lk(_err_mtx);
+            _error.clear();
+        }
+        {
+            // 끊김 타임아웃을 I/O 주기 기준으로 누적
+            std::lock_guard<std::mutex> lk(_robot.call_mutex());
+            if (multi_rate() && _robot.action_sub_ticks() > 1)   // I/O 루프가 이미 inner_hz로 보간
+                throw std::invalid_argument("ControlLoop: use either inner_hz or action shaper sub_ticks, not both");
+            _robot.set_control_period(_io_period_ns / 1e6);
+        }
+        _run.store(true, std::memory_order_release);
+        _running.store(true, std::memory_order_release);
+        if (multi_rate()) {
+            _target.store(PolicyTarget{});
+            _thread = std::thread(&ControlLoop::_io_loop, this);
+            _policy_thread = std::thread(&ControlLoop::_policy_loop, this);
+        } else {
+            _thread = std::thread(&ControlLoop::_loop, this);
+        }
+    }
+
+    /// @brief Ask the loop to stop after the current tick and join it.
+    void stop() {
+        _run.store(false, std::memory_order_release);
+        _join();
+    }
+
+    bool running() const { return _running.load(std::memory_order_acquire); }
+
+    /// @brief Block until the loop ends by itself (max_ticks, error, sleep); does not stop it.
+    void wait() { _join(); }
+
+    /// @brief Why the loop stopped ("" while running or after stop()).
+    std::string error() const {
+        std::lock_guard<std::mutex> lk(_err_mtx);
+        return _error;
+    }
+
+    /// @brief Publish a new command (lock-free; picked up at the next tick).
+    void set_command(const LoopCommand& c) {
+        std::lock_guard<std::mutex> lk(_cmd_mtx);   // 쓰기 쪽만 직렬화 (RT 쪽은 잠금 없음)
+        LoopCommand v = c;
+        v.cmd_len = std::min<uint32_t>(v.cmd_len, LoopCommand::kMaxCmd);
+        v.seq = ++_cmd_seq;
+        _cmd.store(v);
+    }
+
+    LoopCommand command() const { return _cmd.load(); }
+    LoopTelemetry telemetry() const { return _telemetry.load(); }
+
+    int64_t period_ns() const { return _period_ns; }         ///< policy period
+    int64_t io_period_ns() const { return _io_period_ns; }   ///< get_obs/do_action period
+    bool multi_rate() const { return _opt.inner_hz > 0.0; }
+    const LoopOptions& options() const { return _opt; }
+
+private:
+    static constexpr size_t kAct = ObsFrame::kLastAction;
+
+    /// @brief Policy thread → I/O thread (multi-rate mode).
+    struct PolicyTarget {
+        float    action[kAct];
+        uint64_t seq;            ///< 0: no target yet
+        uint64_t overruns;
+        int64_t  step_ns;
+    };
+
+    void _join() {
+        if (_thread.joinable()) _thread.join();
+        if (_policy_thread.joinable()) _policy_thread.join();
+    }
+
+    void _setup_thread(int fifo_prio) {
+        rt::setup_thread("ControlLoop", fifo_prio, _opt.cpu, _opt.lock_memory);
+    }
+
+    // 두 스레드(multi-rate)에서 동시에 불릴 수 있음: 먼저 난 오류만 남긴다
+    void _fail(const std::string& msg, bool estop) {
+        _run.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lk(_err_mtx);
+            if (_error.empty()) _error = msg;
+        }
+        if (estop) {
+            try {
+                std::lock_guard<std::mutex> lk(_robot.call_mutex());
+                _robot.estop(msg);
+            } catch (...) {}   // estop()은 항상 RobotEStopError를 던짐
+        }
+    }
+
+    // 공통 예외 처리: 루프를 끝내야 하면 false
+    template <class F>
+    bool _guarded(F&& f) {
+        try {
+            f();
+            return true;
+        } catch (const RobotSleepError& e) {
+            _fail(e.what(), /*estop=*/false);
+        } catch (const std::exception& e) {
+            _fail(e.what(), /*estop=*/true);
+        } catch (...) {
+            _fail("ControlLoop: unknown error in step", /*estop=*/true);
+        }
+        return false;
+    }
+
+    // 이번 틱 관측. Robot이 wake 램프 중이면 get_obs 대신 wake_step()으로 램프를 한 틱 진행
+    // @return true if this tick belonged to the wake ramp
+    bool _observe(LoopTelemetry& tm) {
+        std::lock_guard<std::mutex> lk(_robot.call_mutex());
+        tm.waking = _robot.waking();
+        tm.obs = tm.waking ? _robot.wake_step() : _robot.get_obs();
+        return tm.waking != 0;
+    }
+
+    // 목표 송신 (call_mutex 안에서): do_action 또는 do_torque (LoopOptions::torque)
+    void _act(std::span<const float> a) {
+        if (_opt.torque) _robot.do_torque(a);
+        else             _robot.do_action(a);
+    }
+
+    // do_action 직후 (call_mutex 안에서): 관측 수신 → 송신 지연
+    void _latency(LoopTelemetry& tm) {
+        tm.obs_to_action_ns = _robot.obs_to_action_ns();
+        tm.max_obs_to_action_ns = std::max(tm.max_obs_to_action_ns, tm.obs_to_action_ns);
+    }
+
+    // lockstep: 주기를 sub_ticks로 나눈 마감마다 shaper의 나머지 프레임 송신 (관측 없이)
+    bool _subticks(int64_t start) {
+        int n;
+        {
+            std::lock_guard<std::mutex> lk(_robot.call_mutex());
+            n = _robot.action_sub_ticks();
+        }
+        for (int k = 1; k < n && _run.load(std::memory_order_acquire); ++k) {
+            _clock->sleep_until(start + _period_ns * k / n, _opt.spin_ns);
+            if (!_guarded([&] {
+                    std::lock_guard<std::mutex> lk(_robot.call_mutex());
+                    _robot.action_subtick();
+                }))
+                return false;
+        }
+        return true;
+    }
+
+    // ---- lockstep: get_obs → step → do_action, 한 스레드에서 1/hz마다 ----
+    void _loop() {
+        _setup_thread(_opt.fifo_prio);
+
+        LoopTelemetry tm{};
+        tm.obs.reset();
+        tm.running = 1;
+        std::fill(std::begin(_action), std::end(_action), 0.0f);
+        std::span<float> action(_action, kAct);
+
+        rt::Clock& clk = *_clock;
+        int64_t next = clk.now_ns() + _period_ns;
+        while (_run.load(std::memory_order_acquire)) {
+            clk.sleep_until(next, _opt.spin_ns);
+            const int64_t woke = clk.now_ns();
+            const int64_t t0 = rt::now_ns();
+
+            const bool ok = _guarded([&] {
+                if (_observe(tm)) return;   // wake 램프 중: 정책/송신 없음
+                const LoopCommand cmd = _cmd.load();
+                _step(tm.obs, cmd, action);
+                {
+                    std::lock_guard<std::mutex> lk(_robot.call_mutex());
+                    _act(std::span<const float>(action));
+                    _latency(tm);
+                }
+            });
+            if (!ok) break;
+
+            const int64_t done = clk.now_ns();
+            if (!tm.waking && !_subticks(next)) break;
+            tm.tick += 1;
+            tm.policy_tick = tm.tick;
+            tm.jitter_ns = woke - next;
+            tm.max_jitter_ns = std::max(tm.max_jitter_ns, tm.jitter_ns < 0 ? -tm.jitter_ns : tm.jitter_ns);
+            tm.step_ns = rt::now_ns() - t0;
+            std::copy(action.begin(), action.end(), tm.action);
+
+            next += _period_ns;
+            if (done > next) {   // 마감 초과 → 밀린 틱은 건너뛰고 다시 정렬
+                tm.overruns += 1;
+                next = done + _period_ns;
+            }
+            _telemetry.store(tm);
+            if (_opt.max_ticks && tm.tick >= _opt.max_ticks) break;
+        }
+
+        tm.running = 0;
+        _telemetry.store(tm);
+        _running.store(false, std::memory_order_release);
+    }
+
+    // ---- multi-rate, RT 스레드: inner_hz로 get_obs → 보간 → do_action ----
+    void _io_loop() {
+        _setup_thread(_opt.fifo_prio);
+
+        LoopTelemetry tm{};
+        tm.obs.reset();
+        tm.running = 1;
+
+        float sent[kAct] = {};                 // 직전 틱에 보낸 값
+        float from[kAct] = {}, to[kAct] = {};  // Linear: from → to, FirstOrder: (from, to) = 직전/최신 목표
+        uint64_t seen = 0;                     // 반영한 PolicyTarget::seq
+        int64_t t_target = 0;                  // 최신 목표를 받은 시각
+        const double inv_period = 1.0 / static_cast<double>(_period_ns);
+
+        int64_t next = rt::now_ns() + _io_period_ns;
+        while (_run.load(std::memory_order_acquire)) {
+            rt::sleep_until(next, _opt.spin_ns);
+            const int64_t woke = rt::now_ns();
+
+            const bool ok = _guarded([&] {
+                const bool waking = _observe(tm);
+                _obs.store(tm.obs);   // 램프 중에도 정책 스레드는 관측으로 미리 돈다
+                if (waking) return;
+
+                const PolicyTarget tg = _target.load();
+                if (tg.seq == 0) return;   // 첫 목표 전에는 관측만
+                if (tg.seq != seen) {
+                    const float* src = seen == 0 ? tg.action                                 // 첫 목표: 바로 적용
+                                     : _opt.interp == LoopInterp::FirstOrder ? to : sent;
+                    std::copy(src, src + kAct, from);
+                    std::copy(std::begin(tg.action), std::end(tg.action), to);
+                    seen = tg.seq;
+                    t_target = woke;
+                    tm.policy_tick = tg.seq;
+                    tm.policy_overruns = tg.overruns;
+                    tm.policy_step_ns = tg.step_ns;
+                }
+
+                const float s = static_cast<float>(std::min(1.0, (woke - t_target) * inv_period));
+                for (size_t i = 0; i < kAct; ++i) {
+                    switch (_opt.interp) {
+                    case LoopInterp::Zero:       sent[i] = to[i]; break;
+                    case LoopInterp::Linear:     sent[i] = from[i] + (to[i] - from[i]) * s; break;
+                    case LoopInterp::FirstOrder: sent[i] = to[i] + (to[i] - from[i]) * s; break;
+                    }
+                }
+
+                std::lock_guard<std::mutex> lk(_robot.call_mutex());
+                if (!_run.load(std::memory_order_acquire)) return;   // 정책 스레드가 이미 estop
+                _act(std::span<const float>(sent, kAct));
+                _latency(tm);
+            });
+            if (!ok) break;
+
+            const int64_t done = rt::now_ns();
+            tm.tick += 1;
+            tm.jitter_ns = woke - next;
+            tm.max_jitter_ns = std::max(tm.max_jitter_ns, tm.jitter_ns < 0 ? -tm.jitter_ns : tm.jitter_ns);
+            tm.step_ns = done - woke;
+            std::copy(std::begin(sent), std::end(sent), tm.action);
+
+            next += _io_period_ns;
+            if (done > next) {
+                tm.overruns += 1;
+                next = done + _io_period_ns;
+            }
+            _telemetry.store(tm);
+            if (_opt.max_ticks && tm.tick >= _opt.max_ticks) break;
+        }
+
+        _run.store(false, std::memory_order_release);   // 정책 스레드도 종료
+        tm.running = 0;
+        _telemetry.store(tm);
+        _running.store(false, std::memory_order_release);
+    }
+
+    // ---- multi-rate, 정책 스레드: hz로 최신 관측 → step → 목표 게시 ----
+    void _policy_loop() {
+        _setup_thread(_opt.fifo_prio > 1 ? _opt.fifo_prio - 1 : _opt.fifo_prio);   // I/O 스레드보다 한 단계 낮게
+
+        ObsFrame obs;
+        PolicyTarget tg{};
+        std::span<float> action(_action, kAct);
+        std::fill(action.begin(), action.end(), 0.0f);
+
+        int64_t next = rt::now_ns() + _period_ns;
+        while (_run.load(std::memory_order_acquire)) {
+            rt::sleep_until(next, _opt.spin_ns);
+            const int64_t woke = rt::now_ns();
+
+            if (_obs.version() > 0) {
+                obs = _obs.load();
+                // step은 보간된 값이 아니라 자기 직전 출력을 last_action으로 본다
+                std::copy(action.begin(), action.end(), obs.last_action);
+                const LoopCommand cmd = _cmd.load();
+                if (!_guarded([&] { _step(obs, cmd, action); })) break;
+
+                std::copy(action.begin(), action.end(), tg.action);
+                tg.seq += 1;
+                tg.step_ns = rt::now_ns() - woke;
+                _target.store(tg);
+            }
+
+            next += _period_ns;
+            const int64_t done = rt::now_ns();
+            if (done > next) {
+                tg.overruns += 1;
+                next = done + _period_ns;
+            }
+        }
+    }
+
+private:
+    Robot& _robot;
+    Step _step;
+    LoopOptions _opt;
+    std::shared_ptr<rt::Clock> _clock;   // Robot::clock()
+    int64_t _period_ns = 0;
+
+    int64_t _io_period_ns = 0;
+
+    std::thread _thread;          // lockstep 루프 또는 multi-rate I/O 루프
+    std::thread _policy_thread;   // multi-rate 정책 루프
+    std::atomic<bool> _run{false};
+    std::atomic<bool> _running{false};
+
+    SeqSlot<LoopCommand> _cmd;
+    std::mutex _cmd_mtx;
+    uint64_t _cmd_seq = 0;
+    SeqSlot<LoopTelemetry> _telemetry;
+    SeqSlot<ObsFrame> _obs;           // multi-rate: I/O → 정책
+    SeqSlot<PolicyTarget> _target;    // multi-rate: 정책 → I/O
+
+    float _action[kAct];   // step 출력 (step을 부르는 스레드 전용)
+
+    mutable std::mutex _err_mtx;
+    std::string _error;
+};
+
+} // namespace robot
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief CRC32C (Castagnoli) used as the optional Fx frame check.
+ *
+ * Uses the hardware CRC32C instruction when available (SSE4.2 on x86-64,
+ * the CRC extension on ARMv8 / aarch64), selected once at runtime, and a
+ * table-driven software implementation otherwise.
+ *
+ * Frame format: the payload is followed by " *XXXXXXXX", where XXXXXXXX is
+ * the uppercase hex CRC32C of every byte before the " *".
+ */
+namespace crc32c {
+
+/// Length of the trailer " *XXXXXXXX".
+constexpr size_t kTrailerLen = 10;
+
+/// @brief CRC32C of @p len bytes, continuing from @p crc (0 for a new message).
+uint32_t compute(const void* data, size_t len, uint32_t crc = 0);
+
+/// @brief True if compute() uses the hardware instruction on this CPU.
+bool hw_accelerated();
+
+/// @brief Write the trailer for @p data into @p out (kTrailerLen bytes, not NUL-terminated).
+void make_trailer(const void* data, size_t len, char out[kTrailerLen]);
+
+/**
+ * @brief Check and strip the trailer.
+ *
+ * @param[in,out] len  frame length; on success reduced to the payload length
+ * @return true if the frame carries a trailer and the CRC matches
+ */
+bool check_trailer(const char* frame, size_t& len);
+
+} // namespace crc32c
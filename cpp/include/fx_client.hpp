@@ -1,7 +1,9 @@
 #pragma once
 
 #include <string>
+#include <span>
 #include <vector>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>     // [CHANGED] perror
 #include <pthread.h>  // [CHANGED] pthread_* APIs
@@ -62,8 +64,11 @@ public:
    * @brief Construct a UDP client and start the RX thread.
    * @param ip   Target IPv4 address (e.g., "192.168.10.10")
    * @param port Target UDP port number
+   * @param own_rx_thread If false, no RX thread is started; the owner
+   *        (FxPool) must service the socket from its shared I/O thread.
    */
-  FxCli(const std::string& ip = "192.168.10.10", uint16_t port = 5101);
+  FxCli(const std::string& ip = "192.168.10.10", uint16_t port = 5101,
+        bool own_rx_thread = true);
 
   FxCli(const FxCli&) = delete;
   FxCli& operator=(const FxCli&) = delete;
@@ -106,17 +111,139 @@ public:
                          const std::vector<float>& kd,
                          const std::vector<float>& tau);
 
-  /// @brief Request real-time observation ("AT+REQ <ids>")
+  /**
+   * @brief Upload the per-motor PD gain table ("AT+GAIN <id kp kd> ...").
+   *
+   * The MCU keeps the table until the next upload and applies it to every
+   * compact MIT frame (see operation_control_compact()). Gains change rarely,
+   * so callers should only re-upload when they actually change.
+   *
+   * Uses the real-time timeout and does not flush other tag buffers.
+   *
+   * @return true if OK<GAIN> was received
+   */
+  bool set_gain_table(const std::vector<uint8_t>& ids,
+                      const std::vector<float>& kp,
+                      const std::vector<float>& kd);
+
+  /**
+   * @brief Send compact MIT frames carrying only targets ("AT+MITC <id pos vel tau> ...").
+   *
+   * kp/kd are taken from the gain table last uploaded with set_gain_table().
+   * All vectors must have identical length N.
+   */
+  bool operation_control_compact(const std::vector<uint8_t>& ids,
+                                 const std::vector<float>& pos,
+                                 const std::vector<float>& vel,
+                                 const std::vector<float>& tau);
+
+  /**
+   * @brief Request real-time observation ("AT+REQ <ids>").
+   *
+   * If no reply arrives within the estimated RTT (see req_rto()), the REQ is
+   * re-sent immediately; retries stop at the REQ budget (see set_req_retry()).
+   *
+   * @return the OK<REQ> reply, or "" if nothing arrived within the budget
+   */
   std::string req(const std::vector<uint8_t>& ids);
 
+  /**
+   * @brief Configure the REQ retry budget as a slice of the control period.
+   *
+   * Default: 20 ms period x 0.1 = 2 ms, i.e. the previous single-shot RT timeout.
+   */
+  void set_req_retry(double control_period_ms, double slice);
+
+  /// @brief Total time a REQ (including retries) may take.
+  std::chrono::microseconds req_budget() const { return req_budget_; }
+
+  /**
+   * @brief Current REQ retransmission timeout: srtt + 4*rttvar (RFC 6298 style
+   *        EWMA over unambiguous samples), clamped to [kReqMinRto, req_budget()].
+   */
+  std::chrono::microseconds req_rto() const;
+
+  /// @brief Number of REQ retransmissions so far.
+  uint64_t req_retries() const { return req_retries_; }
+
   /// @brief Request status report ("AT+STATUS")
   std::string status();
 
+  /**
+   * @brief Enable the CRC32C frame check (see crc32c.hpp).
+   *
+   * When enabled, every command is sent with a " *XXXXXXXX" trailer and every
+   * reply must carry a valid one; frames that fail the check are dropped on
+   * the RX thread before they reach a tag buffer, and counted in
+   * rx_crc_errors(). The MCU firmware must have the check enabled too.
+   */
+  void set_crc(bool on);
+  bool crc() const;
+
+  /// @brief Replies dropped on the RX thread because of a missing/bad CRC trailer.
+  uint64_t rx_crc_errors() const;
+
+  /// @brief Replies dropped because they did not fit the receive buffer (truncated).
+  uint64_t rx_truncated() const;
+
   /// @brief Immediately discard all received packets.
   /// [CHANGED] Clears *all per-tag* buffers (MIT/REQ/STATUS/...).
   void flush();
 
+  // ────────────────────────────────
+  // Split-phase API
+  // ────────────────────────────────
+  //
+  // post_*() only transmits; collect() waits for the matching OK<TAG> until an
+  // absolute deadline. FxPool uses these to issue one transaction to several
+  // boards back-to-back and then gather all acks against a shared deadline,
+  // instead of paying one round trip per board.
+
+  /// @brief Send "AT+<tag> <ids>" (START/STOP/ESTOP/SETZERO). Flushes all tag buffers first (Non-RT).
+  void post_motor_cmd(const char* tag, const std::vector<uint8_t>& ids);
+
+  /// @brief Send "AT+ESTOP <ids>" only: no buffer flush, no ack wait.
+  ///        Safe while another thread has a transaction in flight on this board (watchdog).
+  void post_estop_nowait(const std::vector<uint8_t>& ids);
+
+  // Frame posts take spans, so callers can pass slices of fixed-size arrays
+  // (vectors convert implicitly). Frames are built in a reused buffer: a
+  // steady-state post does not allocate.
+  void post_operation_control(std::span<const uint8_t> ids,
+                              std::span<const float> pos,
+                              std::span<const float> vel,
+                              std::span<const float> kp,
+                              std::span<const float> kd,
+                              std::span<const float> tau);
+  void post_operation_control_compact(std::span<const uint8_t> ids,
+                                      std::span<const float> pos,
+                                      std::span<const float> vel,
+                                      std::span<const float> tau);
+  void post_gain_table(std::span<const uint8_t> ids,
+                       std::span<const float> kp,
+                       std::span<const float> kd);
+  /// @brief Send AT+REQ. A fresh REQ (retransmit=false) drops any late reply
+  ///        left over from the previous tick and starts the RTT sample.
+  void post_req(const std::vector<uint8_t>& ids, bool retransmit = false);
+  void post_status();
+
+  /// @brief Wait for OK<tag> until @p deadline. @return true if received.
+  ///        A REQ reply to a non-retransmitted request updates the RTT estimate.
+  ///        The reply is copied into @p out's existing storage; reuse it across ticks.
+  /// @param rx_ns optional; set to the reply's receive time (CLOCK_MONOTONIC ns, as rt::now_ns())
+  bool collect(const char* tag, std::string& out,
+               std::chrono::steady_clock::time_point deadline, int64_t* rx_ns = nullptr);
+
+  int timeout_ms()    const { return timeout_ms_; }
+  int timeout_ms_rt() const { return timeout_ms_rt_; }
+
 private:
+  friend class FxPool;
+
+  /// Current socket fd / non-blocking drain, for FxPool's shared I/O thread.
+  int  rx_fd();
+  void rx_drain();
+
   // ────────────────────────────────
   // Internal helpers
   // ────────────────────────────────
@@ -153,9 +280,25 @@ private:
   int timeout_ms_    = 200;  ///< General command timeout (ms)
   int timeout_ms_rt_ = 2;    ///< Real-time command timeout (ms)
 
+  // ────────────────────────────────
+  // REQ retry / RTT estimate
+  // ────────────────────────────────
+  static constexpr std::chrono::microseconds kReqMinRto{200};
+
+  std::chrono::microseconds req_budget_{2000};
+  double req_srtt_us_   = 0.0;   ///< 0 → 아직 샘플 없음
+  double req_rttvar_us_ = 0.0;
+  std::chrono::steady_clock::time_point req_sent_at_{};
+  int      req_attempts_ = 0;    ///< 현재 REQ의 송신 횟수 (1 이면 RTT 샘플 유효)
+  uint64_t req_retries_  = 0;
+  std::vector<uint8_t> req_ids_;   ///< req_cmd_를 만든 id 목록
+  std::string req_cmd_;            ///< "AT+REQ <ids>" (id 목록이 바뀔 때만 다시 만듦)
+
   // ────────────────────────────────
   // Internal UDP socket handler
   // ────────────────────────────────
   class UdpSocket;
   UdpSocket* socket_;
+
+  std::string tx_buf_;   ///< Reused MIT/MITC/GAIN frame buffer
 };
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Loopback MCU emulator for the Fx protocol.
+ *
+ * FxEmulator binds a UDP socket and answers AT+ commands the way a motor
+ * board does, so FxCli / Robot can be exercised without hardware
+ * (point FxCli at 127.0.0.1:<port>).
+ *
+ * Supported commands:
+ *   AT+PING, AT+WHOAMI, AT+START/STOP/ESTOP/SETZERO <ids>,
+ *   AT+MIT  <id pos vel kp kd tau> ...   (full frame, gains per frame)
+ *   AT+GAIN <id kp kd> ...               (gain table upload)
+ *   AT+MITC <id pos vel tau> ...         (compact frame, gains from table)
+ *   AT+REQ <ids>, AT+STATUS
+ *
+ * A command carrying a CRC32C trailer (" *XXXXXXXX", see crc32c.hpp) is
+ * answered with a trailer as well; a command whose trailer does not match
+ * is dropped and counted in crc_errors().
+ *
+ * Each motor is a unit joint (inertia + viscous friction) driven by the
+ * MIT law  tau = kp*(p_des - p) + kd*(v_des - v) + tau_ff, integrated lazily
+ * on every received command.
+ */
+class FxEmulator {
+public:
+  struct Options {
+    std::string bind_ip = "127.0.0.1";
+    uint16_t port = 5101;
+    std::vector<uint8_t> motor_ids{1, 2, 3, 4, 5, 6, 7, 8};
+    bool imu = true;          ///< Append an IMU block to REQ replies
+    double loss = 0.0;        ///< Probability [0,1) of silently dropping a received command
+    double corrupt = 0.0;     ///< Probability [0,1) of flipping one byte of a reply
+    bool gain_table = true;   ///< Answer AT+GAIN / AT+MITC (false: ignore them, like older firmware)
+  };
+
+  explicit FxEmulator(const Options& opt);
+  ~FxEmulator();
+
+  FxEmulator(const FxEmulator&) = delete;
+  FxEmulator& operator=(const FxEmulator&) = delete;
+
+  /// @brief Start the serving thread (no-op if already running).
+  void start();
+
+  /// @brief Stop and join the serving thread.
+  void stop();
+
+  /**
+   * @brief Serve several emulated boards from the calling thread until @p run is cleared.
+   *
+   * One thread for N boards, e.g. a 24-motor morphology or several robots
+   * in one process. The boards must not be start()-ed individually.
+   */
+  static void serve_all(const std::vector<FxEmulator*>& boards, const std::atomic<bool>& run);
+
+  uint16_t port() const { return opt_.port; }
+
+  /// @brief Number of datagrams received / replied.
+  uint64_t rx_count() const { return rx_count_.load(std::memory_order_relaxed); }
+  uint64_t tx_count() const { return tx_count_.load(std::memory_order_relaxed); }
+  uint64_t crc_errors() const { return crc_errors_.load(std::memory_order_relaxed); }
+
+  /// @brief AT+ESTOP received so far, and steady_clock ns of the latest one (0: none).
+  uint64_t estop_count() const { return estop_count_.load(std::memory_order_relaxed); }
+  int64_t last_estop_ns() const { return last_estop_ns_.load(std::memory_order_relaxed); }
+
+private:
+  struct Motor {
+    uint8_t id = 0;
+    bool running = false;
+    float p = 0.0f, v = 0.0f, t = 0.0f;          // 상태
+    float p_des = 0.0f, v_des = 0.0f, tau = 0.0f; // 목표
+    float kp = 0.0f, kd = 0.0f;                   // 현재 적용 gain (MIT/GAIN)
+  };
+
+  void serve();
+  void serve_one();   ///< recv one datagram (non-blocking) and reply
+  void handle(const char* data, size_t len, std::string& reply);
+  void advance();
+  Motor* find_motor(unsigned id);
+
+  void reply_req(const char* args, std::string& reply);
+  void reply_status(std::string& reply);
+
+  Options opt_;
+  int sock_{-1};
+  std::atomic<bool> run_{false};
+  std::thread thread_;
+
+  std::vector<Motor> motors_;
+  std::chrono::steady_clock::time_point last_step_;
+  uint64_t req_seq_{0};
+  uint64_t status_seq_{0};
+
+  std::mt19937 rng_{12345};
+  std::uniform_real_distribution<double> uni_{0.0, 1.0};
+
+  char rx_buf_[65536];
+  std::string reply_;
+
+  std::atomic<uint64_t> rx_count_{0};
+  std::atomic<uint64_t> tx_count_{0};
+  std::atomic<uint64_t> crc_errors_{0};
+  std::atomic<uint64_t> estop_count_{0};
+  std::atomic<int64_t> last_estop_ns_{0};
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fx_client.hpp"
+
+/// @brief One motor board: UDP endpoint + the motor IDs it drives (transmit order).
+struct FxBoard {
+  std::string ip = "192.168.10.10";
+  uint16_t port = 5101;
+  std::vector<uint8_t> motor_ids;
+  bool crc = false;                 ///< CRC32C frame check (FxCli::set_crc)
+  bool gain_table = true;           ///< firmware has AT+GAIN / AT+MITC (false: always full AT+MIT)
+};
+
+/**
+ * @brief Pool of Fx boards served by a single shared I/O thread.
+ *
+ * Boards are addressed by the index returned from add_board(). Their FxCli
+ * instances run without a private RX thread; one pool thread polls every
+ * board socket and demultiplexes replies into the per-board tag buffers.
+ *
+ * Transactions over a board subset are issued in parallel: the command is
+ * posted to every board first and the acks are then collected against one
+ * shared deadline, so N boards cost about one round trip instead of N.
+ *
+ * A pool may be shared by several Robot instances (fleets, bench rigs with
+ * several robots); each robot keeps the list of board indices it owns.
+ */
+class FxPool {
+public:
+  using Boards = std::vector<size_t>;
+
+  FxPool();
+  explicit FxPool(const std::vector<FxBoard>& boards);
+
+  FxPool(const FxPool&) = delete;
+  FxPool& operator=(const FxPool&) = delete;
+
+  /// Stops the I/O thread, then closes every board.
+  ~FxPool();
+
+  /// @brief Connect a new board. Safe to call while the I/O thread runs.
+  /// @return board index
+  size_t add_board(const FxBoard& board);
+
+  size_t size() const;
+  FxCli& cli(size_t b);
+  const FxBoard& board(size_t b) const;
+
+  /// @brief Total number of motors on @p bs (sum of motor_ids sizes).
+  size_t motor_count(const Boards& bs) const;
+
+  /**
+   * @brief Post one command to every board in @p bs, then collect OK<tag>.
+   *
+   * @param post  callable(FxCli&, size_t k) issuing the post_*() call for bs[k]
+   * @param out   optional, resized to bs.size(); out[k] = ack ("" on timeout)
+   * @param ok    optional, resized to bs.size(); ok[k] = ack received
+   * @return number of boards that acked before the shared deadline
+   */
+  template <class PostFn>
+  size_t transact(const Boards& bs, const char* tag, int timeout_ms, PostFn&& post,
+                  std::vector<std::string>* out = nullptr,
+                  std::vector<char>* ok = nullptr) {
+    if (out) out->resize(bs.size());
+    if (ok)  ok->resize(bs.size());
+    for (size_t k = 0; k < bs.size(); ++k) post(cli(bs[k]), k);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    size_t n_ok = 0;
+    thread_local std::string scratch;   // out 없이 호출된 경우 ACK 버림용 (용량 재사용)
+    for (size_t k = 0; k < bs.size(); ++k) {
+      std::string& dst = out ? (*out)[k] : scratch;
+      bool got = cli(bs[k]).collect(tag, dst, deadline);
+      if (!got) dst.clear();
+      if (ok) (*ok)[k] = got;
+      n_ok += got ? 1 : 0;
+    }
+    return n_ok;
+  }
+
+  /**
+   * @brief Parallel AT+REQ on @p bs with each board's motor IDs.
+   *
+   * Boards that have not answered within their estimated RTT are re-sent
+   * immediately; the whole exchange ends at the REQ budget of bs[0]
+   * (FxCli::set_req_retry()). out[k] is "" for boards that never answered.
+   * rx_ns (optional) gets each reply's receive time (CLOCK_MONOTONIC ns; 0: no reply).
+   */
+  size_t req(const Boards& bs, std::vector<std::string>& out, std::vector<int64_t>* rx_ns = nullptr);
+
+  /// @brief Parallel AT+STATUS on @p bs.
+  size_t status(const Boards& bs, std::vector<std::string>& out);
+
+  /**
+   * @brief Parallel Non-RT motor command (START/STOP/ESTOP/SETZERO) on @p bs.
+   *
+   * Keeps FxCli's post-ack stabilization delay, but pays it once for the
+   * whole subset instead of once per board.
+   */
+  size_t motor_cmd(const Boards& bs, const char* tag, std::vector<char>* ok = nullptr);
+
+private:
+  void io_loop();
+
+  mutable std::mutex boards_mtx_;
+  std::vector<std::unique_ptr<FxCli>> clis_;
+  std::deque<FxBoard> boards_;                    ///< deque: board() 참조가 add_board 후에도 유효
+  std::atomic<uint64_t> gen_{0};   ///< bumped on add_board → I/O thread refreshes its fd set
+
+  std::atomic<bool> run_{false};
+  std::thread io_thread_;
+};
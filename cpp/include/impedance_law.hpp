@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+struct ImpedanceOptions {
+  std::vector<float> kp;          ///< stiffness per action entry (N m / rad; usually 0 for wheels)
+  std::vector<float> kd;          ///< damping per action entry (N m s / rad)
+  std::vector<float> tau_limit;   ///< |tau| clamp per action entry (N m); empty / <= 0: none
+};
+
+/**
+ * @brief Joint impedance law evaluated natively on every transport tick.
+ *
+ *   tau = clamp(kp (q_ref - q) + kd (dq_ref - dq), ±tau_limit)
+ *
+ * All operands are per action entry (position targets for the legs, velocity
+ * targets for the wheels, whose q_ref = q). Arrays are fixed, 16-byte aligned
+ * and padded to a multiple of 4 lanes with zero gains, and eval() is
+ * branch-free, so the compiler vectorizes it.
+ */
+template <size_t N>
+struct ImpedanceLaw {
+  static constexpr size_t kLanes = 4;
+  static constexpr size_t kPadded = (N + kLanes - 1) / kLanes * kLanes;
+
+  alignas(16) float kp[kPadded] = {};
+  alignas(16) float kd[kPadded] = {};
+  alignas(16) float tau_max[kPadded] = {};
+
+  ImpedanceLaw() { std::fill(std::begin(tau_max), std::end(tau_max), 1e30f); }
+
+  /// @param opt validated by the caller (each vector empty or N entries)
+  void set(const ImpedanceOptions& opt) {
+    for (size_t i = 0; i < kPadded; ++i) {
+      kp[i] = i < opt.kp.size() ? opt.kp[i] : 0.0f;
+      kd[i] = i < opt.kd.size() ? opt.kd[i] : 0.0f;
+      // 제한 없음: 큰 유한값 (-ffast-math에서도 안전)
+      tau_max[i] = i < opt.tau_limit.size() && opt.tau_limit[i] > 0.0f ? opt.tau_limit[i] : 1e30f;
+    }
+  }
+
+  /// @param q_ref, q, dq_ref, dq, tau  kPadded floats each
+  void eval(const float* q_ref, const float* q, const float* dq_ref, const float* dq, float* tau) const {
+    for (size_t i = 0; i < kPadded; ++i) {
+      const float t = kp[i] * (q_ref[i] - q[i]) + kd[i] * (dq_ref[i] - dq[i]);
+      tau[i] = std::min(std::max(t, -tau_max[i]), tau_max[i]);
+    }
+  }
+
+  /// @brief Clamp an externally computed torque (TorqueLaw) to the same limits.
+  void clamp(float* tau) const {
+    for (size_t i = 0; i < kPadded; ++i) tau[i] = std::min(std::max(tau[i], -tau_max[i]), tau_max[i]);
+  }
+};
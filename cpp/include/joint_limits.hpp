@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define JOINT_LIMITS_SSE 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define JOINT_LIMITS_NEON 1
+#endif
+
+/**
+ * @brief Precomputed joint position / velocity limits, checked with SIMD.
+ *
+ * For N joints (padded to a multiple of 4) the thresholds Robot::_check_obs
+ * used to derive per tick are stored contiguously:
+ *
+ *   position     : pos < lo || pos > hi
+ *   toward lower : pos < lo_zone && vel < -vel_th
+ *   toward upper : pos >= hi_zone && vel >  vel_th
+ *
+ * check() evaluates every joint with branch-free compares (SSE2 on x86-64,
+ * NEON on AArch64, scalar otherwise) and returns a violation bitmask; messages
+ * are only formatted by the caller on the failure path. NaN compares false,
+ * as in the scalar code this replaces.
+ */
+template <size_t N>
+struct JointLimits {
+  static constexpr size_t kLanes = 4;
+  static constexpr size_t kPadded = (N + kLanes - 1) / kLanes * kLanes;
+  static_assert(N <= 16, "violation masks are 16 bits per kind");
+
+  // 패딩 칸은 절대 위반하지 않는 값 (lo=-inf 대신 큰 유한값: -ffast-math에서도 안전)
+  alignas(16) float lo[kPadded];
+  alignas(16) float hi[kPadded];
+  alignas(16) float lo_zone[kPadded];
+  alignas(16) float hi_zone[kPadded];
+  float vel_th = 0.0f;
+
+  /// bits [0,16): position, [16,32): toward lower, [32,48): toward upper
+  static constexpr uint64_t kPosMask = 0xFFFFull;
+  static constexpr int kVelLoShift = 16;
+  static constexpr int kVelHiShift = 32;
+
+  /**
+   * @param joint_lo/joint_hi raw joint range (N each)
+   * @param pos_margin  shrink the range by this much on both sides
+   * @param vel_margin  width of the zone inside each bound where overspeed toward it trips
+   * @param vel_thresh  speed limit inside that zone
+   */
+  void set(const float* joint_lo, const float* joint_hi,
+           float pos_margin, float vel_margin, float vel_thresh) {
+    for (size_t i = 0; i < kPadded; ++i) {
+      if (i < N) {
+        lo[i] = joint_lo[i] + pos_margin;
+        hi[i] = joint_hi[i] - pos_margin;
+        lo_zone[i] = lo[i] + vel_margin;
+        hi_zone[i] = hi[i] - vel_margin;
+      } else {
+        lo[i] = -1e30f; hi[i] = 1e30f;
+        lo_zone[i] = -1e30f; hi_zone[i] = 1e30f;
+      }
+    }
+    vel_th = vel_thresh;
+  }
+
+  /// @param pos, vel  kPadded floats each (lanes >= N ignored), 16-byte aligned
+  uint64_t check(const float* pos, const float* vel) const {
+    uint64_t m_pos = 0, m_lo = 0, m_hi = 0;
+#if defined(JOINT_LIMITS_SSE)
+    const __m128 vth = _mm_set1_ps(vel_th);
+    const __m128 nvth = _mm_set1_ps(-vel_th);
+    for (size_t i = 0; i < kPadded; i += kLanes) {
+      const __m128 p = _mm_load_ps(pos + i);
+      const __m128 v = _mm_load_ps(vel + i);
+      const __m128 out = _mm_or_ps(_mm_cmplt_ps(p, _mm_load_ps(lo + i)), _mm_cmpgt_ps(p, _mm_load_ps(hi + i)));
+      const __m128 tlo = _mm_and_ps(_mm_cmplt_ps(p, _mm_load_ps(lo_zone + i)), _mm_cmplt_ps(v, nvth));
+      const __m128 thi = _mm_and_ps(_mm_cmpge_ps(p, _mm_load_ps(hi_zone + i)), _mm_cmpgt_ps(v, vth));
+      m_pos |= static_cast<uint64_t>(_mm_movemask_ps(out)) << i;
+      m_lo  |= static_cast<uint64_t>(_mm_movemask_ps(tlo)) << i;
+      m_hi  |= static_cast<uint64_t>(_mm_movemask_ps(thi)) << i;
+    }
+#elif defined(JOINT_LIMITS_NEON)
+    const float32x4_t vth = vdupq_n_f32(vel_th);
+    const float32x4_t nvth = vdupq_n_f32(-vel_th);
+    const uint32x4_t bit = {1u, 2u, 4u, 8u};
+    for (size_t i = 0; i < kPadded; i += kLanes) {
+      const float32x4_t p = vld1q_f32(pos + i);
+      const float32x4_t v = vld1q_f32(vel + i);
+      const uint32x4_t out = vorrq_u32(vcltq_f32(p, vld1q_f32(lo + i)), vcgtq_f32(p, vld1q_f32(hi + i)));
+      const uint32x4_t tlo = vandq_u32(vcltq_f32(p, vld1q_f32(lo_zone + i)), vcltq_f32(v, nvth));
+      const uint32x4_t thi = vandq_u32(vcgeq_f32(p, vld1q_f32(hi_zone + i)), vcgtq_f32(v, vth));
+      // 레인 마스크(전부 1 / 0) → 레인 비트 합 = movemask
+      m_pos |= static_cast<uint64_t>(vaddvq_u32(vandq_u32(out, bit))) << i;
+      m_lo  |= static_cast<uint64_t>(vaddvq_u32(vandq_u32(tlo, bit))) << i;
+      m_hi  |= static_cast<uint64_t>(vaddvq_u32(vandq_u32(thi, bit))) << i;
+    }
+#else
+    for (size_t i = 0; i < kPadded; ++i) {
+      const float p = pos[i], v = vel[i];
+      m_pos |= static_cast<uint64_t>((p < lo[i]) | (p > hi[i])) << i;
+      m_lo  |= static_cast<uint64_t>((p < lo_zone[i]) & (v < -vel_th)) << i;
+      m_hi  |= static_cast<uint64_t>((p >= hi_zone[i]) & (v > vel_th)) << i;
+    }
+#endif
+    return m_pos | (m_lo << kVelLoShift) | (m_hi << kVelHiShift);
+  }
+};
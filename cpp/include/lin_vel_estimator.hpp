@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "obs_frame.hpp"
+
+struct LinVelOptions {
+    float wheel_radius = 0.0f;                      ///< m (required)
+    float track_width  = 0.0f;                      ///< m, left-right wheel distance (required)
+    std::array<uint8_t, 4> wheel_index{6, 7, 14, 15};         ///< dof_vel index: FL, FR, RL, RR
+    std::array<float, 4>   wheel_sign{1.0f, -1.0f, 1.0f, -1.0f};  ///< motor direction → forward
+
+    float accel_noise = 4.0f;        ///< process noise: body acceleration std (m/s^2)
+    float odom_noise  = 0.05f;       ///< wheel odometry std with all wheels agreeing (m/s)
+    float lateral_noise = 0.10f;     ///< non-holonomic constraint std (side slip, m/s)
+    float slip_gain   = 1.0f;        ///< extra std per m/s of yaw-rate mismatch (rim speed)
+    float slip_reject = 0.3f;        ///< drop a wheel whose speed differs from the median by more (m/s)
+    float max_dt      = 0.1f;        ///< clamp on the prediction step (s): first frame / long gaps
+};
+
+/**
+ * @brief Base linear velocity (body frame) from IMU and wheel odometry.
+ *
+ * A per-axis Kalman filter over v = (vx, vy, vz):
+ *  - predict: constant body-frame velocity, variance += (accel_noise dt)^2
+ *    (there is no accelerometer in the IMU block; for a wheeled base the
+ *    ground keeps the velocity along the body, so ω × v transport would
+ *    only add a spurious side drift in turns);
+ *  - update (fresh frames): the wheels roll along the ground plane, so the
+ *    measured velocity is s · f, where s is the wheel-rim speed and f the body
+ *    x axis projected onto the plane normal to proj_grav (pitch/roll aware).
+ *    s is the mean of the wheels within slip_reject of the median (a spinning
+ *    wheel is dropped), and its noise grows with the mismatch between the
+ *    kept wheels' yaw rate (right − left) / track_width and the gyro, so a
+ *    skidding base is trusted less. The lateral component is additionally
+ *    held to the non-holonomic constraint.
+ *
+ * Leg motion is treated as noise: the wheel hubs are assumed not to move
+ * relative to the body (legs quasi-static), which holds while driving and
+ * only approximately during stance changes.
+ *
+ * Fixed-size state, O(1) per update, no allocation. dt comes from the frame's
+ * receive times, so the filter runs at transport rate and stale frames only
+ * predict.
+ */
+class LinVelEstimator {
+public:
+    LinVelEstimator() = default;
+    explicit LinVelEstimator(const LinVelOptions& opt) { configure(opt); }
+
+    void configure(const LinVelOptions& opt) {
+        _opt = opt;
+        reset();
+    }
+
+    const LinVelOptions& options() const { return _opt; }
+
+    void reset() {
+        _v = {};
+        _p = {1.0f, 1.0f, 1.0f};
+        _t_ns = 0;
+    }
+
+    /// @brief Advance to @p f (an ObsFrame / BasicObsFrame) and write f.lin_vel.
+    template <class Frame>
+    void update(Frame& f) {
+        const int64_t t = f.fresh && f.rx_ns ? f.rx_ns : f.stamp_ns;
+        const float dt = _t_ns ? std::clamp((t - _t_ns) * 1e-9f, 0.0f, _opt.max_dt) : 0.0f;
+        _t_ns = t;
+        _predict(dt);
+        if (f.fresh) _correct(f);
+        std::copy(_v.begin(), _v.end(), f.lin_vel);
+    }
+
+    const std::array<float, 3>& velocity() const { return _v; }
+    const std::array<float, 3>& variance() const { return _p; }
+
+    /// @brief Wheel-rim speed used by the last update (m/s) and how many wheels agreed.
+    float odom_speed() const { return _odom; }
+    int   odom_wheels() const { return _n_used; }
+
+private:
+    void _predict(float dt) {
+        if (dt <= 0.0f) return;
+        const float q = _opt.accel_noise * dt;
+        for (float& p : _p) p += q * q;
+    }
+
+    template <class Frame>
+    void _correct(const Frame& f) {
+        // 바퀴별 림 속도 (전진 방향 +)
+        std::array<float, 4> s{};
+        for (size_t i = 0; i < 4; ++i)
+            s[i] = _opt.wheel_sign[i] * f.dof_vel[_opt.wheel_index[i]] * _opt.wheel_radius;
+
+        // 중앙값에서 slip_reject 넘게 벗어난 바퀴(헛돎/끌림)는 제외
+        std::array<float, 4> srt = s;
+        std::sort(srt.begin(), srt.end());
+        const float med = 0.5f * (srt[1] + srt[2]);
+        float sum = 0.0f;
+        float side[2] = {0.0f, 0.0f};   // 왼쪽(FL, RL) / 오른쪽(FR, RR) 합
+        int n = 0, n_side[2] = {0, 0};
+        for (size_t i = 0; i < 4; ++i) {
+            const float v = s[i];
+            if (std::fabs(v - med) > _opt.slip_reject) continue;
+            sum += v;
+            side[i & 1] += v;
+            ++n_side[i & 1];
+            ++n;
+        }
+        _n_used = n;
+        _odom = n ? sum / n : med;
+
+        // 남은 바퀴의 yaw rate (오른쪽 - 왼쪽) vs 자이로: 어긋나면 모두 미끄러지는 중 → 측정 신뢰도 낮춤
+        float yaw_err = 0.0f;
+        if (n_side[0] && n_side[1]) {
+            const float yaw_odom = (side[1] / n_side[1] - side[0] / n_side[0]) / _opt.track_width;
+            yaw_err = std::fabs(yaw_odom - f.ang_vel[2]) * 0.5f * _opt.track_width;
+        }
+        // 남은 바퀴가 1개 이하면 중앙값만 믿을 수 있음
+        const float sd = _opt.odom_noise + _opt.slip_gain * yaw_err + (n < 2 ? _opt.slip_reject : 0.0f);
+        const float r = sd * sd;
+
+        // 지면 평면 위의 전진 방향 f = e_x - (e_x·ĝ)ĝ (ĝ: 몸체 좌표계 중력 방향)
+        const float* g = f.proj_grav;
+        const float gn = std::sqrt(g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
+        std::array<float, 3> dir{1.0f, 0.0f, 0.0f};
+        if (gn > 0.5f) {
+            const float gx = g[0] / gn, gy = g[1] / gn, gz = g[2] / gn;
+            dir = {1.0f - gx * gx, -gx * gy, -gx * gz};
+            const float dn = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+            if (dn > 1e-3f) for (float& d : dir) d /= dn;
+            else dir = {1.0f, 0.0f, 0.0f};
+        }
+
+        const float lat = _opt.lateral_noise * _opt.lateral_noise;
+        const std::array<float, 3> rr{r, r + lat, r + lat};   // 옆/수직은 비홀로노믹 구속 잡음 추가
+        for (size_t a = 0; a < 3; ++a) {
+            const float k = _p[a] / (_p[a] + rr[a]);
+            _v[a] += k * (_odom * dir[a] - _v[a]);
+            _p[a] *= 1.0f - k;
+        }
+    }
+
+    LinVelOptions _opt;
+    std::array<float, 3> _v{}, _p{1.0f, 1.0f, 1.0f};
+    int64_t _t_ns = 0;     // 마지막 update 시각
+    float _odom = 0.0f;
+    int _n_used = 0;
+};
@@ -16,6 +16,7 @@
 #include <variant>
 #include <vector>
 
+#include "obs_frame.hpp"
 
 namespace py = pybind11;
 
@@ -26,16 +27,10 @@ public:
 };
 
 // ------------------------- Helpers -------------------------
+// 관측 키 → 길이 (Frame 레이아웃에서; 기본은 DefaultTopology의 ObsFrame)
+template <class Frame = ObsFrame>
 inline std::unordered_map<std::string, std::size_t> get_obs_to_length_map() {
-    return {
-        {"dof_pos", 12},
-        {"dof_vel", 16},
-        {"lin_vel", 3},
-        {"ang_vel", 3},
-        {"proj_grav", 3},
-        {"last_action", 16},
-        {"height_map", 144}
-    };
+    return obs_lengths<Frame>();
 }
 
 inline bool is_number(const py::handle &h) {
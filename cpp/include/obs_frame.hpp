@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include "topology.hpp"
+
+/**
+ * @brief Fixed-layout robot observation shared by Robot and RL.
+ *
+ * A contiguous POD: every field lives at a fixed offset, so a frame is
+ * copied with one memcpy, can be handed across modules without conversion,
+ * and fields can be looked up by name once (obs_field()) and then read by
+ * offset on every tick.
+ *
+ * Freshness: `fresh` is set when every board answered REQ in this tick;
+ * otherwise the motor/IMU fields hold the previous tick's values.
+ * `stamp_ns` is the Robot clock time (ns) at which the frame was filled.
+ *
+ * Timing: `rx_ns` is the receive time of the oldest board reply behind the
+ * motor fields and `skew_ns` the spread to the newest (front/rear skew);
+ * both are kept while the frame is stale, so `age_ns` = stamp_ns - rx_ns
+ * keeps growing and `stale_ticks` counts the repeats. `obs_delay` carries
+ * age and skew in seconds as a regular float field, so a policy can take
+ * them as input (RL key "obs_delay").
+ *
+ * Field lengths come from the topology (Topo::kJoints, Topo::kMotors, ...);
+ * ObsFrame is the one for DefaultTopology.
+ */
+template <class Topo>
+struct BasicObsFrame {
+  using Topology = Topo;
+
+  static constexpr size_t kDofPos     = Topo::kJoints;
+  static constexpr size_t kDofVel     = Topo::kMotors;
+  static constexpr size_t kAngVel     = 3;
+  static constexpr size_t kProjGrav   = 3;
+  static constexpr size_t kLastAction = Topo::kMotors;
+  static constexpr size_t kLinVel     = 3;
+  static constexpr size_t kHeightMap  = Topo::kHeightMap;
+  static constexpr size_t kObsDelay   = 2;
+  static constexpr size_t kMaxBoards  = 4;
+
+  static_assert(Topo::kBoards <= kMaxBoards, "mcu_seq holds kMaxBoards boards");
+
+  static constexpr float kHeightMapDefault = 0.6128f;
+
+  float dof_pos[kDofPos];           ///< leg joints (wheels excluded)
+  float dof_vel[kDofVel];           ///< every motor (wheels included), action order
+  float ang_vel[kAngVel];
+  float proj_grav[kProjGrav];
+  float last_action[kLastAction];
+  float lin_vel[kLinVel];
+  float height_map[kHeightMap];
+  float obs_delay[kObsDelay];       ///< {age, front/rear skew} of the motor data (s)
+
+  int64_t  stamp_ns;                ///< Robot clock ns when filled
+  int64_t  rx_ns;                   ///< receive time of the oldest board reply behind dof_pos/dof_vel (0: none yet)
+  int64_t  skew_ns;                 ///< newest - oldest board receive time of that data
+  int64_t  age_ns;                  ///< stamp_ns - rx_ns (0 before the first fresh frame)
+  uint64_t seq;                     ///< get_obs() counter
+  uint64_t mcu_seq[kMaxBoards];     ///< per-board SEQ_NUM of that data (0: not reported)
+  uint32_t stale_ticks;             ///< consecutive get_obs() without fresh data
+  uint8_t  fresh;                   ///< 1: this tick's data from every board
+  uint8_t  imu_fresh;               ///< 1: IMU block received this tick
+  uint8_t  reserved_[2];
+
+  /// @brief Zero everything except height_map (flat-ground default).
+  void reset() {
+    std::memset(this, 0, sizeof(*this));
+    for (float& h : height_map) h = kHeightMapDefault;
+  }
+};
+
+using ObsFrame = BasicObsFrame<DefaultTopology>;
+
+static_assert(std::is_trivially_copyable<ObsFrame>::value, "ObsFrame must stay POD");
+static_assert(std::is_standard_layout<ObsFrame>::value, "ObsFrame must stay POD");
+
+/// @brief Name → (offset in floats, length) of one ObsFrame field.
+struct ObsField {
+  std::string_view name;
+  size_t offset;     ///< in floats from the start of the frame
+  size_t len;
+};
+
+#define OBS_FRAME_FIELD(f) \
+  ObsField{#f, offsetof(Frame, f) / sizeof(float), sizeof(Frame::f) / sizeof(float)}
+
+/// @brief All float fields of @p Frame in layout order (dict view / RL key lookup).
+template <class Frame>
+inline constexpr ObsField kObsFieldsOf[] = {
+  OBS_FRAME_FIELD(dof_pos),
+  OBS_FRAME_FIELD(dof_vel),
+  OBS_FRAME_FIELD(ang_vel),
+  OBS_FRAME_FIELD(proj_grav),
+  OBS_FRAME_FIELD(last_action),
+  OBS_FRAME_FIELD(lin_vel),
+  OBS_FRAME_FIELD(height_map),
+  OBS_FRAME_FIELD(obs_delay),
+};
+
+#undef OBS_FRAME_FIELD
+
+inline constexpr const auto& kObsFields = kObsFieldsOf<ObsFrame>;
+
+/// @return the field of @p Frame called @p name, or nullptr
+template <class Frame = ObsFrame>
+inline const ObsField* obs_field(std::string_view name) {
+  for (const auto& f : kObsFieldsOf<Frame>)
+    if (f.name == name) return &f;
+  return nullptr;
+}
+
+/// @brief Field name → length for @p Frame (RL / Mode "obs_to_length").
+template <class Frame = ObsFrame>
+inline std::unordered_map<std::string, size_t> obs_lengths() {
+  std::unordered_map<std::string, size_t> m;
+  for (const auto& f : kObsFieldsOf<Frame>) m.emplace(std::string(f.name), f.len);
+  return m;
+}
+
+/// @brief Pointer to the first float of field @p f in @p frame.
+template <class Topo>
+inline const float* obs_data(const BasicObsFrame<Topo>& frame, const ObsField& f) {
+  return reinterpret_cast<const float*>(&frame) + f.offset;
+}
+template <class Topo>
+inline float* obs_data(BasicObsFrame<Topo>& frame, const ObsField& f) {
+  return reinterpret_cast<float*>(&frame) + f.offset;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/numpy.h>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "obs_frame.hpp"
+
+namespace py = pybind11;
+
+/**
+ * @brief Read-only 1-D float32 view of field @p fd, backed by the frame memory.
+ *
+ * @p owner is the Python object that owns @p f; it becomes the array's base so
+ * the frame outlives every view handed out.
+ */
+inline py::array obs_field_view(py::handle owner, const ObsFrame& f, const ObsField& fd) {
+  py::array_t<float> a({static_cast<py::ssize_t>(fd.len)},
+                       {static_cast<py::ssize_t>(sizeof(float))},
+                       obs_data(f, fd), owner);
+  py::detail::array_proxy(a.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+  return a;
+}
+
+/**
+ * @brief Read-only 2-D float32 view over @p n consecutive frames starting at @p f.
+ *
+ * Rows are frames (row stride sizeof(ObsFrame)), columns the floats of field
+ * @p fd, or every float field in layout order when @p fd is null. No copy:
+ * @p owner keeps the frame memory alive.
+ */
+inline py::array obs_rows_view(py::handle owner, const ObsFrame* f, size_t n, const ObsField* fd) {
+  const ObsField& last = kObsFields[std::size(kObsFields) - 1];
+  const size_t off = fd ? fd->offset : 0;
+  const size_t len = fd ? fd->len : last.offset + last.len;
+  py::array_t<float> a({static_cast<py::ssize_t>(n), static_cast<py::ssize_t>(len)},
+                       {static_cast<py::ssize_t>(sizeof(ObsFrame)), static_cast<py::ssize_t>(sizeof(float))},
+                       reinterpret_cast<const float*>(f) + off, owner);
+  py::detail::array_proxy(a.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+  return a;
+}
+
+/**
+ * @brief Register ObsFrame in @p m, sharing one Python type across modules.
+ *
+ * robot and rl are separate extension modules. pybind11 keeps registered
+ * types in interpreter-wide internals, so whichever module is imported first
+ * registers ObsFrame and the other one only re-exports the same type object.
+ * A frame returned by Robot.get_obs() is therefore accepted by
+ * RL.build_state() as-is, with no conversion.
+ *
+ * Field access (obs.dof_pos, obs["dof_pos"], items(), get()) returns
+ * read-only NumPy views into the frame, so the per-tick cost does not depend
+ * on the observation size. Views of Robot.get_obs() follow the robot's frame
+ * and change on the next get_obs(); use copy() (or to_dict(), which returns
+ * lists) to keep a snapshot.
+ */
+inline void bind_obs_frame(py::module_& m) {
+  if (auto* ti = py::detail::get_type_info(typeid(ObsFrame))) {
+    m.attr("ObsFrame") = py::handle(reinterpret_cast<PyObject*>(ti->type));
+    return;
+  }
+
+  auto to_list = [](const ObsFrame& f, const ObsField& fd) {
+    const float* p = obs_data(f, fd);
+    py::list l(fd.len);
+    for (size_t i = 0; i < fd.len; ++i) l[i] = py::float_(p[i]);
+    return l;
+  };
+  auto view = [](py::object self, const ObsField& fd) {
+    return obs_field_view(self, self.cast<const ObsFrame&>(), fd);
+  };
+  auto keys = [] {
+    py::list l;
+    for (const auto& fd : kObsFields) l.append(py::str(std::string(fd.name)));
+    return l;
+  };
+  auto field_or_throw = [](const std::string& key) -> const ObsField& {
+    const ObsField* fd = obs_field(key);
+    if (!fd) throw py::key_error(key);
+    return *fd;
+  };
+
+  py::class_<ObsFrame> cls(m, "ObsFrame");
+  cls.def(py::init([] { ObsFrame f; f.reset(); return f; }))
+     .def_readonly("stamp_ns", &ObsFrame::stamp_ns)
+     .def_readonly("seq", &ObsFrame::seq)
+     .def_readonly("rx_ns", &ObsFrame::rx_ns)
+     .def_readonly("skew_ns", &ObsFrame::skew_ns)
+     .def_readonly("age_ns", &ObsFrame::age_ns)
+     .def_readonly("stale_ticks", &ObsFrame::stale_ticks)
+     .def_property_readonly("mcu_seq", [](const ObsFrame& f) {
+        return std::vector<uint64_t>(std::begin(f.mcu_seq), std::end(f.mcu_seq));
+      })
+     .def_property_readonly("fresh", [](const ObsFrame& f) { return f.fresh != 0; })
+     .def_property_readonly("imu_fresh", [](const ObsFrame& f) { return f.imu_fresh != 0; })
+     .def("copy", [](const ObsFrame& f) { return f; }, "Owned snapshot of this frame")
+     .def("__copy__", [](const ObsFrame& f) { return f; });
+
+  for (const ObsField& fd : kObsFields) {
+    cls.def_property_readonly(std::string(fd.name).c_str(),
+                              [view, &fd](py::object self) { return view(self, fd); });
+  }
+
+  // ---- dict 호환 뷰 ----
+  cls.def("__getitem__", [view, field_or_throw](py::object self, const std::string& key) {
+        return view(self, field_or_throw(key));
+      })
+     .def("__setitem__", [field_or_throw](ObsFrame& f, const std::string& key, const std::vector<float>& v) {
+        const ObsField& fd = field_or_throw(key);
+        if (v.size() != fd.len)
+          throw py::value_error(key + " length must be " + std::to_string(fd.len));
+        std::copy(v.begin(), v.end(), obs_data(f, fd));
+      })
+     .def("__contains__", [](const ObsFrame&, const std::string& key) { return obs_field(key) != nullptr; })
+     .def("__len__", [](const ObsFrame&) { return std::size(kObsFields); })
+     .def("__iter__", [keys](const ObsFrame&) { return py::iter(keys()); })
+     .def("keys", [keys](const ObsFrame&) { return keys(); })
+     .def("items", [view](py::object self) {
+        py::list l;
+        for (const auto& fd : kObsFields)
+          l.append(py::make_tuple(py::str(std::string(fd.name)), view(self, fd)));
+        return l;
+      })
+     .def("get", [view](py::object self, const std::string& key, py::object dflt) -> py::object {
+        const ObsField* fd = obs_field(key);
+        return fd ? py::object(view(self, *fd)) : dflt;
+      }, py::arg("key"), py::arg("default") = py::none())
+     .def("to_dict", [to_list](const ObsFrame& f) {
+        py::dict d;
+        for (const auto& fd : kObsFields) d[py::str(std::string(fd.name))] = to_list(f, fd);
+        return d;
+      });
+}
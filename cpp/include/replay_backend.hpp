@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "req_parser.hpp"      // OK<REQ> 단일 패스 파서
+#include "robot_backend.hpp"
+
+namespace robot {
+
+/**
+ * @brief RobotBackend that plays back recorded REQ replies.
+ *
+ * Each tick is one line of the recording (UdpBackend::record()): the boards'
+ * raw OK<REQ> replies separated by tabs. req() parses the next line with the
+ * same ReqParser the UDP path uses, so a recorded session drives Robot, the
+ * safety checks and the policy exactly as it did on the robot, at any speed.
+ *
+ * Commands are accepted and counted but change nothing; STATUS reports every
+ * motor running. At the end of the recording req() keeps failing (Robot then
+ * hits its disconnect timeout) unless @p loop is set.
+ */
+class ReplayBackend final : public RobotBackend {
+public:
+    ReplayBackend(std::vector<std::vector<uint8_t>> boards,
+                  std::vector<std::vector<std::string>> ticks, bool loop = false)
+        : _boards(std::move(boards)), _ticks(std::move(ticks)), _loop(loop)
+    {
+        for (const auto& b : _boards) {
+            _motor_offset.push_back(_n);
+            _n += b.size();
+            _parsers.emplace_back(b);
+        }
+        _imu.resize(_boards.size());
+        for (const auto& t : _ticks)
+            if (t.size() != _boards.size())
+                throw std::invalid_argument("ReplayBackend: every tick needs one reply per board");
+    }
+
+    /// @brief Load a recording written by UdpBackend::record().
+    static std::unique_ptr<ReplayBackend> load(const std::string& path, std::vector<std::vector<uint8_t>> boards, bool loop = false) {
+        std::ifstream in(path);
+        if (!in) throw std::runtime_error("ReplayBackend: cannot open " + path);
+        std::vector<std::vector<std::string>> ticks;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::vector<std::string> tick;
+            size_t s = 0;
+            for (;;) {
+                const size_t e = line.find('\t', s);
+                tick.push_back(line.substr(s, e == std::string::npos ? std::string::npos : e - s));
+                if (e == std::string::npos) break;
+                s = e + 1;
+            }
+            ticks.push_back(std::move(tick));
+        }
+        return std::make_unique<ReplayBackend>(std::move(boards), std::move(ticks), loop);
+    }
+
+    const char* name() const override { return "replay"; }
+    const std::vector<std::vector<uint8_t>>& boards() const override { return _boards; }
+
+    size_t motor_cmd(const char* /*tag*/, const std::vector<char>& sel, std::vector<char>& ok) override {
+        ok.assign(sel.begin(), sel.end());
+        size_t n = 0;
+        for (char s : sel) n += s != 0;
+        return n;
+    }
+
+    void estop_nowait() override { _estops.fetch_add(1, std::memory_order_relaxed); }
+
+    void status(MotorHealth* motors, BoardHealth* boards) override {
+        size_t g = 0;
+        for (size_t k = 0; k < _boards.size(); ++k) {
+            boards[k] = BoardHealth{1, 0, _pos};
+            for (uint8_t id : _boards[k]) motors[g++] = MotorHealth{id, 1, MotorHealth::kPatternRunning, 0};
+        }
+    }
+
+    // 기록에는 RX 시각이 없음 (0 → Robot이 자기 시계로 찍음), SEQ_NUM은 응답에서
+    bool req(ReqMotorState* motors, ReqImu& imu, bool& has_imu, BoardStamp* stamps) override {
+        has_imu = false;
+        if (_pos >= _ticks.size()) {
+            if (!_loop || _ticks.empty()) return false;
+            _pos = 0;
+        }
+        const auto& tick = _ticks[_pos++];
+        for (size_t k = 0; k < _boards.size(); ++k) {
+            bool h = false;
+            if (!_parsers[k].parse(tick[k], motors + _motor_offset[k], _imu[k], h, &stamps[k].seq)) return false;
+            stamps[k].rx_ns = 0;
+            if (h) { imu = _imu[k]; has_imu = true; }
+        }
+        return true;
+    }
+
+    void send(const MotorTargets& /*t*/) override { ++_sends; }
+
+    size_t size() const { return _ticks.size(); }
+    size_t position() const { return _pos; }
+    uint64_t sends() const { return _sends; }
+    uint64_t estops() const { return _estops.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<std::vector<uint8_t>> _boards;
+    std::vector<std::vector<std::string>> _ticks;
+    bool _loop = false;
+    size_t _n = 0;
+    std::vector<size_t> _motor_offset;
+    std::vector<ReqParser> _parsers;
+    std::vector<ReqImu> _imu;
+
+    size_t _pos = 0;   // 다음 틱
+    uint64_t _sends = 0;
+    std::atomic<uint64_t> _estops{0};
+};
+
+} // namespace robot
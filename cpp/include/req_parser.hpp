@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#if defined(__cpp_lib_to_chars) || (defined(__GNUC__) && __GNUC__ >= 11)
+#include <charconv>
+#define REQ_PARSER_FROM_CHARS 1
+#endif
+
+/**
+ * @brief Single-pass, allocation-free parser for OK<REQ> replies.
+ *
+ * Reply grammar (whitespace-separated, ';'-terminated groups):
+ *   OK <REQ> M<id> p:<f> v:<f> t:<f>; ... [IMU gx:<f> gy:<f> gz:<f> pgx:<f> pgy:<f> pgz:<f>;]
+ *   [SEQ_NUM: cnt:<n>;]
+ *
+ * The buffer is walked once; every float is parsed in place (std::from_chars,
+ * strtof on older toolchains) and validated as it is read. A frame is rejected
+ * if it is not an OK<REQ>, a motor reports "N" or a non-finite value, a motor
+ * appears twice, or any expected motor is missing.
+ */
+struct ReqMotorState {
+  float p = 0.0f, v = 0.0f, t = 0.0f;
+};
+
+struct ReqImu {
+  float gx = 0.0f, gy = 0.0f, gz = 0.0f;      ///< angular velocity
+  float pgx = 0.0f, pgy = 0.0f, pgz = 0.0f;   ///< projected gravity
+};
+
+class ReqParser {
+public:
+  ReqParser() { slot_of_.fill(-1); }
+
+  /// @param ids expected motor IDs; out[slot] of parse() follows this order.
+  explicit ReqParser(const std::vector<uint8_t>& ids) : ReqParser() { set_ids(ids); }
+
+  void set_ids(const std::vector<uint8_t>& ids) {
+    if (ids.size() > 64) throw std::invalid_argument("ReqParser: at most 64 motors per board");
+    slot_of_.fill(-1);
+    for (size_t i = 0; i < ids.size(); ++i) slot_of_[ids[i]] = static_cast<int16_t>(i);
+    n_ = ids.size();
+  }
+
+  size_t size() const { return n_; }
+
+  /**
+   * @param s        reply string
+   * @param out      n = size() entries, indexed by slot
+   * @param imu      filled if the reply carries an IMU block
+   * @param has_imu  set to whether an IMU block was present
+   * @param seq      optional; SEQ_NUM cnt of the reply (0: not reported)
+   * @return true if the frame is valid and complete (out/imu are then fully written)
+   */
+  bool parse(std::string_view s, ReqMotorState* out, ReqImu& imu, bool& has_imu,
+             uint64_t* seq = nullptr) const {
+    has_imu = false;
+    if (seq) *seq = 0;
+    const char* p = s.data();
+    const char* e = p + s.size();
+
+    if (!skip_prefix(p, e)) return false;
+
+    uint64_t seen = 0;       // slot bitmask (≤ 64 motors per board)
+    size_t n_seen = 0;
+    while (p < e) {
+      skip_ws(p, e);
+      if (p >= e) break;
+
+      if (*p == 'M' && p + 1 < e && is_digit(p[1])) {
+        ++p;
+        unsigned id = 0;
+        while (p < e && is_digit(*p)) { id = id * 10 + static_cast<unsigned>(*p - '0'); ++p; }
+        if (id >= slot_of_.size()) return false;
+        const int slot = slot_of_[id];
+
+        ReqMotorState m;
+        if (!kv(p, e, "p:", m.p) || !kv(p, e, "v:", m.v) || !kv(p, e, "t:", m.t)) return false;
+        if (!end_group(p, e)) return false;
+
+        if (slot < 0) continue;                                   // 요청하지 않은 모터 → 무시
+        const uint64_t bit = 1ull << slot;
+        if (seen & bit) return false;                             // 중복
+        seen |= bit;
+        ++n_seen;
+        out[slot] = m;
+      } else if (starts_with(p, e, "IMU")) {
+        p += 3;
+        ReqImu u;
+        if (!kv(p, e, "gx:", u.gx)   || !kv(p, e, "gy:", u.gy)   || !kv(p, e, "gz:", u.gz) ||
+            !kv(p, e, "pgx:", u.pgx) || !kv(p, e, "pgy:", u.pgy) || !kv(p, e, "pgz:", u.pgz))
+          return false;
+        if (!end_group(p, e)) return false;
+        imu = u;
+        has_imu = true;
+      } else if (starts_with(p, e, "SEQ_NUM:")) {
+        p += 8;
+        skip_ws(p, e);
+        if (seq && starts_with(p, e, "cnt:")) {
+          p += 4;
+          skip_ws(p, e);
+          uint64_t v = 0;
+          while (p < e && is_digit(*p)) { v = v * 10 + static_cast<uint64_t>(*p - '0'); ++p; }
+          *seq = v;
+        }
+        while (p < e && *p != ';') ++p;
+        if (p < e) ++p;
+      } else {
+        // 나머지 그룹은 ';'까지 건너뜀
+        while (p < e && *p != ';') ++p;
+        if (p < e) ++p;
+      }
+    }
+    return n_seen == n_;
+  }
+
+private:
+  static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+  static void skip_ws(const char*& p, const char* e) {
+    while (p < e && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+  }
+
+  static bool starts_with(const char* p, const char* e, const char* lit) {
+    const size_t n = std::strlen(lit);
+    return static_cast<size_t>(e - p) >= n && std::memcmp(p, lit, n) == 0;
+  }
+
+  static bool skip_prefix(const char*& p, const char* e) {
+    skip_ws(p, e);
+    if (!starts_with(p, e, "OK")) return false;
+    p += 2;
+    skip_ws(p, e);
+    if (!starts_with(p, e, "<REQ>")) return false;
+    p += 5;
+    return true;
+  }
+
+  // ' key:<float>' 하나 읽기 ("N" 또는 비유한값이면 실패)
+  static bool kv(const char*& p, const char* e, const char* key, float& out) {
+    skip_ws(p, e);
+    if (!starts_with(p, e, key)) return false;
+    p += std::strlen(key);
+    if (p < e && *p == 'N') return false;
+    if (!parse_float(p, e, out)) return false;
+    return std::isfinite(out);
+  }
+
+  static bool end_group(const char*& p, const char* e) {
+    skip_ws(p, e);
+    if (p >= e || *p != ';') return false;
+    ++p;
+    return true;
+  }
+
+  static bool parse_float(const char*& p, const char* e, float& out) {
+#if defined(REQ_PARSER_FROM_CHARS)
+    if (p < e && *p == '+') ++p;   // from_chars는 '+' 부호를 받지 않음
+    auto r = std::from_chars(p, e, out);
+    if (r.ec != std::errc{}) return false;
+    p = r.ptr;
+    return true;
+#else
+    // 응답 버퍼는 std::string 이므로 NUL 종료 보장, strtof는 ';'/공백에서 멈춤
+    char* end = nullptr;
+    out = std::strtof(p, &end);
+    if (end == p || end > e) return false;
+    p = end;
+    return true;
+#endif
+  }
+
+  std::array<int16_t, 256> slot_of_{};   ///< motor id → slot (-1: not expected)
+  size_t n_ = 0;
+};
@@ -9,22 +9,20 @@
 #include <stdexcept>
 #include <algorithm>
 
+#include "obs_frame.hpp"
+
 namespace py = pybind11;
 
 namespace rl {
 
-class RL {
+// Topo: 관측 레이아웃(필드 길이 / 오프셋)을 정하는 로봇 구성. RL = BasicRL<DefaultTopology>
+template <class Topo>
+class BasicRL {
 public:
-    RL() {
-        obs_to_length_ = {
-            {"dof_pos",   12},
-            {"dof_vel",   16},
-            {"lin_vel",   3},
-            {"ang_vel",   3},
-            {"proj_grav", 3},
-            {"last_action", 16},
-            {"height_map", 144}
-        };
+    using Frame = BasicObsFrame<Topo>;
+
+    BasicRL() {
+        obs_to_length_ = obs_lengths<Frame>();   // 필드 길이는 Frame 레이아웃에서 (4W: dof_pos 12, dof_vel 16, ...)
         last_action_len_ = obs_to_length_.at("last_action");
         last_action_.assign(last_action_len_, 0.0f);
         scaled_action_.assign(last_action_len_, 0.0f);
@@ -93,14 +91,99 @@ public:
                 if (cached_action_scale_.size() < last_action_len_) {
                     throw std::runtime_error("action_scale length is smaller than last_action length for current mode.");
                 }
+
+                stacked_slots_     = make_slots_(cached_stacked_order_);
+                non_stacked_slots_ = make_slots_(cached_non_stacked_order_);
                 return;
             }
         }
         // 등록 안 되어 있으면 무시
     }
 
-    // obs: Dict[str, List], cmd: Dict[str, Any]
+    // obs: ObsFrame (native) — 키 조회/변환 없이 고정 오프셋에서 바로 읽음
+    std::vector<float> build_state(const Frame& obs, const py::dict& cmd, py::object scaled_last_action) {
+        return build_state_(cmd, scaled_last_action, [&](const KeySlot& ks) -> const float* {
+            return ks.field ? obs_data(obs, *ks.field) : nullptr;
+        });
+    }
+
+    // obs: Dict[str, List], cmd: Dict[str, Any] (호환 경로)
     std::vector<float> build_state(const py::dict& obs, const py::dict& cmd, py::object scaled_last_action) {
+        return build_state_(cmd, scaled_last_action, [&](const KeySlot& ks) -> const float* {
+            py::str key(ks.key);
+            if (!obs.contains(key)) return nullptr;
+            py::object v = obs[key];
+            if (v.is_none()) return nullptr;
+            obs_hold_ = farray::ensure(v);  // float32 배열이면 복사 없음
+            if (!obs_hold_)
+                throw py::type_error(ks.key + " must be a 1D array/list.");
+            if (static_cast<size_t>(obs_hold_.size()) < ks.len)
+                throw py::value_error(ks.key + " length must be " + std::to_string(ks.len));
+            return obs_hold_.data();
+        });
+    }
+
+    // policy.inference(state) → [-1,1] → action_scale 적용 (검사 없음: set_mode에서 이미 확인)
+    std::vector<float> select_action(const std::vector<float>& state) {
+        ensure_mode_();
+
+        // 캐시 사용 (유효성 검사는 set_mode에서 끝냄)
+        py::object py_action = cached_policy_.attr("inference")(state);
+        // 정책 출력(보통 NumPy 배열)은 버퍼로 한 번에 읽음
+        farray action = farray::ensure(py_action);
+        if (!action || action.ndim() != 1) {
+            throw py::type_error("policy.inference() must return a 1D array/list.");
+        }
+
+        const size_t n = last_action_len_;
+        if (static_cast<size_t>(action.size()) < n) {
+            throw py::value_error("policy action length must be " + std::to_string(n));
+        }
+        const float* act = action.data();
+        for (size_t i = 0; i < n; ++i) {
+            scaled_action_[i] = act[i] * cached_action_scale_[i];
+        }
+        last_action_.assign(act, act + action.size());
+        return scaled_action_;
+    }
+
+private:
+    // 연속 float32 배열 (리스트 등은 NumPy가 한 번에 변환)
+    using farray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+
+    // 모드의 obs 순서 한 칸: set_mode()에서 한 번 해석해 두고 매 틱 재사용
+    struct KeySlot {
+        enum Kind { Obs, Command, LastAction };
+        std::string key;
+        size_t len{0};
+        Kind kind{Obs};
+        const ObsField* field{nullptr};   ///< ObsFrame 필드 (없는 키면 nullptr)
+        std::vector<float> scale;         ///< len 길이로 패딩된 스케일
+    };
+
+    std::vector<KeySlot> make_slots_(const std::vector<std::string>& order) const {
+        std::vector<KeySlot> slots;
+        for (const auto& key : order) {
+            KeySlot ks;
+            ks.key = key;
+            ks.len = get_obs_len_(key);
+            ks.kind = (key == "command") ? KeySlot::Command
+                    : (key == "last_action") ? KeySlot::LastAction : KeySlot::Obs;
+            ks.field = obs_field<Frame>(key);
+            if (ks.kind == KeySlot::Command) {
+                ks.scale = cached_cmd_scale_;
+                if (ks.scale.size() < ks.len) ks.scale.resize(ks.len, 1.0f);
+            } else {
+                ks.scale = get_obs_scale_(key, ks.len);
+            }
+            slots.push_back(std::move(ks));
+        }
+        return slots;
+    }
+
+    // fetch(KeySlot) → 해당 obs 데이터 포인터 (없으면 nullptr → 이전 값 유지)
+    template <class Fetch>
+    std::vector<float> build_state_(const py::dict& cmd, py::object scaled_last_action, Fetch&& fetch) {
         ensure_mode_();
 
         // cmd["mode_id"]가 있으면 즉시 모드 전환
@@ -109,68 +192,57 @@ public:
             if (!v.is_none()) set_mode(v);
         }
 
-        //  scaled_last_action이 None 아니면 벡터로 캐스팅해서 길이 확인 후 반영
+        //  scaled_last_action이 None 아니면 float32 버퍼로 받아 길이 확인 후 반영
         if (!scaled_last_action.is_none()) {
-            py::sequence seq;
-            try {
-                seq = scaled_last_action.cast<py::sequence>();
-            } catch (...) {
+            farray a = farray::ensure(scaled_last_action);
+            if (!a) {
                 throw py::type_error("scaled_last_action must be a 1D array/list.");
             }
-            const size_t n = seq.size();
+            if (a.ndim() != 1) {
+                throw py::value_error("scaled_last_action must be 1D array/list.");
+            }
+            const size_t n = static_cast<size_t>(a.size());
             if (n != last_action_len_) {
                 throw py::value_error("scaled_last_action length must be " + std::to_string(last_action_len_) + " (got " + std::to_string(n) + ")");
             }
-            if (n > 0) {
-                py::handle first = seq[0];
-                if (py::isinstance<py::list>(first) ||
-                    py::isinstance<py::tuple>(first) ||
-                    py::isinstance<py::array>(first)) {
-                    throw py::value_error("scaled_last_action must be 1D array/list.");
-                }
+            last_action_.assign(a.data(), a.data() + n);
+        }
+
+        // command 벡터는 호출당 한 번만 변환
+        const float* cmd_ptr = nullptr;
+        if (cmd.contains("cmd_vector")) {
+            py::object v = cmd["cmd_vector"];
+            if (!v.is_none()) {
+                cmd_tmp_ = v.cast<std::vector<float>>();
+                cmd_ptr = cmd_tmp_.data();
             }
-            std::vector<float> v(n);
-            for (size_t i = 0; i < n; ++i) {
-                v[i] = py::cast<float>(seq[i]);
+        }
+        auto source = [&](const KeySlot& ks) -> const float* {
+            switch (ks.kind) {
+                case KeySlot::Command:    return cmd_ptr;
+                case KeySlot::LastAction: return last_action_.data();
+                default:                  return fetch(ks);
             }
-            last_action_ = std::move(v);
+        };
+        if (cmd_ptr) {
+            for (const auto* slots : {&stacked_slots_, &non_stacked_slots_})
+                for (const auto& ks : *slots)
+                    if (ks.kind == KeySlot::Command && cmd_tmp_.size() < ks.len)
+                        throw py::value_error("cmd_vector length must be " + std::to_string(ks.len));
         }
 
         // 1) 싱글 프레임 구성
         size_t i = 0;
-        const auto& stacked = cached_stacked_order_;
-        for (const auto& key : stacked) {
-            size_t obs_len = get_obs_len_(key);
-
-            const std::vector<float>& scale = (key == "command")
-                ? cached_cmd_scale_
-                : get_obs_scale_(key, obs_len);
-
-            py::object obs_obj = py::none();
-            if (key == "command") {
-                if (cmd.contains("cmd_vector")) obs_obj = cmd["cmd_vector"];
-            } else if (key == "last_action") {
-                // 내부 last_action_ 사용
-            } else {
-                if (obs.contains(py::str(key))) obs_obj = obs[py::str(key)];
-            }
-
-            if (obs_obj.is_none() && key != "last_action") {
-                for (size_t k = 0; k < obs_len; ++k) {
+        for (const auto& ks : stacked_slots_) {
+            const float* src = source(ks);
+            if (!src) {
+                for (size_t k = 0; k < ks.len; ++k) {
                     single_frame_[i] = state_[i];
                     ++i;
                 }
             } else {
-                const std::vector<float>* src_vec = nullptr;
-                std::vector<float> tmp;
-                if (key == "last_action") {
-                    src_vec = &last_action_;
-                } else {
-                    tmp = obs_obj.cast<std::vector<float>>();
-                    src_vec = &tmp;
-                }
-                for (size_t j = 0; j < obs_len; ++j) {
-                    single_frame_[i] = (*src_vec)[j] * scale[j];
+                for (size_t j = 0; j < ks.len; ++j) {
+                    single_frame_[i] = src[j] * ks.scale[j];
                     ++i;
                 }
             }
@@ -190,61 +262,19 @@ public:
 
         // 3) 비스택 구간
         size_t base = L * static_cast<size_t>(S);
-        const auto& non_stacked = cached_non_stacked_order_;
-        for (const auto& key : non_stacked) {
-            size_t obs_len = get_obs_len_(key);
-
-            const std::vector<float>& scale = (key == "command")
-                ? cached_cmd_scale_
-                : get_obs_scale_(key, obs_len);
-
-            py::object obs_obj = py::none();
-            if (key == "command") {
-                if (cmd.contains("cmd_vector")) obs_obj = cmd["cmd_vector"];
-            } else if (key == "last_action") {
-                // 내부 last_action_ 사용
-            } else {
-                if (obs.contains(py::str(key))) obs_obj = obs[py::str(key)];
-            }
-
-            if (obs_obj.is_none() && key != "last_action") {
-                base += obs_len;
-            } else {
-                const std::vector<float>* src_vec = nullptr;
-                std::vector<float> tmp;
-                if (key == "last_action") {
-                    src_vec = &last_action_;
-                } else {
-                    tmp = obs_obj.cast<std::vector<float>>(); // 입력은 매 호출 변함
-                    src_vec = &tmp;
-                }
-                for (size_t j = 0; j < obs_len; ++j) {
-                    state_[base + j] = (*src_vec)[j] * scale[j];
+        for (const auto& ks : non_stacked_slots_) {
+            const float* src = source(ks);
+            if (src) {
+                for (size_t j = 0; j < ks.len; ++j) {
+                    state_[base + j] = src[j] * ks.scale[j];
                 }
-                base += obs_len;
             }
+            base += ks.len;
         }
 
         return state_;
     }
 
-    // policy.inference(state) → [-1,1] → action_scale 적용 (검사 없음: set_mode에서 이미 확인)
-    std::vector<float> select_action(const std::vector<float>& state) {
-        ensure_mode_();
-
-        // 캐시 사용 (유효성 검사는 set_mode에서 끝냄)
-        py::object py_action = cached_policy_.attr("inference")(state);
-        std::vector<float> action = py_action.cast<std::vector<float>>();
-
-        const size_t n = last_action_len_;
-        for (size_t i = 0; i < n; ++i) {
-            scaled_action_[i] = action[i] * cached_action_scale_[i];
-        }
-        last_action_ = action;
-        return scaled_action_;
-    }
-
-private:
     // --- 내부 상태 ---
     std::unordered_map<std::string, size_t> obs_to_length_;
     py::object mode_;                 // 현재 모드 (None 가능)
@@ -263,6 +293,10 @@ private:
     size_t                       last_action_len_{0};         // len(last_action)
     std::vector<std::string>     cached_stacked_order_;
     std::vector<std::string>     cached_non_stacked_order_;
+    std::vector<KeySlot>         stacked_slots_;
+    std::vector<KeySlot>         non_stacked_slots_;
+    farray                       obs_hold_;  // dict 경로: 현재 키의 배열 (포인터 수명 유지)
+    std::vector<float>           cmd_tmp_;   // cmd_vector 변환 버퍼
     int                          cached_stack_size_{1};
     std::vector<float>           cached_cmd_scale_;
     std::unordered_map<std::string, std::vector<float>> cached_obs_scale_map_; // mode.obs_scale 원본 캐시
@@ -309,4 +343,6 @@ private:
     mutable std::vector<float> padding_buffer_;
 };
 
+using RL = BasicRL<DefaultTopology>;
+
 } // namespace rl
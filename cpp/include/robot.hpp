@@ -1,7 +1,11 @@
 #pragma once
 #include <array>
+#include <bit>
 #include <chrono>
 #include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -10,10 +14,30 @@
 #include <thread>
 #include <algorithm>
 #include <cstdio>
+#include <exception>
 #include <sstream>
 #include <iomanip>
+#include <cmath>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 #include "fx_client.hpp"  // Native FxCli for UDP communication
+#include "robot_backend.hpp" // 보드 / 시뮬레이션 / 재생 공통 인터페이스
+#include "udp_backend.hpp" // 기본 백엔드: FxPool 위의 UDP 보드
+#include "obs_frame.hpp"  // 고정 레이아웃 관측 (Robot/RL 공용)
+#include "topology.hpp"   // 보드 / 관절 / 바퀴 구성과 인덱스 표 (컴파일 타임)
+#include "joint_limits.hpp" // SIMD 관절 한계 검사
+#include "rt_clock.hpp"   // 시스템 / 가상 시계 (wake, _wait, 관측 시각)
+#include "rt_thread.hpp"  // precise_stop 스트리밍 스레드
+#include "seq_slot.hpp"   // watchdog으로 최신 관측 전달
+#include "seq_ring.hpp"   // 최근 관측 이력 (다중 reader)
+#include "watchdog.hpp"   // 독립 안전 감시 스레드
+#include "wake_ramp.hpp"  // 틱 단위 wake gain 램프
+#include "stop_trajectory.hpp" // precise_stop 감속 / 자세 궤적
+#include "lin_vel_estimator.hpp" // IMU + 바퀴 odometry → lin_vel
+#include "action_shaper.hpp" // do_action 목표 속도 제한 / 평활 / sub-tick 보간
+#include "impedance_law.hpp" // do_torque 관절 임피던스 법칙
 
 namespace robot {
 
@@ -22,62 +46,82 @@ struct RobotEStopError : public std::runtime_error { using std::runtime_error::r
 struct RobotSetGainsError : public std::runtime_error { using std::runtime_error::runtime_error; };
 struct RobotSleepError : public std::runtime_error { using std::runtime_error::runtime_error; };
 
-class Robot {
+// Topo: 보드 수 / 보드당 관절·바퀴 수 / 관절 이름 (topology.hpp). 인덱스 표와 배열 크기가
+// 모두 컴파일 타임 상수라 관측 조립 / 목표값 변환 / 한계 검사 루프가 펼쳐진다.
+// Robot = BasicRobot<DefaultTopology>
+template <class Topo>
+class BasicRobot {
 public:
-    Robot()
-        : _last_action_len(16),
-          _motor_ids_front{1u,2u,3u,4u,5u,6u,7u,8u},
-          _motor_ids_rear{9u,10u,11u,12u,13u,14u,15u,16u},
+    using Topology = Topo;
+    using Frame = BasicObsFrame<Topo>;
+
+    // 기본 하드웨어 구성: 보드 k = 192.168.(10+k).10 (4W: 앞 보드 M1..M8, 뒤 보드 M9..M16, IMU 포함)
+    static std::vector<FxBoard> default_boards() {
+        std::vector<FxBoard> b;
+        const auto ids = Topo::board_ids();
+        for (size_t k = 0; k < Topo::kBoards; ++k)
+            b.push_back({"192.168." + std::to_string(10 + k) + ".10", 5101, ids[k]});
+        return b;
+    }
+
+    BasicRobot() : BasicRobot(default_boards()) {}
+
+    explicit BasicRobot(const std::vector<FxBoard>& boards)
+        : BasicRobot(std::make_shared<FxPool>(), boards) {}
+
+    // 여러 로봇이 하나의 FxPool(=I/O 스레드 1개)을 공유할 때 사용.
+    // boards는 풀에 추가되며, 보드 순서대로 이어 붙인 모터 순서가 action 인덱스 순서가 된다.
+    BasicRobot(std::shared_ptr<FxPool> pool, const std::vector<FxBoard>& boards)
+        : BasicRobot(std::make_unique<UdpBackend>(std::move(pool), boards)) {}
+
+    // 임의의 백엔드 (SimBackend: 하드웨어 없이 plant 시뮬레이션, ReplayBackend: 기록 재생).
+    // clock: 기본은 시스템 시계. VirtualClock을 주면 대기/램프가 즉시 끝나고 시각만 진행한다
+    // (실제 I/O를 기다리는 UDP 백엔드와는 함께 쓸 수 없음).
+    explicit BasicRobot(std::unique_ptr<RobotBackend> backend, std::shared_ptr<rt::Clock> clock = nullptr)
+        : _last_action_len(kNumMotors),
+          _backend(std::move(backend)),
+          _clock(clock ? std::move(clock) : rt::system_clock()),
           _cli_disconn_timeout_ms(200),
           _cli_disconn_duration_ms(0),
           _cli_missed_req(0),
+          _tick_ms(20.0),
           _kp(_last_action_len, 0.0f),
           _kd(_last_action_len, 0.0f),
-          _gains_set(false),
-          _cli_front("192.168.10.10", 5101),   // [FIX] 세미콜론 → 콤마, 멤버 이니셜라이저로 생성
-          _cli_rear("192.168.11.10", 5101)     // [FIX] 세미콜론 → 콤마, 멤버 이니셜라이저로 생성
+          _gains_set(false)
     {                                          // [FIX] 생성자 본문 시작 누락 보완
-        // Observation containers (pre-sized & reused)
-        _obs["dof_pos"] = std::vector<float>(12, 0.0f);   // 12개 관절 (바퀴 제외)
-        _obs["dof_vel"] = std::vector<float>(16, 0.0f);   // 16개 모터 속도 (바퀴 포함)
-        _obs["ang_vel"] = std::vector<float>(3, 0.0f);
-        _obs["proj_grav"] = std::vector<float>(3, 0.0f);
-        _obs["last_action"] = std::vector<float>(16, 0.0f);
-        _obs["lin_vel"] = std::vector<float>(3, 0.0f);
-        _obs["height_map"] = std::vector<float>(144, 0.6128f);
-
-        // Offsets & limits
-        _pos_offset = {
-            {"left_hip_f", 0.0f}, {"right_hip_f", 0.0f},
-            {"left_shoulder_f", 0.0f}, {"right_shoulder_f", 0.0f},
-            {"left_leg_f", 0.0f}, {"right_leg_f", 0.0f},
-
-            {"left_hip_r", 0.0f}, {"right_hip_r", 0.0f},
-            {"left_shoulder_r", 0.0f}, {"right_shoulder_r", 0.0f},
-            {"left_leg_r", 0.0f}, {"right_leg_r", 0.0f},
-        };
-        _rel_max_pos = {
-            {"left_hip_f", 3.14f}, {"right_hip_f", 3.14f},
-            {"left_shoulder_f", 3.14f}, {"right_shoulder_f", 3.14f},
-            {"left_leg_f", 3.14f}, {"right_leg_f", 3.14f},
-
-            {"left_hip_r", 3.14f}, {"right_hip_r", 3.14f},
-            {"left_shoulder_r", 3.14f}, {"right_shoulder_r", 3.14f},
-            {"left_leg_r", 3.14f}, {"right_leg_r", 3.14f},
-        };
-        _rel_min_pos = {
-            {"left_hip_f", -3.14f}, {"right_hip_f", -3.14f},
-            {"left_shoulder_f", -3.14f}, {"right_shoulder_f", -3.14f},
-            {"left_leg_f", -3.14f}, {"right_leg_f", -3.14f},
-
-            {"left_hip_r", -3.14f}, {"right_hip_r", -3.14f},
-            {"left_shoulder_r", -3.14f}, {"right_shoulder_r", -3.14f},
-            {"left_leg_r", -3.14f}, {"right_leg_r", -3.14f},
-        };
-        _joint_names = { // pos 인덱스 0..11에 해당하는 관절 이름
-            "left_hip_f","right_hip_f","left_shoulder_f","right_shoulder_f","left_leg_f","right_leg_f",
-            "left_hip_r","right_hip_r","left_shoulder_r","right_shoulder_r","left_leg_r","right_leg_r"
-        };
+        if (!_backend) throw std::invalid_argument("Robot: backend must not be null");
+        if (_clock->is_virtual() && !_backend->virtual_time_ok())
+            throw std::invalid_argument(std::string("Robot: the '") + _backend->name() +
+                                        "' backend waits on real I/O and cannot run on a virtual clock");
+        size_t offset = 0;
+        for (const auto& ids : _backend->boards()) {
+            if (ids.size() != Topo::kMotorsPerBoard)   // 인덱스 표는 보드마다 같은 배치(관절 → 바퀴)를 가정
+                throw std::invalid_argument("Robot: every board must provide exactly " +
+                                            std::to_string(Topo::kMotorsPerBoard) + " motors");
+            _motor_ids.push_back(ids);
+            _motor_offset.push_back(offset);
+            offset += ids.size();
+        }
+        if (_motor_ids.size() != Topo::kBoards)
+            throw std::invalid_argument("Robot: expected " + std::to_string(Topo::kBoards) + " boards");
+        _req_motors.resize(_last_action_len);
+        _req_stamps.resize(_motor_ids.size());
+        _motor_health.resize(_last_action_len);
+        _board_health.resize(_motor_ids.size());
+        _cmd_sel.reserve(_motor_ids.size());
+        _cmd_ok.reserve(_motor_ids.size());
+
+        // Observation frame (fixed layout, reused)
+        _frame.reset();
+
+        // Offsets & limits (관절 이름 기준, 기본값: offset 0 / 범위 ±3.14 rad)
+        for (std::string_view name : Topo::kJointNames) {
+            _joint_names.emplace_back(name);
+            _pos_offset[_joint_names.back()] = 0.0f;
+            _rel_max_pos[_joint_names.back()] = 3.14f;
+            _rel_min_pos[_joint_names.back()] = -3.14f;
+        }
+        _build_index_tables();
 
         _wait(); // [FIX] 양쪽 보드 준비 대기
     }
@@ -88,509 +132,779 @@ public:
             throw RobotSetGainsError("kp length mismatch for the robot.");
         if (kd.size() != _last_action_len)
             throw RobotSetGainsError("kd length mismatch for the robot.");
-        if (kp[6] != 0.0f || kp[7] != 0.0f)
-            throw RobotSetGainsError("Wheel motor kp must be zero for indices 6 and 7.");
-        if (kp[14] != 0.0f || kp[15] != 0.0f)
-            throw RobotSetGainsError("Wheel motor kp must be zero for indices 14 and 15.");
+        for (size_t k = 0; k < Topo::kBoards; ++k) {   // 보드별 바퀴 (4W: 6, 7 / 14, 15)
+            const uint8_t* w = Topo::kWheelMotor.data() + k * Topo::kWheelsPerBoard;
+            if (std::any_of(w, w + Topo::kWheelsPerBoard, [&](uint8_t g) { return kp[g] != 0.0f; }))
+                throw RobotSetGainsError("Wheel motor kp must be zero for " + _wheel_list(k) + ".");
+        }
         for (float v : kp) if (v < 0.0f) throw RobotSetGainsError("kp must be non-negative.");
         for (float v : kd) if (v < 0.0f) throw RobotSetGainsError("kd must be non-negative.");
         _kp = kp; _kd = kd; _gains_set = true;
+        _backend->gains_changed();
     }
 
     // ------- Safety check -------
-    void check_safety() { // [FIX] 잘못된 시그니처(void check_safety(name={...})) 수정, 양쪽 보드 모두 점검
-        std::string status_front = _cli_front.status();
-        std::string status_rear  = _cli_rear.status();
-
-        auto [dis_f, emg_f] = _check_status(status_front, _motor_ids_front); // [FIX] 보드별 상태 점검
-        auto [dis_r, emg_r] = _check_status(status_rear,  _motor_ids_rear);
+    void check_safety() { // [FIX] 잘못된 시그니처(void check_safety(name={...})) 수정, 모든 보드 점검
+        _backend->status(_motor_health.data(), _board_health.data());   // 모든 보드에 동시에 STATUS
 
-        bool disconn_flag = dis_f || dis_r;
-        bool emergency_flag = emg_f || emg_r;
+        bool disconn_flag = false, emergency_flag = false;
+        for (size_t k = 0; k < _motor_ids.size(); ++k) {
+            auto [dis, emg] = _check_status(k); // [FIX] 보드별 상태 점검
+            disconn_flag   |= dis;
+            emergency_flag |= emg;
+        }
 
         if (!disconn_flag) _cli_disconn_duration_ms = 0;
-        else _cli_disconn_duration_ms += 20;
+        else _cli_disconn_duration_ms += _tick_ms;
 
-        if (emergency_flag || std::max(_cli_disconn_duration_ms, _cli_missed_req * 20) >= _cli_disconn_timeout_ms)
+        if (emergency_flag || std::max(_cli_disconn_duration_ms, _cli_missed_req * _tick_ms) >= _cli_disconn_timeout_ms)
             throw RobotEStopError("E-stop: connection timeout or emergency flag reported");
 
-        _check_obs(_obs);
+        _check_obs(_frame);
+    }
+
+    /// @brief Per-motor health from the last STATUS (check_safety / wake), in action order.
+    std::span<const MotorHealth> motor_health() const { return _motor_health; }
+
+    /// @brief Per-board part (valid, EMERGENCY, SEQ_NUM) of the last STATUS, in board order.
+    std::span<const BoardHealth> board_health() const { return _board_health; }
+
+    // ------- Observation (internal frame, overwritten by the next get_obs) -------
+    const Frame& get_obs() { // [FIX] 모든 보드에서 수집
+        _read_obs();                       // [FIX] 모든 보드에 동시에 REQ → 한 번에 반영
+        _stamp_obs(_clock->now_ns());
+        if (_lin_vel_on) _lin_vel.update(_frame);   // REQ마다 (stale이면 예측만)
+        ++_frame.seq;
+        if (_frame.fresh) _wd_obs_ns.store(_frame.stamp_ns, std::memory_order_release);
+        _wd_obs.store(_frame);
+        _history.push(_frame);
+        return _frame;
     }
 
-    // ------- Observation (returns copy; internal buffers reused) -------
-    std::unordered_map<std::string, std::vector<float>> get_obs() { // [FIX] 전/후 보드 모두에서 수집
-        std::string mcu_front = _cli_front.req(_motor_ids_front);
-        std::string mcu_rear  = _cli_rear.req(_motor_ids_rear);
-        auto& parsed = _parse_obs(mcu_front, mcu_rear);  // [FIX] 두 문자열을 한 번에 파싱
-        return parsed;
+    // ------- Observation history -------
+    // get_obs()가 반환한 프레임(stale 포함)을 순서대로 kObsHistory개까지 보관한다.
+    // 프레임 seq s는 이력 인덱스 s - 1. 쓰기는 get_obs() 스레드 하나, 읽기는 어느 스레드에서나
+    // 잠금 없이 (read / read_latest: 슬롯별 seq 확인, window: 복사 없는 연속 구간).
+    static constexpr size_t kObsHistory = 128;
+    using History = SeqRing<Frame, kObsHistory>;
+    const History& obs_history() const { return _history; }
+
+    // 바인딩이 GIL 없이 호출할 때 같은 Robot에 대한 호출을 직렬화하는 잠금
+    // (C++에서 한 스레드로만 쓰면 필요 없음)
+    std::mutex& call_mutex() { return _call_mtx; }
+
+    // 마지막 get_obs()가 이번 틱 데이터였는지 (false면 이전 관측을 그대로 반환한 것)
+    bool obs_fresh() const { return _frame.fresh != 0; }
+
+    // lin_vel 추정 켜기 (바퀴 반지름 / 좌우 간격은 기구에 맞게 필수). 끄면 lin_vel은 0으로 남는다
+    void set_lin_vel_estimator(const LinVelOptions& opt) {
+        if (!(opt.wheel_radius > 0.0f) || !(opt.track_width > 0.0f))
+            throw std::invalid_argument("set_lin_vel_estimator: wheel_radius and track_width must be > 0");
+        for (uint8_t i : opt.wheel_index)
+            if (i >= Frame::kDofVel) throw std::invalid_argument("set_lin_vel_estimator: wheel_index out of range");
+        _lin_vel.configure(opt);
+        _lin_vel_on = true;
     }
+    void disable_lin_vel_estimator() {
+        _lin_vel_on = false;
+        std::fill(std::begin(_frame.lin_vel), std::end(_frame.lin_vel), 0.0f);
+    }
+    const LinVelEstimator* lin_vel_estimator() const { return _lin_vel_on ? &_lin_vel : nullptr; }
+
+    // ------- Action shaper -------
+    // do_action(위치 제어) 목표를 계단 대신 action 항목별 속도 제한 + 1차 평활 + 주기 안 sub-tick
+    // 선형 보간으로 다듬어 보낸다 (ActionShaper). sub_ticks > 1이면 do_action이 첫 프레임을,
+    // action_subtick()이 나머지를 보낸다 (ControlLoop lockstep은 주기를 나눠 자동으로 부름).
+    using Shaper = ActionShaper<Topo::kMotors>;
+    void set_action_shaper(const ShaperOptions& opt) {
+        if (!opt.max_rate.empty() && opt.max_rate.size() != kNumMotors)
+            throw std::invalid_argument("set_action_shaper: max_rate must have one entry per action (" +
+                                        std::to_string(kNumMotors) + ") or none");
+        for (float r : opt.max_rate)
+            if (!std::isfinite(r)) throw std::invalid_argument("set_action_shaper: max_rate must be finite");
+        if (!(opt.smooth_ms >= 0.0f)) throw std::invalid_argument("set_action_shaper: smooth_ms must be >= 0");
+        if (opt.sub_ticks < 1 || opt.sub_ticks > Shaper::kMaxSubTicks)
+            throw std::invalid_argument("set_action_shaper: sub_ticks must be in [1, " +
+                                        std::to_string(Shaper::kMaxSubTicks) + "]");
+        _shaper.configure(opt, _tick_ms);   // 다음 do_action 목표에서 시작
+        _shaper_on = true;
+    }
+    void disable_action_shaper() {
+        _shaper_on = false;
+        _shaper.configure({}, _tick_ms);
+    }
+    const Shaper* action_shaper() const { return _shaper_on ? &_shaper : nullptr; }
+
+    /// @brief MIT frames per control period (1 without a shaper).
+    int action_sub_ticks() const { return _shaper_on ? _shaper.sub_ticks() : 1; }
+
+    // 다음 sub-tick 프레임 송신 (관측 / check_safety 없음). 주기를 sub_ticks로 나눈 시각마다 부른다.
+    // @return false: 보낼 것 없음 (shaper 꺼짐 / 아직 위치 action 없음 / wake 중)
+    bool action_subtick() {
+        if (!_shaper_on || !_shaper.primed() || !_wd_in_control.load(std::memory_order_relaxed)) return false;
+        _position_targets(_shaper.step());
+        _send_targets(_tx_pos, _tx_vel, _tx_kp, _tx_kd, _tx_tau);
+        return true;
+    }
+
+    // 마지막 do_action(): 그 action이 쓴 관측의 수신 시각 → 목표값 송신 시각 (ns).
+    // 보드 응답 수신부터 정책을 거쳐 모터로 나가기까지의 실제 제어 지연
+    int64_t obs_to_action_ns() const { return _obs_to_action_ns; }
+
+    // RX 스레드에서 버린 불량 프레임 수 (CRC 불일치 + 잘린 패킷, 모든 보드 합)
+    uint64_t rx_bad_frames() { return _backend->rx_bad_frames(); }
+
+    // REQ 재송신 예산 = control_period_ms * slice (기본 20ms * 0.1 = 2ms)
+    void set_req_retry(double control_period_ms, double slice) {
+        _backend->set_req_retry(control_period_ms, slice);
+    }
+
+    // do_action()/check_safety() 호출 주기. 끊김 시간을 틱 수 × 주기로 누적하므로
+    // 50 Hz(20 ms)가 아닌 주기로 돌릴 때는 맞춰 줘야 200 ms 타임아웃이 유지된다.
+    void set_control_period(double period_ms) {
+        if (!(period_ms > 0.0)) throw std::invalid_argument("set_control_period: period_ms must be greater than 0");
+        _tick_ms = period_ms;
+        _shaper.set_period(period_ms);
+        _backend->set_control_period(period_ms);
+    }
+    double control_period() const { return _tick_ms; }
+
+    /// @brief What this Robot talks to (UdpBackend, SimBackend, ReplayBackend, ...).
+    RobotBackend& backend() { return *_backend; }
+
+    /// @brief Time source for stamps, wake() and the start-up wait (shared with ControlLoop).
+    const std::shared_ptr<rt::Clock>& clock() const { return _clock; }
+
+    // ------- Watchdog -------
+    // 별도 RT 스레드가 (1) 마지막 MIT 송신, (2) 마지막 fresh 관측 이후 경과 시간과
+    // (3) 최신 관측의 위치/속도 한계(_check_obs와 같은 기준)를 주기적으로 검사한다.
+    // 위반 시 잠금 없이 모든 보드에 AT+ESTOP을 직접 보내고 래치; 이후 do_action()/wake()는
+    // ACK까지 받는 정식 estop()으로 RobotEStopError를 던진다.
+    // 감시는 첫 송신부터 시작하고 estop()/sleep() 뒤에는 다음 송신까지 쉰다.
+    void start_watchdog(const WatchdogOptions& opt = {}) {
+        if (_clock->is_virtual())   // 감시는 벽시계 기준 (가상 시각과 비교할 수 없음)
+            throw std::invalid_argument("start_watchdog: not available on a virtual clock");
+        _watchdog.reset();
+        _wd_seen = 0;
+        _watchdog = std::make_unique<Watchdog>(opt,
+            [this, opt](int64_t now, WatchdogTrip& tr) { return _watchdog_check(opt, now, tr); },
+            [this](const WatchdogTrip&) {
+                for (int rep = 0; rep < 2; ++rep)   // UDP 유실 대비 한 번 더
+                    _backend->estop_nowait();
+            });
+    }
+    void stop_watchdog() { _watchdog.reset(); }
+
+    /// @return the running watchdog or nullptr
+    const Watchdog* watchdog() const { return _watchdog.get(); }
 
     // ------- Action -------
     void do_action(const std::vector<float>& action, bool torque_ctrl=false) {
+        do_action(std::span<const float>(action), torque_ctrl);
+    }
+
+    // 연속 float 버퍼 (NumPy float32 배열을 복사 없이 그대로 넘길 때).
+    // 고정 크기 배열 + 인덱스 테이블만 사용 → 힙 할당/문자열 해싱 없음
+    void do_action(std::span<const float> action, bool torque_ctrl=false) {
         if (!_gains_set)
             throw RobotSetGainsError("Robot's kp and kd must be provided before do_action.");
         if (action.size() != _last_action_len)
             estop("action length mismatch.");
-
-        std::vector<float> pos(_last_action_len, 0.0f);
-        std::vector<float> vel(_last_action_len, 0.0f);
-        std::vector<float> kp(_last_action_len, 0.0f);
-        std::vector<float> kd(_last_action_len, 0.0f);
-        std::vector<float> tau(_last_action_len, 0.0f);
+        _wd_in_control.store(true, std::memory_order_release);   // 한계 감시는 제어 중에만 (wake 램프 제외)
+        _wake.cancel();                                            // 정책이 넘겨받음
+        _stop.cancel();
 
         if (torque_ctrl) {
-            tau = action;
+            _tx_pos.fill(0.0f);
+            _tx_vel.fill(0.0f);
+            _tx_kp.fill(0.0f);
+            _tx_kd.fill(0.0f);
+            std::copy(action.begin(), action.end(), _tx_tau.begin());
+            _shaper.reset();   // 위치 제어로 돌아오면 그 목표에서 다시 시작
+        } else if (_shaper_on) {
+            _shaper.set_target(action.data());
+            _position_targets(_shaper.step());
         } else {
-            // [FIX] 16채널 매핑:
-            //  - 0..5  : 앞다리 6관절 위치 제어
-            //  - 6..7  : 앞바퀴 속도 제어
-            //  - 8..13 : 뒷다리 6관절 위치 제어
-            //  - 14..15: 뒷바퀴 속도 제어
-            for (size_t i = 0; i < _last_action_len; ++i) {
-                bool is_pos_idx = (i < 6) || (i >= 8 && i < 14);
-                if (is_pos_idx) {
-                    // pos 인덱스 → _joint_names 인덱스 매핑
-                    size_t jidx = (i < 6) ? i : (i - 2); // [FIX] 8..13 -> 6..11
-                    const std::string& jname = _joint_names[jidx];
-                    float off = _pos_offset[jname];
-                    pos[i] = action[i] - off;
-                } else {
-                    vel[i] = action[i]; // 바퀴(6,7,14,15)는 속도 제어
-                }
-                kp[i] = _kp[i];
-                kd[i] = _kd[i];
-            }
+            _position_targets(action.data());
         }
 
-        // [FIX] 전/후 보드로 분리 송신
-        auto slice = [](const std::vector<float>& v, size_t s, size_t e) {
-            return std::vector<float>(v.begin()+s, v.begin()+e);
-        };
-        // 앞 보드: 인덱스 0..7
-        _cli_front.operation_control(
-            _motor_ids_front,
-            slice(pos, 0, 8), slice(vel, 0, 8),
-            slice(kp,  0, 8), slice(kd,  0, 8),
-            slice(tau, 0, 8)
-        );
-        // 뒤 보드: 인덱스 8..15
-        _cli_rear.operation_control(
-            _motor_ids_rear,
-            slice(pos, 8, 16), slice(vel, 8, 16),
-            slice(kp,  8, 16), slice(kd,  8, 16),
-            slice(tau, 8, 16)
-        );
+        if (_frame.rx_ns) _obs_to_action_ns = _clock->now_ns() - _frame.rx_ns;
+        _send_targets(_tx_pos, _tx_vel, _tx_kp, _tx_kd, _tx_tau);
         // (선택) last_action 저장
-        _obs["last_action"] = action;
+        std::copy_n(action.begin(), std::min(action.size(), Frame::kLastAction), _frame.last_action);
         check_safety();
     }
 
+    // ------- Native torque mode -------
+    // do_torque(setpoint): 최신 관측(마지막 get_obs)과 정책 setpoint(action 순서: 관절 위치, 바퀴 속도)로
+    // 토크를 C++에서 계산해 tau만 담은 MIT 프레임(kp = kd = 0)을 보낸다. 기본은 관절 임피던스 법칙
+    // (set_impedance); set_torque_law()로 전신 토크 법칙 등을 끼울 수 있고 tau_limit 클램프는 항상 적용된다.
+    // 전송 주기(≥500 Hz)로 돌리려면 ControlLoop multi-rate + LoopOptions::torque (정책은 hz로 setpoint만 갱신).
+    using TorqueLaw = std::function<void(const Frame& obs, std::span<const float> setpoint, std::span<float> tau)>;
+
+    void set_impedance(const ImpedanceOptions& opt) {
+        if (opt.kp.size() != _last_action_len || opt.kd.size() != _last_action_len)
+            throw RobotSetGainsError("set_impedance: kp and kd need one entry per action.");
+        if (!opt.tau_limit.empty() && opt.tau_limit.size() != _last_action_len)
+            throw RobotSetGainsError("set_impedance: tau_limit needs one entry per action or none.");
+        for (float v : opt.kp) if (!(v >= 0.0f)) throw RobotSetGainsError("set_impedance: kp must be non-negative.");
+        for (float v : opt.kd) if (!(v >= 0.0f)) throw RobotSetGainsError("set_impedance: kd must be non-negative.");
+        _impedance.set(opt);
+        _impedance_set = true;
+    }
+
+    // 빈 law: 임피던스 법칙으로 되돌림. 제어 스레드에서 매 틱 불리므로 할당 / 블로킹 없이 짜야 한다
+    void set_torque_law(TorqueLaw law) { _torque_law = std::move(law); }
+
+    void do_torque(const std::vector<float>& setpoint) { do_torque(std::span<const float>(setpoint)); }
+
+    void do_torque(std::span<const float> setpoint) {
+        if (!_impedance_set)
+            throw RobotSetGainsError("Robot's impedance must be provided before do_torque.");
+        if (setpoint.size() != _last_action_len)
+            estop("action length mismatch.");
+        _wd_in_control.store(true, std::memory_order_release);
+        _wake.cancel();
+        _stop.cancel();
+        _shaper.reset();   // 위치 제어로 돌아오면 그 목표에서 다시 시작
+
+        if (_torque_law) {
+            _torque_law(_frame, setpoint, std::span<float>(_tq_tau, kNumMotors));
+            _impedance.clamp(_tq_tau);
+        } else {
+            unroll<kNumMotors>([&](auto g) {
+                constexpr int j = Topo::kActJoint[g];
+                if constexpr (j >= 0) { _tq_ref[g] = setpoint[g]; _tq_q[g] = _frame.dof_pos[j]; _tq_dref[g] = 0.0f; }
+                else                  { _tq_ref[g] = 0.0f;        _tq_q[g] = 0.0f;              _tq_dref[g] = setpoint[g]; }
+                _tq_dq[g] = _frame.dof_vel[g];
+            });
+            _impedance.eval(_tq_ref, _tq_q, _tq_dref, _tq_dq, _tq_tau);
+        }
+
+        _tx_pos.fill(0.0f);
+        _tx_vel.fill(0.0f);
+        _tx_kp.fill(0.0f);
+        _tx_kd.fill(0.0f);
+        std::copy_n(_tq_tau, kNumMotors, _tx_tau.begin());
+
+        if (_frame.rx_ns) _obs_to_action_ns = _clock->now_ns() - _frame.rx_ns;
+        _send_targets(_tx_pos, _tx_vel, _tx_kp, _tx_kd, _tx_tau);
+        std::copy_n(setpoint.begin(), std::min(setpoint.size(), Frame::kLastAction), _frame.last_action);
+        check_safety();
+    }
+
+    /// @brief Torque sent by the last do_torque() (action order).
+    std::span<const float> last_torque() const { return {_tq_tau, kNumMotors}; }
+
     // ------- Control utils -------
     [[noreturn]] void estop(const std::string& msg = std::string()) {
-        const auto retry = std::chrono::milliseconds(10);
-        for (;;) {
-            bool ok_f = _cli_front.motor_estop(_motor_ids_front); // [FIX] 양쪽 보드 E-stop
-            bool ok_r = _cli_rear.motor_estop(_motor_ids_rear);   // [FIX]
-            if (ok_f && ok_r) break;
-            std::this_thread::sleep_for(retry);
-        }
+        _estop_all_boards(); // [FIX] 모든 보드 E-stop
         throw RobotEStopError(msg.empty() ? "E-stop triggered" : msg);
     }
 
     [[noreturn]] void sleep() {
-        const auto retry = std::chrono::milliseconds(10);
-        for (;;) {
-            bool ok_f = _cli_front.motor_estop(_motor_ids_front); // [FIX] 양쪽 보드 Sleep=E-stop
-            bool ok_r = _cli_rear.motor_estop(_motor_ids_rear);   // [FIX]
-            if (ok_f && ok_r) break;
-            std::this_thread::sleep_for(retry);
-        }
+        _estop_all_boards(); // [FIX] 모든 보드 Sleep=E-stop
         throw RobotSleepError("Sleep triggered");
     }
 
-    void wake() {
+    // ------- Wake (tick-driven gain ramp) -------
+    // safe gain → nominal gain의 절반까지 램프하며 0 자세를 유지하고, 관절이 밴드 안에
+    // settle_ms 동안 머물면 nominal gain을 보내고 끝난다. 상태는 WakeRamp가 틱 단위로 갖고 있어
+    // begin_wake() 뒤 제어 주기마다 wake_step()을 부르면 된다 (ControlLoop는 waking() 동안 자동으로 부름).
+    // 램프 중에 do_action()을 부르면 램프는 취소되고 정책이 제어를 넘겨받는다.
+    void begin_wake(const WakeOptions& opt = {}) {
         if (!_gains_set) throw RobotSetGainsError("wake(): call set_gains() before wake()");
-    
-        auto kp_nom = _kp, kd_nom = _kd; 
-        std::vector<float> kp_safe = {5,5,5,5,5,5,0,0, 5,5,5,5,5,5,0,0};
-        std::vector<float> kd_safe = {0.15f,0.15f,0.15f,0.15f,0.15f,0.15f,0.25f,0.25f,
-                                      0.15f,0.15f,0.15f,0.15f,0.15f,0.15f,0.25f,0.25f};
-        set_gains(kp_safe, kd_safe);
-    
-        std::vector<float> pos(16,0), vel(16,0), tau(16,0);
-        auto send = [&](const std::vector<float>& kp,const std::vector<float>& kd){
-            _cli_front.operation_control(_motor_ids_front, {pos.begin(),pos.begin()+8},{vel.begin(),vel.begin()+8},
-                                         {kp.begin(),kp.begin()+8},{kd.begin(),kd.begin()+8},{tau.begin(),tau.begin()+8});
-            _cli_rear.operation_control(_motor_ids_rear, {pos.begin()+8,pos.end()},{vel.begin()+8,vel.end()},
-                                        {kp.begin()+8,kp.end()},{kd.begin()+8,kd.end()},{tau.begin()+8,tau.end()});
-        };
-    
-        const int ramp_ms=7000, max_ms=10000, settle_ms=200, dt=20; // ★ 7초로 변경
-        const float pos_eps=0.02f, vel_eps=0.05f;
-        auto kp_half=kp_nom, kd_half=kd_nom;
-        for(size_t i=0;i<kp_nom.size();++i){ kp_half[i]*=0.5f; kd_half[i]*=0.5f; }
-    
-        auto now=[](){return (int)std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now().time_since_epoch()).count();};
-        int t0=now(), in_band=-1;
-    
-        while(true){
-            int t=now(), el=t-t0;
-            float a=std::min(1.f, el/float(ramp_ms));
-            std::vector<float> kp(16),kd(16);
-            for(size_t i=0;i<16;++i){ kp[i]=kp_safe[i]+a*(kp_half[i]-kp_safe[i]);
-                                      kd[i]=kd_safe[i]+a*(kd_half[i]-kd_safe[i]); }
-            send(kp,kd);
-    
-            auto obs=get_obs(); auto&q=obs["dof_pos"]; auto&dq=obs["dof_vel"];
-            bool pos_ok=std::all_of(q.begin(),q.begin()+12,[&](float v){return fabs(v)<=pos_eps;});
-            bool vel_ok=std::all_of(dq.begin(),dq.end(),[&](float v){return fabs(v)<=vel_eps;});
-    
-            if(pos_ok&&vel_ok){
-                if(in_band<0) in_band=t;
-                if(t-in_band>=settle_ms || el>=max_ms) break;
-            } else in_band=-1;
-    
-            if(el>max_ms) estop("wake(): timeout (>10s)");
-            std::this_thread::sleep_for(std::chrono::milliseconds(dt));
-        }
-    
-        set_gains(kp_nom,kd_nom);
-        send(kp_nom,kd_nom);
+        _wd_in_control.store(false, std::memory_order_release);   // 램프 중에는 한계 감시 안 함
+        _shaper.reset();
+        _stop.cancel();
+        _wake.begin(kWakeKp, kWakeKd, _kp, _kd, _tick_ms, opt);
+        _backend->gains_changed();   // 램프 gain: GAIN 지원 보드는 다시 업로드 시도
     }
-    
-    void precise_stop() { /* TODO */ }
-
-private:
-    // HW 준비 대기
-    void _wait(std::int32_t timeout_ms = 30000) { // [FIX] 양쪽 보드 모두 준비될 때까지 대기
-        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
-        const auto retry_sleep = std::chrono::milliseconds(100);
-        const auto safe_margin = std::chrono::milliseconds(100);
-
-        while (std::chrono::steady_clock::now() < deadline) {
-            bool started_f = _cli_front.motor_start(_motor_ids_front);
-            bool started_r = _cli_rear.motor_start(_motor_ids_rear);
-            if (!(started_f && started_r)) {
-                std::this_thread::sleep_for(retry_sleep);
-                continue;
-            }
-
-            std::string status_front = _cli_front.status();
-            std::string status_rear  = _cli_rear.status();
-            auto [dis_f, emg_f] = _check_status(status_front, _motor_ids_front);
-            auto [dis_r, emg_r] = _check_status(status_rear,  _motor_ids_rear);
-            if (dis_f || dis_r || emg_f || emg_r) {
-                std::this_thread::sleep_for(retry_sleep);
-                continue;
-            }
 
-            std::this_thread::sleep_for(safe_margin);
-            return;
+    bool waking() const { return _wake.active(); }
+    const WakeStatus& wake_status() const { return _wake.status(); }
+
+    // 램프 한 틱: 램프 gain으로 0 자세 송신 → 관측 → 판정. get_obs()와 같은 내부 프레임을 반환.
+    // max_ms 안에 settle 못 하면 estop → RobotEStopError
+    const Frame& wake_step() {
+        if (!_wake.active()) throw std::logic_error("wake_step(): call begin_wake() first");
+        _tx_pos.fill(0.0f);
+        _tx_vel.fill(0.0f);
+        _tx_tau.fill(0.0f);
+        _wake.gains(_tx_kp.data(), _tx_kd.data());
+        _send_targets(_tx_pos, _tx_vel, _tx_kp, _tx_kd, _tx_tau);   // 램프 중에는 매 틱 gain이 바뀌므로 매번 재업로드
+
+        const Frame& obs = get_obs();
+        switch (_wake.observe({obs.dof_pos, Frame::kDofPos}, {obs.dof_vel, Frame::kDofVel})) {
+        case WakePhase::Done: {
+            std::copy(_kp.begin(), _kp.end(), _tx_kp.begin());
+            std::copy(_kd.begin(), _kd.end(), _tx_kd.begin());
+            _send_targets(_tx_pos, _tx_vel, _tx_kp, _tx_kd, _tx_tau);
+            // shaper는 방금 보낸 0 자세(action 기준: 관절 offset, 바퀴 0)에서 정책 목표로 이어감
+            std::array<float, kNumMotors> rest{};
+            unroll<kNumMotors>([&](auto g) {
+                constexpr int j = Topo::kActJoint[g];
+                if constexpr (j >= 0) rest[g] = _joint_offset[j];
+            });
+            _shaper.prime(rest.data());
+            break;
         }
-        throw RobotEStopError("Motor start timeout");
+        case WakePhase::TimedOut:
+            estop("wake(): timeout (>" + std::to_string(static_cast<int>(_wake.options().max_ms / 1000.0)) + "s)");
+        default:
+            break;
+        }
+        return obs;
     }
 
-    // Status check (native string parsing)
-    std::pair<bool,bool> _check_status(const std::string& status_str,
-                                       const std::vector<uint8_t>& ids) { // [FIX] 보드별 아이디 집합을 받도록 변경
-        bool disconn_flag = false, emergency_flag = false;
-
-        if (status_str.find("OK <STATUS>") == std::string::npos) {
-            disconn_flag = true;
-        } else {
-            for (auto id : ids) {
-                std::string mid = "M" + std::to_string(id);
-                size_t pos = status_str.find(mid);
-                if (pos == std::string::npos) { disconn_flag = true; break; }
-                pos = status_str.find("pattern:", pos);
-                if (pos == std::string::npos) { disconn_flag = true; break; }
-                int pattern = std::stoi(status_str.substr(pos + 8));
-                if (pattern != 2) { disconn_flag = true; break; }
-            }
+    // 블로킹 wake: 절대 마감(next += 주기)으로 wake_step을 돌린다 → 램프 시간 = 틱 수 × 주기
+    void wake(const WakeOptions& opt = {}) {
+        begin_wake(opt);
+        const int64_t period = static_cast<int64_t>(_tick_ms * 1e6);
+        int64_t next = _clock->now_ns();
+        for (;;) {
+            wake_step();
+            if (!_wake.active()) return;
+            next += period;
+            const int64_t now = _clock->now_ns();
+            if (now > next) next = now + period;   // 마감 초과 → 밀린 틱은 몰아서 보내지 않음
+            _clock->sleep_until(next);
         }
+    }
 
-        size_t emg_pos = status_str.find("EMERGENCY");
-        if (emg_pos != std::string::npos) {
-            size_t val_pos = status_str.find("value:", emg_pos);
-            if (val_pos != std::string::npos && status_str.substr(val_pos + 6, 2) == "on") {
-                emergency_flag = true;
-            }
+    // ------- Precise stop (tick-driven deceleration) -------
+    // estop()/sleep()처럼 힘을 빼지 않고 멈춘다: 바퀴는 지금 속도에서 저크 제한 시간 최적 감속
+    // (바퀴 비율 유지 → yaw 튐 없음), 다리는 지금 자세 유지 또는 crouch 자세로 min-jerk 궤적.
+    // 매 틱 목표 송신 → 관측 → check_safety (한계 검사 그대로), 멈추면 마지막 목표(다리 자세,
+    // 바퀴 0)를 붙잡은 채 끝나고 watchdog 송신 감시는 다음 송신까지 쉰다.
+    // max_ms 안에 멈추지 못하면 estop → RobotEStopError
+    void begin_stop(const StopOptions& opt = {}) {
+        if (!_gains_set) throw RobotSetGainsError("precise_stop(): call set_gains() before precise_stop()");
+        if (!opt.crouch.empty()) {
+            if (opt.crouch.size() != kNumJoints)
+                throw std::invalid_argument("precise_stop: crouch needs one entry per joint (" +
+                                            std::to_string(kNumJoints) + ")");
+            for (size_t j = 0; j < kNumJoints; ++j)
+                if (!(opt.crouch[j] >= _limits.lo[j] && opt.crouch[j] <= _limits.hi[j]))
+                    throw std::invalid_argument("precise_stop: crouch pose outside the limits of " + _joint_names[j]);
         }
-        return {disconn_flag, emergency_flag};
+        if (!(opt.wheel_decel > 0.0f) || !(opt.wheel_jerk > 0.0f) || !(opt.leg_speed > 0.0f))
+            throw std::invalid_argument("precise_stop: wheel_decel, wheel_jerk and leg_speed must be > 0");
+        _wake.cancel();
+        _shaper.reset();
+
+        const Frame& obs = get_obs();   // 지금 상태에서 시작
+        std::array<float, Topo::kWheels> v0{};
+        for (size_t w = 0; w < Topo::kWheels; ++w) v0[w] = obs.dof_vel[Topo::kWheelMotor[w]];
+        const std::span<const float> q0(obs.dof_pos, kNumJoints);
+        _stop.begin(v0, q0, opt.crouch.empty() ? q0 : std::span<const float>(opt.crouch), _tick_ms, opt);
+        _wd_in_control.store(true, std::memory_order_release);   // 한계 감시 유지
     }
 
-    // MCU data sanity (native string)
-    bool _check_mcu_data(const std::string& mcu_str, const std::vector<uint8_t>& ids) {
-
-        if (mcu_str.find("OK <REQ>") == std::string::npos) {
-            _cli_missed_req += 1;
-            return false;
+    bool stopping() const { return _stop.active(); }
+    const StopStatus& stop_status() const { return _stop.status(); }
+
+    // 한 틱: 궤적 목표 송신 → 관측 → check_safety → 판정. get_obs()와 같은 내부 프레임을 반환
+    const Frame& stop_step() {
+        if (!_stop.active()) throw std::logic_error("stop_step(): call begin_stop() first");
+        std::array<float, Topo::kWheels> wv;
+        std::array<float, kNumJoints> lq;
+        _stop.targets(wv.data(), lq.data());
+        std::array<float, kNumMotors> act;
+        for (size_t j = 0; j < kNumJoints; ++j) act[Topo::kJointMotor[j]] = lq[j];
+        for (size_t w = 0; w < Topo::kWheels; ++w) act[Topo::kWheelMotor[w]] = wv[w];
+        _position_targets(act.data());
+        _send_targets(_tx_pos, _tx_vel, _tx_kp, _tx_kd, _tx_tau);
+
+        const Frame& obs = get_obs();
+        check_safety();
+        switch (_stop.observe({obs.dof_vel, Frame::kDofVel})) {
+        case StopPhase::Done:
+            _wd_action_ns.store(0, std::memory_order_release);   // 의도된 정지: 다음 송신까지 감시 해제
+            _wd_in_control.store(false, std::memory_order_release);
+            break;
+        case StopPhase::TimedOut:
+            estop("precise_stop(): not at rest after " + std::to_string(static_cast<int>(_stop.options().max_ms)) + " ms");
+        default:
+            break;
         }
+        return obs;
+    }
 
-        // 1.._last_action_len 까지 쓸 거라 +1
-        std::vector<std::size_t> motor_pos(_last_action_len + 1, 0);
-
-        // 한 번만 스캔해서 위치 캐싱
-        {
-            std::size_t cur = 0;
-            const std::size_t n = mcu_str.size();
-            while (cur < n) {
-                std::size_t mpos = mcu_str.find('M', cur);
-                if (mpos == std::string::npos) break;
-
-                std::size_t p = mpos + 1;
-                int num = 0;
-                bool has_digit = false;
-                while (p < n && mcu_str[p] >= '0' && mcu_str[p] <= '9') {
-                    has_digit = true;
-                    num = num * 10 + (mcu_str[p] - '0');
-                    ++p;
+    // 블로킹 precise_stop (ControlLoop를 돌리는 중이면 먼저 stop()): 전용 RT 스레드가 rate_hz의 절대 마감으로 stop_step을 돌린다.
+    // 마감을 max_missed번 연속 놓치면 estop (늦은 틱은 몰아서 보내지 않고 그 자리에서 다시 정렬).
+    // 제어 주기는 끝나면 원래대로 (끊김 타임아웃 / sim plant 시간이 rate_hz 기준으로 맞춰짐).
+    void precise_stop(const StopOptions& opt = {}) {
+        if (!(opt.rate_hz > 0.0)) throw std::invalid_argument("precise_stop: rate_hz must be greater than 0");
+        const double prev_ms = _tick_ms;
+        set_control_period(1000.0 / opt.rate_hz);
+        std::exception_ptr err;
+        try {
+            begin_stop(opt);
+            std::thread th([&] {
+                rt::setup_thread("precise_stop", opt.fifo_prio, opt.cpu, false);
+                try {
+                    const int64_t period = static_cast<int64_t>(1e9 / opt.rate_hz);
+                    int64_t next = _clock->now_ns();
+                    for (;;) {
+                        stop_step();
+                        if (!_stop.active()) return;
+                        next += period;
+                        const int64_t now = _clock->now_ns();
+                        if (_stop.deadline(now - next) >= opt.max_missed)
+                            estop("precise_stop(): missed " + std::to_string(opt.max_missed) +
+                                  " deadlines in a row (period " + std::to_string(1000.0 / opt.rate_hz) + " ms)");
+                        if (now > next) next = now;   // 늦음 → 바로 다음 틱
+                        _clock->sleep_until(next);
+                    }
+                } catch (...) {
+                    err = std::current_exception();
                 }
+            });
+            th.join();
+        } catch (...) {
+            err = std::current_exception();
+        }
+        set_control_period(prev_ms);
+        if (err) std::rethrow_exception(err);
+    }
 
-                // 기대하는 범위 안에 있을 때만 저장
-                if (has_digit && num >= 1 && num <= _last_action_len) {
-                    motor_pos[num] = mpos;
-                }
+private:
+    // action(shaper 출력) → 위치 제어 송신 버퍼
+    // Topo::kActJoint 매핑 (4W: 0..5 / 8..13 다리 관절 위치 제어, 6..7 / 14..15 바퀴 속도 제어)
+    void _position_targets(const float* a) {
+        unroll<kNumMotors>([&](auto g) {
+            constexpr int j = Topo::kActJoint[g];
+            if constexpr (j >= 0) { _tx_pos[g] = a[g] - _joint_offset[j]; _tx_vel[g] = 0.0f; }
+            else                  { _tx_pos[g] = 0.0f; _tx_vel[g] = a[g]; }   // 바퀴는 속도 제어
+            _tx_kp[g] = _kp[g];
+            _tx_kd[g] = _kd[g];
+            _tx_tau[g] = 0.0f;
+        });
+    }
 
-                cur = p;
-            }
+    // 목표값 송신 (gain table 캐시 / 프레임 형식은 백엔드 몫)
+    void _send_targets(std::span<const float> pos, std::span<const float> vel,
+                       std::span<const float> kp,  std::span<const float> kd,
+                       std::span<const float> tau) {
+        if (_watchdog && _watchdog->tripped())
+            estop(std::string("Watchdog: ") + _watchdog->trip().reason);
+        _backend->send(MotorTargets{pos, vel, kp, kd, tau});
+
+        const int64_t now = _clock->now_ns();
+        if (_wd_action_ns.exchange(now, std::memory_order_acq_rel) == 0) {
+            // 감시 시작: 관측 타임아웃은 지금부터 셈
+            int64_t ob = _wd_obs_ns.load(std::memory_order_relaxed);
+            while (ob < now && !_wd_obs_ns.compare_exchange_weak(ob, now)) {}
         }
+    }
 
-        // p, v, t 세 개만 도는 테이블
-        static constexpr const char* kKeys[] = { "p:", "v:", "t:" };
-
-        // 필요한 id만 검사
-        for (uint8_t id : ids) {
-            // 기대한 id가 근처에 아예 없으면 실패
-            if (id == 0 || id > _last_action_len) {
-                _cli_missed_req += 1;
-                return false;
+    // watchdog 스레드에서 호출: 잠금 없이 원자 변수 / _wd_obs 슬롯만 읽는다
+    bool _watchdog_check(const WatchdogOptions& opt, int64_t now, WatchdogTrip& tr) {
+        const int64_t act = _wd_action_ns.load(std::memory_order_acquire);
+        if (act == 0) return false;   // 송신 전 또는 estop 뒤
+        if (opt.action_timeout_ms > 0.0) {
+            const int64_t dl = act + static_cast<int64_t>(opt.action_timeout_ms * 1e6);
+            if (now > dl) {
+                std::snprintf(tr.reason, sizeof(tr.reason), "no action for %.1f ms (timeout %.1f ms)",
+                              (now - act) / 1e6, opt.action_timeout_ms);
+                tr.deadline_ns = dl;
+                return true;
             }
-
-            std::size_t mid_pos = motor_pos[id];
-            if (mid_pos == 0) {
-                _cli_missed_req += 1;
-                return false;
+        }
+        if (opt.obs_timeout_ms > 0.0) {
+            const int64_t ob = _wd_obs_ns.load(std::memory_order_acquire);
+            const int64_t dl = ob + static_cast<int64_t>(opt.obs_timeout_ms * 1e6);
+            if (now > dl) {
+                std::snprintf(tr.reason, sizeof(tr.reason), "no fresh observation for %.1f ms (timeout %.1f ms)",
+                              (now - ob) / 1e6, opt.obs_timeout_ms);
+                tr.deadline_ns = dl;
+                return true;
             }
-
-            // 여기만 inner loop로 정리
-            for (const char* key : kKeys) {
-                std::size_t pos = mcu_str.find(key, mid_pos);
-                if (pos == std::string::npos) {
-                    _cli_missed_req += 1;
-                    return false;
-                }
-                // "p:" / "v:" / "t:" 다 2글자라 +2 고정
-                std::size_t val_pos = pos + 2;
-                if (val_pos < mcu_str.size() && mcu_str[val_pos] == 'N') {
-                    _cli_missed_req += 1;
-                    return false;
+        }
+        if (opt.check_limits && _wd_in_control.load(std::memory_order_acquire)) {
+            const uint64_t v = _wd_obs.version();
+            if (v != _wd_seen) {   // 새 관측만 검사
+                _wd_seen = v;
+                const Frame obs = _wd_obs.load();
+                if (_obs_violation(obs, tr.reason, sizeof(tr.reason))) {
+                    tr.deadline_ns = obs.stamp_ns;
+                    return true;
                 }
             }
         }
-
-        return true;
+        return false;
     }
 
-    // Parse obs (in-place into pre-sized vectors, native string parsing)
-    std::unordered_map<std::string, std::vector<float>>&
-    _parse_obs(const std::string& mcu_front, const std::string& mcu_rear) {
-        // 1) 패킷 유효성 먼저
-        if (!_check_mcu_data(mcu_front, _motor_ids_front)) {
-            return _obs;
-        }
-        if (!_check_mcu_data(mcu_rear, _motor_ids_rear)) {
-            return _obs;
+    // 모든 보드가 ESTOP ACK 할 때까지 반복 (ACK 못 받은 보드만 재송신)
+    void _estop_all_boards() {
+        _wd_action_ns.store(0, std::memory_order_release);   // 의도된 정지: 다음 송신까지 감시 해제
+        _wd_in_control.store(false, std::memory_order_release);
+        _wake.cancel();
+        _stop.cancel();
+        const int64_t retry = 10000000;   // 10 ms
+        _cmd_sel.assign(_motor_ids.size(), 1);
+        for (;;) {
+            _backend->motor_cmd("ESTOP", _cmd_sel, _cmd_ok);
+            bool pending = false;
+            for (size_t k = 0; k < _cmd_sel.size(); ++k) {
+                if (_cmd_ok[k]) _cmd_sel[k] = 0;
+                pending |= _cmd_sel[k] != 0;
+            }
+            if (!pending) break;
+            _clock->sleep_for(retry);
         }
+    }
 
-        // 2) 이 시점에서 "이번 패킷" 안에서는 M 들의 위치가 항상 같다고 가정하니까
-        //    멤버 배열이 비어 있으면 그때 한 번만 채운다.
-        //    (index 0은 안 쓰니까 1이나 9가 0인지로 판별)
-        if (_front_motor_pos[1] == 0) {
-            std::size_t cur = 0;
-            const std::size_t n = mcu_front.size();
-            while (cur < n) {
-                std::size_t mpos = mcu_front.find('M', cur);
-                if (mpos == std::string::npos) break;
-
-                std::size_t p = mpos + 1;
-                int num = 0;
-                bool has_digit = false;
-                while (p < n && mcu_front[p] >= '0' && mcu_front[p] <= '9') {
-                    has_digit = true;
-                    num = num * 10 + (mcu_front[p] - '0');
-                    ++p;
-                }
-                if (has_digit && num >= 1 && num <= 8) {
-                    _front_motor_pos[num] = mpos;
-                }
-                cur = p;
+    // HW 준비 대기
+    void _wait(std::int32_t timeout_ms = 30000) { // [FIX] 모든 보드가 준비될 때까지 대기
+        const int64_t deadline = _clock->now_ns() + timeout_ms * 1000000LL;
+        const int64_t retry_sleep = 100000000;   // 100 ms
+        const int64_t safe_margin = 100000000;
+
+        while (_clock->now_ns() < deadline) {
+            _cmd_sel.assign(_motor_ids.size(), 1);
+            if (_backend->motor_cmd("START", _cmd_sel, _cmd_ok) != _motor_ids.size()) {
+                _clock->sleep_for(retry_sleep);
+                continue;
             }
-        }
-        if (_rear_motor_pos[9] == 0) {
-            std::size_t cur = 0;
-            const std::size_t n = mcu_rear.size();
-            while (cur < n) {
-                std::size_t mpos = mcu_rear.find('M', cur);
-                if (mpos == std::string::npos) break;
-
-                std::size_t p = mpos + 1;
-                int num = 0;
-                bool has_digit = false;
-                while (p < n && mcu_rear[p] >= '0' && mcu_rear[p] <= '9') {
-                    has_digit = true;
-                    num = num * 10 + (mcu_rear[p] - '0');
-                    ++p;
-                }
-                if (has_digit && num >= 9 && num <= 16) {
-                    _rear_motor_pos[num] = mpos;
-                }
-                cur = p;
+
+            _backend->status(_motor_health.data(), _board_health.data());
+            bool bad = false;
+            for (size_t k = 0; k < _motor_ids.size(); ++k) {
+                auto [dis, emg] = _check_status(k);
+                bad |= dis || emg;
+            }
+            if (bad) {
+                _clock->sleep_for(retry_sleep);
+                continue;
             }
-        }
 
-        // 3) 이제부터는 멤버에 들어있는 위치만 써서 값 뽑는다
-        auto& dof_pos   = _obs["dof_pos"]; // 12
-        auto& dof_vel   = _obs["dof_vel"]; // 16
-        auto& ang_vel   = _obs["ang_vel"];
-        auto& proj_grav = _obs["proj_grav"];
-
-        // ---- 위치 ----
-        // front: M1..M6 -> dof_pos[0..5]
-        for (int i = 0; i < 6; ++i) {
-            int mid = i + 1; // 1..6
-            std::size_t base = _front_motor_pos[mid];
-            // 여기서는 위치가 있다고 가정했으니까 바로 find
-            std::size_t ppos = mcu_front.find("p:", base);
-            float val = std::stof(mcu_front.substr(ppos + 2));
-            dof_pos[i] = val + _pos_offset[_joint_names[i]];
+            _clock->sleep_for(safe_margin);
+            return;
         }
+        throw RobotEStopError("Motor start timeout");
+    }
 
-        // rear: M9..M14 -> dof_pos[6..11]
-        for (int j = 0; j < 6; ++j) {
-            int mid = 9 + j; // 9..14
-            std::size_t base = _rear_motor_pos[mid];
-            std::size_t ppos = mcu_rear.find("p:", base);
-            float val = std::stof(mcu_rear.substr(ppos + 2));
-            dof_pos[6 + j] = val + _pos_offset[_joint_names[6 + j]];
-        }
+    // Status check: 보드 k의 _motor_health / _board_health[k] (backend->status() 이후)
+    // @return {disconnect, emergency}
+    std::pair<bool,bool> _check_status(size_t k) const {
+        const MotorHealth* m = _motor_health.data() + _motor_offset[k];
+        const BoardHealth& b = _board_health[k];
+        bool disconn_flag = !b.valid;
+        for (size_t i = 0, n = _motor_ids[k].size(); i < n && !disconn_flag; ++i)
+            disconn_flag = !m[i].connected();
+        return {disconn_flag, b.emergency != 0};
+    }
 
-        // ---- 속도 ----
-        // front: M1..M8 -> dof_vel[0..7]
-        for (int i = 0; i < 8; ++i) {
-            int mid = i + 1; // 1..8
-            std::size_t base = _front_motor_pos[mid];
-            std::size_t vpos = mcu_front.find("v:", base);
-            float val = std::stof(mcu_front.substr(vpos + 2));
-            dof_vel[i] = val;
+    // Read obs (백엔드가 action 순서 모터 상태를 채움, 할당 없음)
+    // action 인덱스 g(보드 순서대로 이어 붙인 모터 순서) 기준 매핑:
+    //  - 다리 관절 : dof_pos[Topo::kActJoint[g]] (4W: g < 8 ? g : g - 2)
+    //  - 모든 모터 : dof_vel[g]
+    void _read_obs() {
+        // 모든 보드가 유효할 때만 반영 → 하나라도 실패하면 이전 관측 유지
+        bool has_imu = false;
+        if (!_backend->req(_req_motors.data(), _req_imu, has_imu, _req_stamps.data())) {
+            _cli_missed_req += 1;
+            _frame.fresh = 0;
+            _frame.imu_fresh = 0;
+            return;
         }
-
-        // rear: M9..M16 -> dof_vel[8..15]
-        for (int j = 0; j < 8; ++j) {
-            int mid = 9 + j; // 9..16
-            std::size_t base = _rear_motor_pos[mid];
-            std::size_t vpos = mcu_rear.find("v:", base);
-            float val = std::stof(mcu_rear.substr(vpos + 2));
-            dof_vel[8 + j] = val;
+        _frame.fresh = 1;
+        _frame.imu_fresh = 0;
+        _cli_missed_req = 0;   // 연속 누락만 disconnect 판정에 반영
+
+        float* dof_pos   = _frame.dof_pos; // Topo::kJoints
+        float* dof_vel   = _frame.dof_vel; // Topo::kMotors
+        float* ang_vel   = _frame.ang_vel;
+        float* proj_grav = _frame.proj_grav;
+
+        // ---- 위치 / 속도 ----
+        unroll<kNumMotors>([&](auto g) {
+            constexpr int j = Topo::kActJoint[g];
+            if constexpr (j >= 0) dof_pos[j] = _req_motors[g].p + _joint_offset[j];
+            dof_vel[g] = _req_motors[g].v;
+        });
+
+        // ---- IMU (IMU 블록을 보내는 마지막 보드; 기본 구성에선 뒤 보드) ----
+        if (has_imu) {
+            const ReqImu& u = _req_imu;
+            ang_vel[0] = u.gx;   ang_vel[1] = u.gy;   ang_vel[2] = u.gz;
+            proj_grav[0] = u.pgx; proj_grav[1] = u.pgy; proj_grav[2] = u.pgz;
+            _frame.imu_fresh = 1;
         }
+    }
 
-        // ---- IMU (rear) ----
-        {
-            std::size_t imu_pos = mcu_rear.rfind("IMU");
-            if (imu_pos != std::string::npos) {
-                std::size_t gx_pos = mcu_rear.find("gx:", imu_pos);
-                if (gx_pos != std::string::npos) ang_vel[0] = std::stof(mcu_rear.substr(gx_pos + 3));
-                std::size_t gy_pos = mcu_rear.find("gy:", imu_pos);
-                if (gy_pos != std::string::npos) ang_vel[1] = std::stof(mcu_rear.substr(gy_pos + 3));
-                std::size_t gz_pos = mcu_rear.find("gz:", imu_pos);
-                if (gz_pos != std::string::npos) ang_vel[2] = std::stof(mcu_rear.substr(gz_pos + 3));
-
-                std::size_t pgx_pos = mcu_rear.find("pgx:", imu_pos);
-                if (pgx_pos != std::string::npos) proj_grav[0] = std::stof(mcu_rear.substr(pgx_pos + 4));
-                std::size_t pgy_pos = mcu_rear.find("pgy:", imu_pos);
-                if (pgy_pos != std::string::npos) proj_grav[1] = std::stof(mcu_rear.substr(pgy_pos + 4));
-                std::size_t pgz_pos = mcu_rear.find("pgz:", imu_pos);
-                if (pgz_pos != std::string::npos) proj_grav[2] = std::stof(mcu_rear.substr(pgz_pos + 4));
+    // 관측 시각: fresh면 보드별 수신 시각(없으면 now)의 최솟값/범위와 SEQ_NUM을 새로 반영.
+    // stale이면 이전 수신 시각을 그대로 두어 age가 계속 커진다
+    void _stamp_obs(int64_t now) {
+        _frame.stamp_ns = now;
+        if (_frame.fresh) {
+            int64_t lo = now, hi = 0;
+            for (size_t k = 0; k < _req_stamps.size(); ++k) {
+                const int64_t rx = _req_stamps[k].rx_ns ? _req_stamps[k].rx_ns : now;
+                lo = std::min(lo, rx);
+                hi = std::max(hi, rx);
+                if (k < Frame::kMaxBoards) _frame.mcu_seq[k] = _req_stamps[k].seq;
             }
+            _frame.rx_ns = lo;
+            _frame.skew_ns = hi - lo;
+            _frame.stale_ticks = 0;
+        } else {
+            ++_frame.stale_ticks;
         }
+        _frame.age_ns = _frame.rx_ns ? now - _frame.rx_ns : 0;
+        _frame.obs_delay[0] = static_cast<float>(_frame.age_ns * 1e-9);
+        _frame.obs_delay[1] = static_cast<float>(_frame.skew_ns * 1e-9);
+    }
+
+    // 관절 이름 기반 설정 → offset / 한계 표 (문자열 조회는 생성 시 1회).
+    // action ↔ 관절 인덱스 표는 Topo의 constexpr 표를 그대로 쓴다
+    void _build_index_tables() {
+        std::array<float, kNumJoints> lo{}, hi{};
+        for (size_t j = 0; j < kNumJoints; ++j) {
+            const std::string& name = _joint_names[j];
+            _joint_offset[j] = _pos_offset.at(name);
+            lo[j]            = _rel_min_pos.at(name);
+            hi[j]            = _rel_max_pos.at(name);
+        }
+        _limits.set(lo.data(), hi.data(), kPosMargin, kVelMargin, kVelLimit);
+    }
 
-        return _obs;
+    // 보드 k의 바퀴 action 인덱스 ("indices 6 and 7"), set_gains 오류 메시지용
+    static std::string _wheel_list(size_t k) {
+        std::string s = Topo::kWheelsPerBoard == 1 ? "index " : "indices ";
+        for (size_t w = 0; w < Topo::kWheelsPerBoard; ++w) {
+            if (w) s += w + 1 == Topo::kWheelsPerBoard ? " and " : ", ";
+            s += std::to_string(Topo::kWheelMotor[k * Topo::kWheelsPerBoard + w]);
+        }
+        return s;
     }
 
     // ------- Obs safety -------
-    void _check_obs(const std::unordered_map<std::string, std::vector<float>>& obs) const {
-        const auto& q_obs = obs.at("dof_pos"); // 12
-        const auto& q_vel = obs.at("dof_vel"); // 16
-
-        const float pos_margin = 0.1745f; // 10 deg
-        const float vel_margin = 0.3491f; // 20 deg
-        const float vel_th = 8.7275f; // rad/s
-
-        for (size_t i=0;i<_joint_names.size();++i) {
-            const std::string& name = _joint_names[i];
-            float pos = q_obs.at(i);
-
-            // [FIX] 속도 인덱스 매핑 (앞 0..5 -> 0..5, 뒤 6..11 -> 8..13)
-            size_t v_idx = (i < 6) ? i : (i + 2);
-            float vel = q_vel.at(v_idx);
-
-            float lo_pos = _rel_min_pos.at(name) + pos_margin;
-            float hi_pos = _rel_max_pos.at(name) - pos_margin;
-
-            if (pos < lo_pos || pos > hi_pos) {
-                char buf[256];
-                std::snprintf(buf, sizeof(buf),
-                    "E-stop: position limit exceeded on %s (pos=%.3f rad, allowed [%.3f, %.3f])",
-                    name.c_str(), pos, lo_pos, hi_pos);
-                throw RobotEStopError(buf);
-            }
-            if (pos < lo_pos + vel_margin && vel < -vel_th) {
-                char buf[256];
-                std::snprintf(buf, sizeof(buf),
-                    "E-stop: excessive negative velocity near lower limit on %s (pos=%.3f rad, vel=%.3f rad/s)",
-                    name.c_str(), pos, vel);
-                throw RobotEStopError(buf);
-            }
-            if (pos >= hi_pos - vel_margin && vel > vel_th) {
-                char buf[256];
-                std::snprintf(buf, sizeof(buf),
-                    "E-stop: excessive positive velocity near upper limit on %s (pos=%.3f rad, vel=%.3f rad/s)",
-                    name.c_str(), pos, vel);
-                throw RobotEStopError(buf);
-            }
+    void _check_obs(const Frame& obs) const {
+        char buf[256];
+        if (_obs_violation(obs, buf, sizeof(buf))) throw RobotEStopError(buf);
+    }
+
+    // 위치/속도 한계 검사. 위반이면 buf에 메시지를 쓰고 true (watchdog 스레드에서도 호출: 할당/예외 없음)
+    // 전 관절을 SIMD 비교 한 번으로 검사하고, 메시지는 위반일 때만 만든다
+    bool _obs_violation(const Frame& obs, char* buf, size_t n) const {
+        alignas(16) float q[Limits::kPadded] = {};
+        alignas(16) float dq[Limits::kPadded] = {};
+        std::copy_n(obs.dof_pos, kNumJoints, q);
+        unroll<kNumJoints>([&](auto j) { dq[j] = obs.dof_vel[Topo::kJointMotor[j]]; });   // 관절 → 모터(속도) 인덱스
+
+        const uint64_t m = _limits.check(q, dq);
+        if (m == 0) [[likely]] return false;
+
+        // 기존 순서 유지: 앞 관절부터, 관절 안에서는 위치 → 하한 쪽 속도 → 상한 쪽 속도
+        const uint64_t m_pos = m & Limits::kPosMask;
+        const uint64_t m_lo  = (m >> Limits::kVelLoShift) & Limits::kPosMask;
+        const uint64_t m_hi  = (m >> Limits::kVelHiShift) & Limits::kPosMask;
+        const int i = std::countr_zero(m_pos | m_lo | m_hi);
+        const char* name = _joint_names[i].c_str();
+        const float pos = q[i], vel = dq[i];
+        if (m_pos >> i & 1) {
+            std::snprintf(buf, n,
+                "E-stop: position limit exceeded on %s (pos=%.3f rad, allowed [%.3f, %.3f])",
+                name, pos, _limits.lo[i], _limits.hi[i]);
+        } else if (m_lo >> i & 1) {
+            std::snprintf(buf, n,
+                "E-stop: excessive negative velocity near lower limit on %s (pos=%.3f rad, vel=%.3f rad/s)",
+                name, pos, vel);
+        } else {
+            std::snprintf(buf, n,
+                "E-stop: excessive positive velocity near upper limit on %s (pos=%.3f rad, vel=%.3f rad/s)",
+                name, pos, vel);
         }
+        return true;
     }
 
 private:
-    // config / ids
+    // config
+    static constexpr size_t kNumMotors = Topo::kMotors;   // action 길이 (다리 관절 + 바퀴)
+    static constexpr size_t kNumJoints = Topo::kJoints;   // 위치 제어 관절
+    static constexpr float kPosMargin = 0.1745f;    // 10 deg: 관절 범위 안쪽 여유
+    static constexpr float kVelMargin = 0.3491f;    // 20 deg: 한계 근처 과속 감시 구간
+    static constexpr float kVelLimit  = 8.7275f;    // rad/s
+    using Limits = JointLimits<kNumJoints>;
+    static_assert(Topo::kJointNames.size() == kNumJoints, "one joint name per dof_pos entry");
+    // wake 램프 시작 gain (바퀴 kp 0)
+    static constexpr std::array<float, kNumMotors> kWakeKp = Topo::per_motor(5.0f, 0.0f);
+    static constexpr std::array<float, kNumMotors> kWakeKd = Topo::per_motor(0.15f, 0.25f);
     const size_t _last_action_len;
-    std::vector<uint8_t> _motor_ids_front;
-    std::vector<uint8_t> _motor_ids_rear;
+
+    // boards (백엔드 / 보드별 모터 id / action 시작 인덱스)
+    std::unique_ptr<RobotBackend> _backend;
+    std::shared_ptr<rt::Clock> _clock;
+    std::vector<std::vector<uint8_t>> _motor_ids;
+    std::vector<size_t> _motor_offset;
+
+    std::mutex _call_mtx;   // call_mutex()
 
     // conn state
     int _cli_disconn_timeout_ms;
-    int _cli_disconn_duration_ms;
+    double _cli_disconn_duration_ms;
     int _cli_missed_req;
+    double _tick_ms;        // set_control_period()
+
+    // watchdog 공유 상태 (제어 스레드가 쓰고 watchdog 스레드가 읽음)
+    std::atomic<int64_t> _wd_action_ns{0};   // 마지막 MIT 송신 (0: 감시 안 함)
+    std::atomic<int64_t> _wd_obs_ns{0};      // 마지막 fresh 관측
+    std::atomic<bool> _wd_in_control{false}; // do_action 중 (한계 감시 대상)
+    SeqSlot<Frame> _wd_obs;               // 최신 관측
+    uint64_t _wd_seen = 0;                   // watchdog 스레드 전용: 검사한 _wd_obs 버전
 
     // state (pre-sized & reused)
-    std::unordered_map<std::string, std::vector<float>> _obs;
+    Frame _frame;
+    History _history;                        // obs_history()
     std::unordered_map<std::string, float> _pos_offset;
     std::unordered_map<std::string, float> _rel_max_pos, _rel_min_pos;
     std::vector<std::string> _joint_names;
 
-    // 효율적 파싱을 위한 모터 위치 캐싱
-    std::array<std::size_t, 9> _front_motor_pos{}; // M1..M8의 시작 위치
-    std::array<std::size_t, 17> _rear_motor_pos{}; // M9..M16의 시작 위치
+    // 인덱스 테이블 (_build_index_tables)
+    std::array<float, kNumJoints> _joint_offset{};   // 관절 인덱스 → 위치 offset
+    Limits _limits;                                   // _check_obs 한계 (margin 반영, SIMD 검사)
+    WakeRamp _wake;                                   // begin_wake / wake_step 상태
+    StopTrajectory _stop;                             // begin_stop / stop_step 상태
+
+    // 송신 scratch (do_action / _send_targets, 재사용)
+    std::array<float, kNumMotors> _tx_pos{}, _tx_vel{}, _tx_kp{}, _tx_kd{}, _tx_tau{};
+    std::vector<char> _cmd_sel, _cmd_ok;   // START / ESTOP 대상 보드와 ACK
+
+    // 마지막 STATUS (모터: action 순서, 보드 k는 _motor_offset[k]부터)
+    std::vector<MotorHealth> _motor_health;
+    std::vector<BoardHealth> _board_health;
+
+    // REQ scratch (action 순서, 모든 보드가 유효할 때만 _frame에 반영)
+    std::vector<ReqMotorState> _req_motors;
+    ReqImu _req_imu;
+    std::vector<BoardStamp> _req_stamps;   // 보드별 수신 시각 / SEQ_NUM
+    int64_t _obs_to_action_ns = 0;         // obs_to_action_ns()
+    LinVelEstimator _lin_vel;              // set_lin_vel_estimator()
+    bool _lin_vel_on = false;
+    Shaper _shaper;                        // set_action_shaper()
+    bool _shaper_on = false;
+
+    // do_torque (임피던스 법칙 입력 / 출력, action 순서, SIMD 패딩)
+    using Impedance = ImpedanceLaw<Topo::kMotors>;
+    Impedance _impedance;                  // set_impedance()
+    bool _impedance_set = false;
+    TorqueLaw _torque_law;                 // set_torque_law() (비었으면 임피던스)
+    alignas(16) float _tq_ref[Impedance::kPadded] = {}, _tq_q[Impedance::kPadded] = {};
+    alignas(16) float _tq_dref[Impedance::kPadded] = {}, _tq_dq[Impedance::kPadded] = {};
+    alignas(16) float _tq_tau[Impedance::kPadded] = {};
 
     // gains
     std::vector<float> _kp;
     std::vector<float> _kd;
     bool _gains_set;
 
-    // Native FxCli handle
-    FxCli _cli_front;
-    FxCli _cli_rear;
+    // 마지막에 선언: 먼저 소멸(= watchdog 스레드 join)된 뒤 백엔드가 정리된다
+    std::unique_ptr<Watchdog> _watchdog;
 };
 
+using Robot = BasicRobot<DefaultTopology>;
+
 } // namespace robot
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "req_parser.hpp"     // ReqMotorState, ReqImu
+#include "status_parser.hpp"  // MotorHealth, BoardHealth
+
+namespace robot {
+
+/// @brief One tick of MIT targets for every motor, in action order.
+///        Motor torque = kp * (pos - q) + kd * (vel - dq) + tau.
+struct MotorTargets {
+    std::span<const float> pos, vel, kp, kd, tau;
+};
+
+/// @brief Receive time and MCU sequence number of one board's REQ reply.
+struct BoardStamp {
+    int64_t  rx_ns = 0;   ///< CLOCK_MONOTONIC ns at receipt (0: no RX time; Robot uses its clock)
+    uint64_t seq = 0;     ///< SEQ_NUM cnt (0: not reported)
+};
+
+/**
+ * @brief What Robot talks to underneath: boards, a simulated plant, or a recording.
+ *
+ * Robot keeps the policy-facing logic (index tables, offsets, limits, safety,
+ * watchdog, wake ramp) and hands every exchange with the motors to a backend.
+ * All arrays are in action order: the boards' motor IDs concatenated in board
+ * order (see boards()).
+ *
+ * Threading: Robot serializes every call except estop_nowait(), which the
+ * watchdog thread may call at any time and must therefore not block on
+ * anything the control path holds.
+ */
+class RobotBackend {
+public:
+    virtual ~RobotBackend() = default;
+
+    /// @brief Short name for logs ("udp", "sim", "replay").
+    virtual const char* name() const = 0;
+
+    /// @brief Motor IDs per board; their concatenation is the action order.
+    virtual const std::vector<std::vector<uint8_t>>& boards() const = 0;
+
+    /**
+     * @brief Non-RT motor command ("START" / "ESTOP") on the boards with sel[k] != 0.
+     * @param ok resized to boards().size(); ok[k] = board k acknowledged
+     * @return number of selected boards that acknowledged
+     */
+    virtual size_t motor_cmd(const char* tag, const std::vector<char>& sel, std::vector<char>& ok) = 0;
+
+    /// @brief Fire-and-forget ESTOP on every board (watchdog thread; must not block).
+    virtual void estop_nowait() = 0;
+
+    /**
+     * @brief Query board health.
+     * @param motors one entry per motor (action order)
+     * @param boards one entry per board
+     */
+    virtual void status(MotorHealth* motors, BoardHealth* boards) = 0;
+
+    /**
+     * @brief Read one observation.
+     * @param motors  one entry per motor (action order)
+     * @param imu     filled when has_imu is set
+     * @param stamps  one entry per board
+     * @return false if any board's reply was missing or invalid (motors/imu/stamps then undefined)
+     */
+    virtual bool req(ReqMotorState* motors, ReqImu& imu, bool& has_imu, BoardStamp* stamps) = 0;
+
+    /// @brief Send one tick of targets (all motors).
+    virtual void send(const MotorTargets& t) = 0;
+
+    /// @brief Robot::set_gains() / wake() changed the gains (a backend that gave up caching them may probe again).
+    virtual void gains_changed() {}
+
+    /// @brief Robot::set_control_period(); lockstep backends advance their clock by it.
+    virtual void set_control_period(double /*period_ms*/) {}
+
+    /// @brief REQ retransmit budget (UDP only).
+    virtual void set_req_retry(double /*control_period_ms*/, double /*slice*/) {}
+
+    /// @brief False if exchanges wait on real I/O, so a virtual clock cannot pace them.
+    virtual bool virtual_time_ok() const { return true; }
+
+    /// @brief Frames dropped by the transport (CRC mismatch, truncation).
+    virtual uint64_t rx_bad_frames() { return 0; }
+};
+
+} // namespace robot
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "rt_thread.hpp"
+
+namespace rt {
+
+/**
+ * @brief Time source for Robot, ControlLoop and the wake / start-up waits.
+ *
+ * SystemClock is CLOCK_MONOTONIC with clock_nanosleep (the default).
+ * VirtualClock never blocks: sleeping jumps its time forward to the deadline,
+ * so a lockstep pipeline on a simulated or replayed backend runs as fast as
+ * the CPU allows while every timestamp, timeout and ramp still sees the
+ * nominal 50 Hz timeline. Runs are reproducible tick for tick.
+ */
+class Clock {
+public:
+    virtual ~Clock() = default;
+
+    virtual int64_t now_ns() const = 0;
+
+    /// @brief Block (or, for a virtual clock, jump) until @p t_ns; @p spin_ns as rt::sleep_until.
+    virtual void sleep_until(int64_t t_ns, int64_t spin_ns = 0) = 0;
+
+    void sleep_for(int64_t dt_ns) { sleep_until(now_ns() + dt_ns, 0); }
+
+    virtual bool is_virtual() const { return false; }
+};
+
+class SystemClock final : public Clock {
+public:
+    int64_t now_ns() const override { return rt::now_ns(); }
+    void sleep_until(int64_t t_ns, int64_t spin_ns = 0) override { rt::sleep_until(t_ns, spin_ns); }
+};
+
+/**
+ * @brief Simulated time: sleep_until() advances it to the deadline and returns at once.
+ *
+ * Meant for one driving thread (lockstep loop, wake(), start-up). Time never
+ * goes backwards: sleeping to a past deadline is a no-op.
+ */
+class VirtualClock final : public Clock {
+public:
+    explicit VirtualClock(int64_t start_ns = 0) : _t(start_ns) {}
+
+    int64_t now_ns() const override { return _t.load(std::memory_order_acquire); }
+
+    void sleep_until(int64_t t_ns, int64_t /*spin_ns*/ = 0) override {
+        int64_t cur = _t.load(std::memory_order_relaxed);
+        while (cur < t_ns && !_t.compare_exchange_weak(cur, t_ns, std::memory_order_acq_rel)) {}
+    }
+
+    void advance(int64_t dt_ns) { _t.fetch_add(dt_ns, std::memory_order_acq_rel); }
+
+    bool is_virtual() const override { return true; }
+
+private:
+    std::atomic<int64_t> _t;
+};
+
+/// @brief Process-wide SystemClock shared by everything that was not given a clock.
+inline std::shared_ptr<Clock> system_clock() {
+    static const std::shared_ptr<Clock> c = std::make_shared<SystemClock>();
+    return c;
+}
+
+} // namespace rt
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+/**
+ * @brief Real-time thread helpers shared by ControlLoop and Watchdog.
+ *
+ * Failures (no CAP_SYS_NICE, bad CPU index, RLIMIT_MEMLOCK) are reported on
+ * stderr and the thread keeps running with the default policy.
+ */
+namespace rt {
+
+/// @brief CLOCK_MONOTONIC in ns.
+inline int64_t now_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+/// @brief Sleep until absolute CLOCK_MONOTONIC time @p t_ns: clock_nanosleep(TIMER_ABSTIME)
+///        up to t - @p spin_ns, then busy-spin the rest.
+inline void sleep_until(int64_t t_ns, int64_t spin_ns) {
+    const int64_t wake = t_ns - spin_ns;
+    if (wake > now_ns()) {
+        timespec ts{ static_cast<time_t>(wake / 1000000000LL), static_cast<long>(wake % 1000000000LL) };
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+    }
+    while (now_ns() < t_ns) {}
+}
+
+/// @brief Apply SCHED_FIFO @p fifo_prio (0: keep), pin to @p cpu (-1: no pinning),
+///        optionally mlockall. @p who prefixes the warnings.
+inline void setup_thread(const char* who, int fifo_prio, int cpu, bool lock_memory) {
+    if (fifo_prio > 0) {
+        sched_param sp{}; sp.sched_priority = fifo_prio;
+        int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+        if (rc != 0) std::fprintf(stderr, "[%s] SCHED_FIFO unavailable (%s); using default policy\n", who, std::strerror(rc));
+    }
+    if (cpu >= 0) {
+        cpu_set_t cs; CPU_ZERO(&cs); CPU_SET(cpu, &cs);
+        int rc = pthread_setaffinity_np(pthread_self(), sizeof(cs), &cs);
+        if (rc != 0) std::fprintf(stderr, "[%s] pthread_setaffinity_np: %s\n", who, std::strerror(rc));
+    }
+    if (lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        std::fprintf(stderr, "[%s] mlockall: %s\n", who, std::strerror(errno));
+    }
+}
+
+} // namespace rt
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @brief Fixed-capacity single-writer history of trivially copyable values.
+ *
+ * The writer push()es one value per call and never blocks. Every slot carries
+ * its own sequence word (a per-slot seqlock), so readers on any number of
+ * threads copy value i with read(i) in a bounded number of steps: the copy is
+ * checked against the slot's sequence word and reported as missing if value i
+ * was not written yet, is being written or has been overwritten (wait-free,
+ * no retry loop).
+ *
+ * Values are stored twice (slot i % N and i % N + N), so the newest n <= N
+ * values are always one contiguous run: window() hands it out without copying
+ * (NumPy view). A window is not seq-checked; the values in it stay intact as
+ * long as intact(first) holds, i.e. until N - n more push()es.
+ *
+ * Exactly one thread may call push() at a time.
+ */
+template <class T, size_t N>
+class SeqRing {
+  static_assert(std::is_trivially_copyable<T>::value, "SeqRing needs a trivially copyable T");
+  static_assert(N > 0 && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+public:
+  static constexpr size_t kCapacity = N;
+
+  SeqRing() : buf_(new T[2 * N]), seq_(new std::atomic<uint64_t>[N]) {
+    std::memset(static_cast<void*>(buf_.get()), 0, 2 * N * sizeof(T));
+    for (size_t s = 0; s < N; ++s) seq_[s].store(0, std::memory_order_relaxed);
+  }
+
+  void push(const T& v) noexcept {
+    const uint64_t i = count_.load(std::memory_order_relaxed);
+    const size_t s = i & (N - 1);
+    seq_[s].store(2 * i + 1, std::memory_order_relaxed);   // 홀수: i를 쓰는 중
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(static_cast<void*>(&buf_[s]), &v, sizeof(T));
+    std::memcpy(static_cast<void*>(&buf_[s + N]), &v, sizeof(T));
+    seq_[s].store(2 * i + 2, std::memory_order_release);
+    count_.store(i + 1, std::memory_order_release);
+  }
+
+  /// @brief Number of completed push() calls; value i (0-based) was the (i+1)-th push.
+  uint64_t count() const noexcept { return count_.load(std::memory_order_acquire); }
+
+  /// @brief Copy value @p i into @p out. false: not written yet / being written / overwritten.
+  bool read(uint64_t i, T& out) const noexcept {
+    const std::atomic<uint64_t>& sq = seq_[i & (N - 1)];
+    const uint64_t s1 = sq.load(std::memory_order_acquire);
+    if (s1 != 2 * i + 2) return false;
+    std::memcpy(static_cast<void*>(&out), &buf_[i & (N - 1)], sizeof(T));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return sq.load(std::memory_order_relaxed) == s1;
+  }
+
+  /**
+   * @brief Copy the newest values, oldest first.
+   * @param out  room for @p n values
+   * @return number copied into out[0..k): the newest consistent run (< n if
+   *         fewer were pushed, or the oldest were overwritten while copying)
+   */
+  size_t read_latest(T* out, size_t n) const noexcept {
+    const uint64_t c = count();
+    if (n > N) n = N;
+    if (n > c) n = static_cast<size_t>(c);
+    size_t k = 0;
+    for (size_t j = n; j-- > 0;) {   // 최신부터: 덮어쓰인 쪽(오래된 쪽)에서 멈춤
+      if (!read(c - 1 - (n - 1 - j), out[j])) break;
+      ++k;
+    }
+    if (k < n) std::memmove(static_cast<void*>(out), out + (n - k), k * sizeof(T));
+    return k;
+  }
+
+  /**
+   * @brief Contiguous run of the newest @p n values (oldest first), no copy.
+   * @param first set to the index of window()[0]
+   * @return nullptr if fewer than n were pushed or n > N
+   */
+  const T* window(size_t n, uint64_t* first = nullptr) const noexcept {
+    const uint64_t c = count();
+    if (n == 0 || n > N || n > c) return nullptr;
+    if (first) *first = c - n;
+    return &buf_[(c - n) & (N - 1)];
+  }
+
+  /// @brief True while value @p first (and everything after it) is not overwritten.
+  bool intact(uint64_t first) const noexcept {
+    // push() of value c (= count()) overwrites value c - N
+    return count() < first + N;
+  }
+
+private:
+  std::unique_ptr<T[]> buf_;                       // 2N: 미러 (window 연속성)
+  std::unique_ptr<std::atomic<uint64_t>[]> seq_;   // 슬롯별 seqlock: 2i+1 쓰는 중, 2i+2 완료
+  alignas(64) std::atomic<uint64_t> count_{0};
+};
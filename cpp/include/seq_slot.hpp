@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief Lock-free single-writer slot for a trivially copyable value (seqlock).
+ *
+ * The writer never blocks and never waits for readers; a reader that overlaps
+ * a write retries until it gets a consistent copy. Used to hand commands and
+ * telemetry between the real-time control thread and Python without a mutex
+ * on the RT side.
+ *
+ * Exactly one thread may call store() at a time; any number may load().
+ */
+template <class T>
+class SeqSlot {
+  static_assert(std::is_trivially_copyable<T>::value, "SeqSlot needs a trivially copyable T");
+
+public:
+  SeqSlot() { std::memset(&data_, 0, sizeof(T)); }
+  explicit SeqSlot(const T& init) : data_(init) {}
+
+  void store(const T& v) noexcept {
+    const uint64_t s = seq_.load(std::memory_order_relaxed);
+    seq_.store(s + 1, std::memory_order_relaxed);        // 홀수: 쓰는 중
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&data_, &v, sizeof(T));
+    seq_.store(s + 2, std::memory_order_release);
+  }
+
+  T load() const noexcept {
+    T out;
+    for (;;) {
+      const uint64_t s1 = seq_.load(std::memory_order_acquire);
+      if (s1 & 1) continue;
+      std::memcpy(&out, &data_, sizeof(T));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq_.load(std::memory_order_relaxed) == s1) return out;
+    }
+  }
+
+  /// @brief Number of completed store() calls.
+  uint64_t version() const noexcept { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+  alignas(64) std::atomic<uint64_t> seq_{0};
+  T data_;
+};
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "robot_backend.hpp"
+
+namespace robot {
+
+struct SimOptions {
+    double dt_ms = 20.0;           ///< plant time advanced per req() (Robot::set_control_period() overrides)
+    int    substeps = 20;          ///< integration steps per req()
+    double leg_inertia = 0.02;     ///< reflected joint inertia (kg m^2)
+    double wheel_inertia = 0.01;
+    double damping = 0.05;         ///< viscous joint friction (N m s / rad)
+    double torque_limit = 30.0;    ///< |motor torque| clamp (N m)
+    double gravity_load = 0.0;     ///< leg joints feel -gravity_load * sin(q) (N m; 0: on a stand)
+    double base_inertia = 0.3;     ///< body roll / pitch / yaw inertia (kg m^2)
+    double base_stiffness = 40.0;  ///< ground support restoring roll / pitch (N m / rad)
+    double base_damping = 4.0;     ///< (N m s / rad)
+    double reaction = 0.05;        ///< fraction of left-right / front-rear joint torque felt by the body
+    double pos_noise = 0.0;        ///< measurement noise std (rad)
+    double vel_noise = 0.0;        ///< (rad/s)
+    uint32_t seed = 1;
+    size_t wheels_per_board = 2;   ///< last motors of each board are wheels (Topology::kWheelsPerBoard)
+    std::vector<float> q0;         ///< initial motor positions, action order (empty: all 0)
+    double roll0 = 0.0, pitch0 = 0.0;   ///< initial body attitude (rad)
+};
+
+/// @brief Plant state for tests and benches (SimBackend::snapshot()).
+struct SimSnapshot {
+    int64_t t_ns = 0;              ///< plant time
+    std::vector<float> q, dq, u;   ///< motor position / velocity / applied torque, action order
+    std::array<float, 3> rpy{}, omega{};
+    bool estopped = true;
+    uint64_t reqs = 0, sends = 0, estops = 0;
+};
+
+/**
+ * @brief RobotBackend driving an in-process simulated plant.
+ *
+ * Every motor is a rigid joint (inertia, viscous friction, optional gravity
+ * load on the legs) driven by the board's MIT law, clamped to torque_limit;
+ * wheels (the last wheels_per_board motors of each board, as in the robot
+ * topology) have no gravity load. The body is one rigid body on
+ * spring-damper ground support whose roll / pitch / yaw are pushed by the
+ * reaction of the left-right and front-rear joint torques; the
+ * IMU (reported by the last board) gives its rates and projected gravity.
+ *
+ * The plant runs in lockstep with the caller: each req() advances it by
+ * dt_ms, so a 50 Hz pipeline runs as fast as the CPU allows. Several send()s
+ * between two req()s (action shaper sub-ticks) are taken as evenly spaced over
+ * that dt_ms, each held for its share. ESTOP makes the
+ * motors limp (STATUS pattern 0) until START, as on the boards.
+ *
+ * Fault injection for tests: set_emergency(), drop_reqs(), set_offline().
+ */
+class SimBackend final : public RobotBackend {
+public:
+    explicit SimBackend(SimOptions opt = {},
+                        std::vector<std::vector<uint8_t>> boards = {{1, 2, 3, 4, 5, 6, 7, 8},
+                                                                    {9, 10, 11, 12, 13, 14, 15, 16}})
+        : _opt(std::move(opt)), _boards(std::move(boards)), _rng(_opt.seed)
+    {
+        if (_boards.empty()) throw std::invalid_argument("SimBackend: at least one board");
+        if (!(_opt.dt_ms > 0.0) || _opt.substeps < 1)
+            throw std::invalid_argument("SimBackend: dt_ms must be > 0 and substeps >= 1");
+        for (const auto& b : _boards) _n += b.size();
+        if (!_opt.q0.empty() && _opt.q0.size() != _n)
+            throw std::invalid_argument("SimBackend: q0 must have one entry per motor");
+
+        _q.assign(_n, 0.0); _dq.assign(_n, 0.0); _u.assign(_n, 0.0);
+        if (!_opt.q0.empty()) std::copy(_opt.q0.begin(), _opt.q0.end(), _q.begin());
+        for (auto* v : {&_pos, &_vel, &_kp, &_kd, &_tau}) v->assign(_n, 0.0f);
+        _sent.assign(kMaxSends * 5 * _n, 0.0f);
+        _wheel.resize(_n);
+        _left.resize(_n);
+        _front.resize(_n);
+        size_t g = 0;
+        for (size_t k = 0; k < _boards.size(); ++k)
+            for (size_t s = 0; s < _boards[k].size(); ++s, ++g) {
+                _wheel[g] = s + _opt.wheels_per_board >= _boards[k].size();
+                _left[g] = s % 2 == 0;   // 보드 안 짝수 슬롯이 왼쪽 (left_hip, right_hip, ...)
+                _front[g] = k == 0;
+            }
+        _rpy = {_opt.roll0, _opt.pitch0, 0.0};
+        _offline.assign(_boards.size(), 0);
+        _dt_ns = static_cast<int64_t>(_opt.dt_ms * 1e6);
+    }
+
+    const char* name() const override { return "sim"; }
+    const std::vector<std::vector<uint8_t>>& boards() const override { return _boards; }
+
+    size_t motor_cmd(const char* tag, const std::vector<char>& sel, std::vector<char>& ok) override {
+        std::lock_guard<std::mutex> lk(_mtx);
+        _apply_nowait();
+        const std::string_view t(tag);
+        ok.assign(_boards.size(), 0);
+        size_t n = 0;
+        for (size_t k = 0; k < _boards.size(); ++k) {
+            if (!sel[k] || _offline[k]) continue;
+            ok[k] = 1;
+            ++n;
+        }
+        if (n == 0) return 0;
+        if (t == "ESTOP") { _estopped = true; ++_estops; }
+        else if (t == "START") {
+            _estopped = false;
+            std::fill(_kp.begin(), _kp.end(), 0.0f);
+            std::fill(_kd.begin(), _kd.end(), 0.0f);
+            _nsent = 0;
+        }
+        else if (t == "STOP") _estopped = true;
+        return n;
+    }
+
+    // watchdog 스레드: 잠금 없이 표시만, 다음 호출(또는 plant step)에서 반영
+    void estop_nowait() override { _estop_pending.store(true, std::memory_order_release); }
+
+    void status(MotorHealth* motors, BoardHealth* boards) override {
+        std::lock_guard<std::mutex> lk(_mtx);
+        _apply_nowait();
+        size_t g = 0;
+        for (size_t k = 0; k < _boards.size(); ++k) {
+            boards[k] = BoardHealth{};
+            const bool on = !_offline[k];
+            if (on) { boards[k].valid = 1; boards[k].emergency = _emergency; boards[k].seq = _reqs; }
+            for (uint8_t id : _boards[k]) {
+                motors[g++] = on ? MotorHealth{id, 1, static_cast<int16_t>(_estopped ? 0 : MotorHealth::kPatternRunning), 0}
+                                 : MotorHealth{id, 0, -1, 0};
+            }
+        }
+    }
+
+    // RX 시각은 없음 (0 → Robot이 자기 시계로 찍음), SEQ_NUM은 REQ 횟수
+    bool req(ReqMotorState* motors, ReqImu& imu, bool& has_imu, BoardStamp* stamps) override {
+        std::lock_guard<std::mutex> lk(_mtx);
+        _advance(_dt_ns);
+        ++_reqs;
+        has_imu = false;
+        if (_drop > 0) { --_drop; return false; }
+        for (char off : _offline) if (off) return false;
+        for (size_t k = 0; k < _boards.size(); ++k) stamps[k] = BoardStamp{0, _reqs};
+
+        std::normal_distribution<double> npos(0.0, _opt.pos_noise), nvel(0.0, _opt.vel_noise);
+        for (size_t i = 0; i < _n; ++i) {
+            motors[i].p = static_cast<float>(_q[i]  + (_opt.pos_noise > 0.0 ? npos(_rng) : 0.0));
+            motors[i].v = static_cast<float>(_dq[i] + (_opt.vel_noise > 0.0 ? nvel(_rng) : 0.0));
+            motors[i].t = static_cast<float>(_u[i]);
+        }
+        // projected gravity = R^T (0, 0, -1), R = Rz(yaw) Ry(pitch) Rx(roll)
+        const double cr = std::cos(_rpy[0]), sr = std::sin(_rpy[0]);
+        const double cp = std::cos(_rpy[1]), sp = std::sin(_rpy[1]);
+        imu.gx = static_cast<float>(_omega[0]);
+        imu.gy = static_cast<float>(_omega[1]);
+        imu.gz = static_cast<float>(_omega[2]);
+        imu.pgx = static_cast<float>(sp);
+        imu.pgy = static_cast<float>(-sr * cp);
+        imu.pgz = static_cast<float>(-cr * cp);
+        has_imu = true;
+        return true;
+    }
+
+    void send(const MotorTargets& t) override {
+        std::lock_guard<std::mutex> lk(_mtx);
+        _apply_nowait();
+        for (size_t k = 0; k < _boards.size(); ++k) if (_offline[k]) return;   // 보드가 안 받음
+        std::copy(t.pos.begin(), t.pos.end(), _pos.begin());
+        std::copy(t.vel.begin(), t.vel.end(), _vel.begin());
+        std::copy(t.kp.begin(),  t.kp.end(),  _kp.begin());
+        std::copy(t.kd.begin(),  t.kd.end(),  _kd.begin());
+        std::copy(t.tau.begin(), t.tau.end(), _tau.begin());
+        // 다음 req()까지 구간별로 적용 (넘치면 마지막 칸을 덮어씀)
+        const size_t k = std::min(_nsent, kMaxSends - 1);
+        float* seg = &_sent[k * 5 * _n];
+        for (const auto* v : {&_pos, &_vel, &_kp, &_kd, &_tau}) seg = std::copy(v->begin(), v->end(), seg);
+        _nsent = k + 1;
+        ++_sends;
+    }
+
+    void set_control_period(double period_ms) override {
+        std::lock_guard<std::mutex> lk(_mtx);
+        _dt_ns = static_cast<int64_t>(period_ms * 1e6);
+    }
+
+    // ------- Fault injection -------
+    void set_emergency(bool on) { std::lock_guard<std::mutex> lk(_mtx); _emergency = on; }
+    /// @brief The next @p n req() calls report a missing reply (the plant still advances).
+    void drop_reqs(uint32_t n) { std::lock_guard<std::mutex> lk(_mtx); _drop = n; }
+    /// @brief Board @p k stops answering anything (STATUS invalid, commands not acked).
+    void set_offline(size_t k, bool off) { std::lock_guard<std::mutex> lk(_mtx); _offline.at(k) = off; }
+
+    SimSnapshot snapshot() const {
+        std::lock_guard<std::mutex> lk(_mtx);
+        SimSnapshot s;
+        s.t_ns = _t_ns;
+        s.q.assign(_q.begin(), _q.end());
+        s.dq.assign(_dq.begin(), _dq.end());
+        s.u.assign(_u.begin(), _u.end());
+        for (int i = 0; i < 3; ++i) { s.rpy[i] = static_cast<float>(_rpy[i]); s.omega[i] = static_cast<float>(_omega[i]); }
+        s.estopped = _estopped || _estop_pending.load(std::memory_order_acquire);
+        s.reqs = _reqs; s.sends = _sends; s.estops = _estops;
+        return s;
+    }
+
+    const SimOptions& options() const { return _opt; }
+
+private:
+    void _apply_nowait() {
+        if (_estop_pending.exchange(false, std::memory_order_acq_rel)) { _estopped = true; ++_estops; }
+    }
+
+    // send() 구간 k의 목표값을 현재 목표로
+    void _load_sent(size_t k) {
+        const float* seg = &_sent[k * 5 * _n];
+        for (auto* v : {&_pos, &_vel, &_kp, &_kd, &_tau}) {
+            std::copy(seg, seg + _n, v->begin());
+            seg += _n;
+        }
+    }
+
+    // semi-implicit Euler, substeps회. 직전 req() 뒤 send()가 여러 번이면 구간을 나눠 차례로 적용
+    void _advance(int64_t dt_ns) {
+        _apply_nowait();
+        const int ns = _opt.substeps;
+        const double h = dt_ns * 1e-9 / ns;
+        size_t seg = 0;
+        if (_nsent > 1) _load_sent(0);
+        for (int s = 0; s < ns; ++s) {
+            if (_nsent > 1 && static_cast<size_t>(s) * _nsent / ns != seg) _load_sent(seg = static_cast<size_t>(s) * _nsent / ns);
+            double roll_tq = 0.0, pitch_tq = 0.0, yaw_tq = 0.0;
+            for (size_t i = 0; i < _n; ++i) {
+                double u = 0.0;
+                if (!_estopped) {
+                    u = _kp[i] * (_pos[i] - _q[i]) + _kd[i] * (_vel[i] - _dq[i]) + _tau[i];
+                    u = std::clamp(u, -_opt.torque_limit, _opt.torque_limit);
+                }
+                _u[i] = u;
+                const double load = _wheel[i] ? 0.0 : _opt.gravity_load * std::sin(_q[i]);
+                const double J = _wheel[i] ? _opt.wheel_inertia : _opt.leg_inertia;
+                _dq[i] += h * (u - _opt.damping * _dq[i] - load) / J;
+                _q[i]  += h * _dq[i];
+
+                // 반작용: 좌우 차 → roll, 앞뒤 차 → pitch, 바퀴 좌우 차 → yaw
+                const double side = _left[i] ? 1.0 : -1.0;
+                if (_wheel[i]) yaw_tq -= side * u;
+                else {
+                    roll_tq  -= side * u;
+                    pitch_tq -= (_front[i] ? 1.0 : -1.0) * u;
+                }
+            }
+            const double tq[3] = {roll_tq, pitch_tq, yaw_tq};
+            for (int a = 0; a < 3; ++a) {
+                const double k = a < 2 ? _opt.base_stiffness : 0.0;   // yaw는 지면 복원력 없음
+                const double acc = (_opt.reaction * tq[a] - k * _rpy[a] - _opt.base_damping * _omega[a]) / _opt.base_inertia;
+                _omega[a] += h * acc;
+                _rpy[a] += h * _omega[a];
+            }
+        }
+        if (_nsent > 1) _load_sent(_nsent - 1);
+        _nsent = 0;
+        _t_ns += dt_ns;
+    }
+
+    SimOptions _opt;
+    std::vector<std::vector<uint8_t>> _boards;
+    size_t _n = 0;
+
+    mutable std::mutex _mtx;   // plant 상태 (snapshot()은 다른 스레드에서도 호출)
+    std::atomic<bool> _estop_pending{false};
+
+    // plant (action 순서)
+    std::vector<double> _q, _dq, _u;
+    std::vector<char> _wheel, _left, _front;
+    std::array<double, 3> _rpy{}, _omega{};
+    int64_t _t_ns = 0, _dt_ns = 0;
+    bool _estopped = true;   // 보드처럼 START 전에는 정지 상태
+
+    // 보드가 붙잡고 있는 마지막 목표값
+    std::vector<float> _pos, _vel, _kp, _kd, _tau;
+    // 직전 req() 뒤의 send()들 (구간 k: pos, vel, kp, kd, tau 순으로 5 × _n)
+    static constexpr size_t kMaxSends = 16;
+    std::vector<float> _sent;
+    size_t _nsent = 0;
+
+    // 고장 주입 / 카운터
+    bool _emergency = false;
+    uint32_t _drop = 0;
+    std::vector<char> _offline;
+    uint64_t _reqs = 0, _sends = 0, _estops = 0;
+    std::mt19937 _rng;
+};
+
+} // namespace robot
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Health of one motor from the last OK<STATUS> reply.
+ *
+ * A motor is connected when it is listed and its run pattern is
+ * kPatternRunning; anything else (not listed, stopped, faulted) counts as a
+ * disconnect for the Robot's timeout.
+ */
+struct MotorHealth {
+  static constexpr int16_t kPatternRunning = 2;
+
+  uint8_t id = 0;
+  uint8_t present = 0;    ///< listed in the last reply
+  int16_t pattern = -1;   ///< run pattern (-1: not reported)
+  int32_t err = 0;        ///< motor error code (0: none / not reported)
+
+  bool connected() const { return present && pattern == kPatternRunning; }
+};
+
+/// @brief Board-level part of the last OK<STATUS> reply.
+struct BoardHealth {
+  uint8_t  valid = 0;       ///< an OK<STATUS> reply was received and decoded
+  uint8_t  emergency = 0;   ///< EMERGENCY value:on
+  uint64_t seq = 0;         ///< SEQ_NUM cnt (0: not reported)
+};
+
+/**
+ * @brief Single-pass, allocation-free decoder for OK<STATUS> replies.
+ *
+ * Reply grammar (whitespace-separated, ';'-terminated groups):
+ *   OK <STATUS> M<id> pattern:<n> err:<n>; ... EMERGENCY value:on|off; [SEQ_NUM: cnt:<n>;]
+ *
+ * Unknown keys inside a motor group and unknown groups are skipped, so
+ * firmware that adds fields keeps working. Motors not listed in the reply
+ * are reported with present = 0.
+ */
+class StatusParser {
+public:
+  StatusParser() { slot_of_.fill(-1); }
+
+  /// @param ids expected motor IDs; out[slot] of parse() follows this order.
+  explicit StatusParser(const std::vector<uint8_t>& ids) : StatusParser() { set_ids(ids); }
+
+  void set_ids(const std::vector<uint8_t>& ids) {
+    if (ids.size() > 64) throw std::invalid_argument("StatusParser: at most 64 motors per board");
+    slot_of_.fill(-1);
+    ids_.assign(ids.begin(), ids.end());
+    for (size_t i = 0; i < ids.size(); ++i) slot_of_[ids[i]] = static_cast<int16_t>(i);
+  }
+
+  size_t size() const { return ids_.size(); }
+
+  /**
+   * @param s      reply string ("" on timeout)
+   * @param out    size() entries, indexed by slot; always fully written
+   * @param board  board-level fields; always written
+   * @return board.valid
+   */
+  bool parse(std::string_view s, MotorHealth* out, BoardHealth& board) const {
+    for (size_t i = 0; i < ids_.size(); ++i) out[i] = MotorHealth{ids_[i], 0, -1, 0};
+    board = BoardHealth{};
+
+    const char* p = s.data();
+    const char* e = p + s.size();
+    if (!skip_prefix(p, e)) return false;
+    board.valid = 1;
+
+    while (p < e) {
+      skip_ws(p, e);
+      if (p >= e) break;
+
+      if (*p == 'M' && p + 1 < e && is_digit(p[1])) {
+        ++p;
+        unsigned id = 0;
+        while (p < e && is_digit(*p)) { id = id * 10 + static_cast<unsigned>(*p - '0'); ++p; }
+        const int slot = id < slot_of_.size() ? slot_of_[id] : -1;
+        MotorHealth m{static_cast<uint8_t>(id), 1, -1, 0};
+        // 'key:value' 나열 → ';'
+        while (p < e && *p != ';') {
+          skip_ws(p, e);
+          long v = 0;
+          if (key_int(p, e, "pattern:", v))  m.pattern = static_cast<int16_t>(v);
+          else if (key_int(p, e, "err:", v)) m.err = static_cast<int32_t>(v);
+          else while (p < e && *p != ';' && *p != ' ') ++p;   // 모르는 키
+        }
+        if (p < e) ++p;
+        if (slot >= 0) out[slot] = m;
+      } else if (starts_with(p, e, "EMERGENCY")) {
+        p += 9;
+        while (p < e && *p != ';') {
+          skip_ws(p, e);
+          if (starts_with(p, e, "value:")) {
+            p += 6;
+            board.emergency = starts_with(p, e, "on") ? 1 : 0;
+          }
+          while (p < e && *p != ';' && *p != ' ') ++p;
+        }
+        if (p < e) ++p;
+      } else if (starts_with(p, e, "SEQ_NUM:")) {
+        p += 8;
+        skip_ws(p, e);
+        long v = 0;
+        if (key_int(p, e, "cnt:", v)) board.seq = static_cast<uint64_t>(v);
+        while (p < e && *p != ';') ++p;
+        if (p < e) ++p;
+      } else {
+        while (p < e && *p != ';') ++p;
+        if (p < e) ++p;
+      }
+    }
+    return true;
+  }
+
+private:
+  static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+  static void skip_ws(const char*& p, const char* e) {
+    while (p < e && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+  }
+
+  static bool starts_with(const char* p, const char* e, const char* lit) {
+    const size_t n = std::strlen(lit);
+    return static_cast<size_t>(e - p) >= n && std::memcmp(p, lit, n) == 0;
+  }
+
+  static bool skip_prefix(const char*& p, const char* e) {
+    skip_ws(p, e);
+    if (!starts_with(p, e, "OK")) return false;
+    p += 2;
+    skip_ws(p, e);
+    if (!starts_with(p, e, "<STATUS>")) return false;
+    p += 8;
+    return true;
+  }
+
+  // 'key:<정수>' 하나 읽기 (부호 허용). 키가 다르면 p를 움직이지 않고 false
+  static bool key_int(const char*& p, const char* e, const char* key, long& out) {
+    if (!starts_with(p, e, key)) return false;
+    const char* q = p + std::strlen(key);
+    bool neg = false;
+    if (q < e && (*q == '-' || *q == '+')) { neg = *q == '-'; ++q; }
+    if (q >= e || !is_digit(*q)) return false;
+    long v = 0;
+    while (q < e && is_digit(*q)) { v = v * 10 + (*q - '0'); ++q; }
+    out = neg ? -v : v;
+    p = q;
+    return true;
+  }
+
+  std::array<int16_t, 256> slot_of_{};   ///< motor id → slot (-1: not expected)
+  std::vector<uint8_t> ids_;
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct StopOptions {
+    double rate_hz     = 500.0;   ///< streaming rate (REQ + MIT per tick) of Robot::precise_stop()
+    float  wheel_decel = 10.0f;   ///< max wheel deceleration (rad/s^2)
+    float  wheel_jerk  = 100.0f;  ///< max wheel jerk (rad/s^3)
+    float  leg_speed   = 0.5f;    ///< peak leg speed toward the crouch pose (rad/s)
+    std::vector<float> crouch;    ///< leg pose to end in (dof_pos order); empty: hold the pose at begin
+    double settle_ms   = 100.0;   ///< at rest this long → done
+    float  vel_eps     = 0.05f;   ///< |dq| of every motor at rest (rad/s)
+    double max_ms      = 3000.0;  ///< not at rest by then → e-stop
+    int    max_missed  = 5;       ///< deadlines missed in a row → e-stop
+    int    fifo_prio   = 80;      ///< SCHED_FIFO priority of the streaming thread (0: keep the default policy)
+    int    cpu         = -1;      ///< pin the streaming thread to this CPU (-1: no pinning)
+};
+
+enum class StopPhase : uint8_t {
+    Idle,      ///< not stopping (never started, finished, or cancelled)
+    Braking,   ///< wheel deceleration / leg trajectory running
+    Settling,  ///< trajectories finished, waiting until at rest for settle_ms
+    Done,      ///< at rest; the final targets stay applied
+    TimedOut,  ///< max_ms passed without coming to rest
+};
+
+/// @brief Progress of the current / last stop.
+struct StopStatus {
+    StopPhase phase;
+    uint32_t  tick;          ///< ticks advanced since begin()
+    float     speed;         ///< wheel speed left, fraction of the speed at begin (1 → 0)
+    double    elapsed_ms;    ///< tick * tick_ms
+    double    in_rest_ms;    ///< time at rest (0 while moving)
+    uint32_t  missed;        ///< deadlines missed (total)
+    int64_t   max_late_ns;   ///< worst lateness against the deadline
+};
+
+/**
+ * @brief Tick-driven controlled stop (the state of Robot::precise_stop()).
+ *
+ * Wheels: time-optimal, jerk-limited deceleration to zero. One scalar
+ * profile is run for the fastest wheel (|a| <= wheel_decel, |da/dt| <=
+ * wheel_jerk, decelerating as hard as allowed while leaving the velocity
+ * a^2 / 2J needed to bring the deceleration back to zero) and every wheel
+ * is scaled by it, so the wheels keep their ratios (no yaw kick) and all
+ * stop on the same tick.
+ *
+ * Legs: hold the pose at begin(), or move to the crouch pose along a
+ * minimum-jerk path 10τ³ - 15τ⁴ + 6τ⁵ whose peak speed is leg_speed.
+ *
+ * Per tick: targets() gives the wheel velocity / leg position targets to
+ * send, then observe() takes the resulting velocities and returns the new
+ * phase. Time is counted in ticks of tick_ms as in WakeRamp; deadline()
+ * records how late the caller ran a tick. No allocation after begin().
+ */
+class StopTrajectory {
+public:
+    /**
+     * @param wheel_v0  wheel velocities at the start (rad/s)
+     * @param leg_q0    leg positions at the start (rad)
+     * @param leg_q1    leg end pose (same size as leg_q0)
+     * @param tick_ms   period of targets() / observe()
+     */
+    void begin(std::span<const float> wheel_v0, std::span<const float> leg_q0,
+               std::span<const float> leg_q1, double tick_ms, const StopOptions& opt = {}) {
+        _opt = opt;
+        _tick_ms = tick_ms;
+        _v0.assign(wheel_v0.begin(), wheel_v0.end());
+        _q0.assign(leg_q0.begin(), leg_q0.end());
+        _dq.resize(_q0.size());
+        float vmax = 0.0f, dmax = 0.0f;
+        for (float v : _v0) vmax = std::max(vmax, std::fabs(v));
+        for (size_t i = 0; i < _q0.size(); ++i) {
+            _dq[i] = leg_q1[i] - _q0[i];
+            dmax = std::max(dmax, std::fabs(_dq[i]));
+        }
+        _vmax0 = vmax;
+        _v = vmax;
+        _a = 0.0;
+        // min-jerk 최고 속도 = 1.875 × 평균 속도
+        _leg_ms = dmax > 0.0f && _opt.leg_speed > 0.0f ? 1875.0 * dmax / _opt.leg_speed : 0.0;
+        _st = StopStatus{StopPhase::Braking, 0, vmax > 0.0f ? 1.0f : 0.0f, 0.0, 0.0, 0, 0};
+        _rest = -1;
+        _missed_run = 0;
+    }
+
+    /// @brief Abandon the stop (phase → Idle); status() keeps the last progress.
+    void cancel() { if (active()) _st.phase = StopPhase::Idle; }
+
+    bool active() const { return _st.phase == StopPhase::Braking || _st.phase == StopPhase::Settling; }
+    const StopStatus& status() const { return _st; }
+    const StopOptions& options() const { return _opt; }
+
+    /// @brief Targets for the current tick: wheel velocities and leg positions (sizes as in begin()).
+    void targets(float* wheel_v, float* leg_q) const {
+        const double s = _vmax0 > 0.0f ? _v / _vmax0 : 0.0;
+        for (size_t i = 0; i < _v0.size(); ++i) wheel_v[i] = static_cast<float>(_v0[i] * s);
+        const double tau = _leg_ms > 0.0 ? std::min(1.0, _st.elapsed_ms / _leg_ms) : 1.0;
+        const float m = static_cast<float>(tau * tau * tau * (10.0 - 15.0 * tau + 6.0 * tau * tau));
+        for (size_t i = 0; i < _q0.size(); ++i) leg_q[i] = _q0[i] + _dq[i] * m;
+    }
+
+    /// @brief Feed this tick's motor velocities and move to the next tick.
+    StopPhase observe(std::span<const float> dq) {
+        if (!active()) return _st.phase;
+        const int64_t t = _st.tick;
+        const bool traj_done = _v <= 0.0 && _st.elapsed_ms >= _leg_ms;
+        const bool at_rest = std::all_of(dq.begin(), dq.end(), [&](float v) { return std::fabs(v) <= _opt.vel_eps; });
+
+        if (traj_done && at_rest) {
+            if (_rest < 0) _rest = t;
+            _st.in_rest_ms = (t - _rest) * _tick_ms;
+            _st.phase = _st.in_rest_ms >= _opt.settle_ms ? StopPhase::Done : StopPhase::Settling;
+        } else {
+            _rest = -1;
+            _st.in_rest_ms = 0.0;
+            _st.phase = traj_done ? StopPhase::Settling : StopPhase::Braking;
+        }
+        if (_st.phase != StopPhase::Done && _st.elapsed_ms > _opt.max_ms) _st.phase = StopPhase::TimedOut;
+        if (!active()) return _st.phase;
+
+        _brake(_tick_ms * 1e-3);
+        _st.tick += 1;
+        _st.elapsed_ms = _st.tick * _tick_ms;
+        _st.speed = _vmax0 > 0.0f ? static_cast<float>(_v / _vmax0) : 0.0f;
+        return _st.phase;
+    }
+
+    /// @brief The caller ran this tick @p late_ns after its deadline (<= 0: on time).
+    /// @return deadlines missed in a row
+    int deadline(int64_t late_ns) {
+        if (late_ns <= 0) return _missed_run = 0;
+        _st.missed += 1;
+        _st.max_late_ns = std::max(_st.max_late_ns, late_ns);
+        return ++_missed_run;
+    }
+
+private:
+    // 시간 최적 저크 제한 감속 (이산): 허용 최대 감속으로, 단 감속을 틱마다 J dt씩 0으로
+    // 되돌리는 동안 줄어들 속도 D(a)는 남겨 둔다. a = -(n + f) J dt 이면
+    //   D(a) = J dt² (n + 1)(f + n/2)
+    // 이고 D(a) = v 인 a를 따라가면 다음 틱의 경계가 정확히 a + J dt 라서, 마지막 틱(f J dt)까지
+    // |Δa| <= J dt를 지키며 v와 a가 같은 틱에 0이 된다.
+    void _brake(double dt) {
+        if (_v <= 0.0) { _v = 0.0; _a = 0.0; return; }
+        const double A = _opt.wheel_decel, J = _opt.wheel_jerk, jdt = J * dt;
+        const double u = _v / (jdt * dt);                         // v / (J dt²)
+        const double n = std::floor((std::sqrt(1.0 + 8.0 * u) - 1.0) * 0.5);   // n(n+1)/2 <= u
+        const double f = std::clamp((u - 0.5 * n * (n + 1.0)) / (n + 1.0), 0.0, 1.0);
+        const double a_edge = -(n + f) * jdt;
+        const double a = std::clamp(std::max(a_edge, -A), _a - jdt, _a + jdt);
+        _a = a;
+        _v += a * dt;
+        if (_v <= 1e-9 * _vmax0) _v = 0.0;   // 마지막 틱의 반올림 잔여
+    }
+
+    StopOptions _opt;
+    double _tick_ms = 2.0;
+    std::vector<float> _v0, _q0, _dq;   // 바퀴 시작 속도 / 다리 시작 자세, (끝 - 시작)
+    float _vmax0 = 0.0f;                // 가장 빠른 바퀴의 시작 속도
+    double _v = 0.0, _a = 0.0;          // 그 바퀴의 감속 프로파일 (속도, 가속도)
+    double _leg_ms = 0.0;               // 다리 궤적 길이
+    StopStatus _st{StopPhase::Idle, 0, 0.0f, 0.0, 0.0, 0, 0};
+    int64_t _rest = -1;                 // 정지 상태에 들어온 틱 (-1: 움직이는 중)
+    int _missed_run = 0;
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Compile-time robot morphology: boards, joints, wheels and index maps.
+ *
+ * Every board carries the same motor layout, position-controlled leg joints
+ * first and velocity-controlled wheels after them (motor IDs consecutive from
+ * 1). The action order is the boards' motors concatenated in board order;
+ * dof_pos holds the joints only, dof_vel every motor:
+ *
+ *   action g  →  joint kActJoint[g] (-1: wheel)
+ *   joint j   →  action / dof_vel index kJointMotor[j]
+ *   wheel w   →  action / dof_vel index kWheelMotor[w]
+ *
+ * All tables are constexpr, so code templated on a topology (BasicRobot,
+ * BasicObsFrame, rl::BasicRL, JointLimits) sees fixed trip counts and constant
+ * indices and a second morphology compiles as its own specialization.
+ *
+ * A concrete robot derives from Topology<> and adds kJointNames (kJoints
+ * names in dof_pos order), used for the per-joint offsets and limits.
+ */
+template <size_t Boards, size_t JointsPerBoard, size_t WheelsPerBoard, size_t HeightMap = 144>
+struct Topology {
+  static constexpr size_t kBoards         = Boards;
+  static constexpr size_t kJointsPerBoard = JointsPerBoard;
+  static constexpr size_t kWheelsPerBoard = WheelsPerBoard;
+  static constexpr size_t kMotorsPerBoard = JointsPerBoard + WheelsPerBoard;
+  static constexpr size_t kJoints         = Boards * JointsPerBoard;
+  static constexpr size_t kWheels         = Boards * WheelsPerBoard;
+  static constexpr size_t kMotors         = Boards * kMotorsPerBoard;
+  static constexpr size_t kHeightMap      = HeightMap;
+
+  static_assert(Boards >= 1 && kMotorsPerBoard >= 1, "empty topology");
+  static_assert(kMotors <= 255, "motor IDs are one byte on the wire");
+
+  static constexpr bool is_wheel(size_t g) { return g % kMotorsPerBoard >= kJointsPerBoard; }
+
+  static constexpr std::array<int8_t, kMotors> kActJoint = [] {
+    std::array<int8_t, kMotors> t{};
+    for (size_t g = 0; g < kMotors; ++g)
+      t[g] = g % kMotorsPerBoard >= kJointsPerBoard ? int8_t(-1)
+                                                    : static_cast<int8_t>(g / kMotorsPerBoard * kJointsPerBoard + g % kMotorsPerBoard);
+    return t;
+  }();
+
+  static constexpr std::array<uint8_t, kJoints> kJointMotor = [] {
+    std::array<uint8_t, kJoints> t{};
+    for (size_t g = 0; g < kMotors; ++g)
+      if (kActJoint[g] >= 0) t[static_cast<size_t>(kActJoint[g])] = static_cast<uint8_t>(g);
+    return t;
+  }();
+
+  static constexpr std::array<uint8_t, kWheels> kWheelMotor = [] {
+    std::array<uint8_t, kWheels> t{};
+    for (size_t g = 0, w = 0; g < kMotors; ++g)
+      if (kActJoint[g] < 0) t[w++] = static_cast<uint8_t>(g);
+    return t;
+  }();
+
+  /// @brief Per-motor value: @p joint for leg joints, @p wheel for wheels (action order).
+  static constexpr std::array<float, kMotors> per_motor(float joint, float wheel) {
+    std::array<float, kMotors> t{};
+    for (size_t g = 0; g < kMotors; ++g) t[g] = is_wheel(g) ? wheel : joint;
+    return t;
+  }
+
+  /// @brief Motor IDs per board (1..kMotors in action order).
+  static std::vector<std::vector<uint8_t>> board_ids() {
+    std::vector<std::vector<uint8_t>> ids(kBoards);
+    for (size_t k = 0; k < kBoards; ++k)
+      for (size_t s = 0; s < kMotorsPerBoard; ++s)
+        ids[k].push_back(static_cast<uint8_t>(k * kMotorsPerBoard + s + 1));
+    return ids;
+  }
+};
+
+/// @brief 4W: front (M1..M8) and rear (M9..M16) boards, each with 6 leg joints and 2 wheels.
+struct W4Topology : Topology<2, 6, 2> {
+  static constexpr std::array<std::string_view, kJoints> kJointNames = {
+    "left_hip_f", "right_hip_f", "left_shoulder_f", "right_shoulder_f", "left_leg_f", "right_leg_f",
+    "left_hip_r", "right_hip_r", "left_shoulder_r", "right_shoulder_r", "left_leg_r", "right_leg_r",
+  };
+};
+
+/// @brief The robot this SDK ships for (Robot, ObsFrame, rl::RL).
+using DefaultTopology = W4Topology;
+
+namespace topology_detail {
+template <class F, size_t... I>
+constexpr void unroll(F& f, std::index_sequence<I...>) {
+  (f(std::integral_constant<size_t, I>{}), ...);
+}
+} // namespace topology_detail
+
+/// @brief Call f(std::integral_constant<size_t, I>{}) for I = 0..N-1, unrolled at compile time.
+template <size_t N, class F>
+constexpr void unroll(F&& f) {
+  topology_detail::unroll(f, std::make_index_sequence<N>{});
+}
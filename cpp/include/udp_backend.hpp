@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fx_pool.hpp"         // 보드 풀 (공용 I/O 스레드 + 병렬 트랜잭션)
+#include "req_parser.hpp"      // OK<REQ> 단일 패스 파서
+#include "robot_backend.hpp"
+#include "status_parser.hpp"   // OK<STATUS> 단일 패스 파서
+
+namespace robot {
+
+/**
+ * @brief RobotBackend over Fx boards on UDP (the real robot).
+ *
+ * Boards are added to a (possibly shared) FxPool; every exchange is issued to
+ * all boards in parallel. Gain tables are cached per board: AT+GAIN is only
+ * re-uploaded when kp/kd change, and ticks then send the compact AT+MITC.
+ * A board without GAIN support (FxBoard::gain_table = false) always gets full
+ * AT+MIT frames. On a GAIN-capable board a missed upload ack is transient: the
+ * board gets full AT+MIT and the upload is retried after an exponential backoff
+ * of 1, 2, 4 … kGainBackoffMax sends (reset by an ack or gains_changed()).
+ *
+ * record() appends every REQ exchange to a text file that ReplayBackend can
+ * play back: one line per tick, the boards' raw replies separated by tabs
+ * (empty field: no reply).
+ */
+class UdpBackend final : public RobotBackend {
+public:
+    UdpBackend(std::shared_ptr<FxPool> pool, const std::vector<FxBoard>& boards)
+        : _pool(std::move(pool))
+    {
+        if (!_pool) throw std::invalid_argument("UdpBackend: FxPool must not be null");
+        size_t offset = 0;
+        for (const auto& b : boards) {
+            _boards.push_back(_pool->add_board(b));
+            _motor_ids.push_back(b.motor_ids);
+            _motor_offset.push_back(offset);
+            offset += b.motor_ids.size();
+            _req_parsers.emplace_back(b.motor_ids);
+            _status_parsers.emplace_back(b.motor_ids);
+            _gain_cap.push_back(b.gain_table);
+        }
+        _num_motors = offset;
+        _mcu.resize(_boards.size());
+        _status.resize(_boards.size());
+        // 응답 버퍼는 collect()가 기존 용량에 복사 → 미리 잡아 두면 틱마다 할당 없음
+        for (auto& s : _mcu)    s.reserve(kReplyReserve);
+        for (auto& s : _status) s.reserve(kReplyReserve);
+        _tx_ack.reserve(kReplyReserve);
+        _gain_table_valid.assign(_boards.size(), 0);
+        _gain_wait.assign(_boards.size(), 0);
+        _gain_backoff.assign(_boards.size(), 0);
+        _board_kp.assign(_num_motors, 0.0f);
+        _board_kd.assign(_num_motors, 0.0f);
+        _req_imu.resize(_boards.size());
+        _rx_ns.resize(_boards.size());
+
+        // 송신 scratch (틱마다 재사용 → 할당 없음)
+        for (auto* v : {&_tx_upload, &_tx_upload_k, &_tx_compact, &_tx_compact_k, &_tx_full, &_tx_full_k})
+            v->reserve(_boards.size());
+        _tx_ok.reserve(_boards.size());
+        _cmd.reserve(_boards.size());
+    }
+
+    ~UdpBackend() override { if (_rec) std::fclose(_rec); }
+
+    UdpBackend(const UdpBackend&) = delete;
+    UdpBackend& operator=(const UdpBackend&) = delete;
+
+    const char* name() const override { return "udp"; }
+    const std::vector<std::vector<uint8_t>>& boards() const override { return _motor_ids; }
+
+    FxPool& pool() { return *_pool; }
+
+    // 보드 응답과 FxCli 타임아웃은 실제 시간 → 가상 시계로는 돌릴 수 없음
+    bool virtual_time_ok() const override { return false; }
+
+    size_t motor_cmd(const char* tag, const std::vector<char>& sel, std::vector<char>& ok) override {
+        _cmd.clear();
+        for (size_t k = 0; k < _boards.size(); ++k) if (sel[k]) _cmd.push_back(_boards[k]);
+        ok.assign(_boards.size(), 0);
+        const size_t n = _pool->motor_cmd(_cmd, tag, &_cmd_ok);
+        for (size_t k = 0, j = 0; k < _boards.size(); ++k) if (sel[k]) ok[k] = _cmd_ok[j++];
+        // START 이후 MCU gain table은 초기화된 것으로 간주 → 첫 틱에 재업로드
+        if (std::string_view(tag) == "START")
+            for (size_t k = 0; k < _boards.size(); ++k) if (ok[k]) _gain_table_valid[k] = 0;
+        return n;
+    }
+
+    void estop_nowait() override {
+        for (size_t k = 0; k < _boards.size(); ++k)
+            _pool->cli(_boards[k]).post_estop_nowait(_motor_ids[k]);
+    }
+
+    void status(MotorHealth* motors, BoardHealth* boards) override {
+        _pool->status(_boards, _status);   // 모든 보드에 동시에 STATUS
+        for (size_t k = 0; k < _boards.size(); ++k)
+            _status_parsers[k].parse(_status[k], motors + _motor_offset[k], boards[k]);
+    }
+
+    // IMU는 IMU 블록을 보내는 마지막 보드 (기본 구성에선 뒤 보드)
+    bool req(ReqMotorState* motors, ReqImu& imu, bool& has_imu, BoardStamp* stamps) override {
+        _pool->req(_boards, _mcu, &_rx_ns);   // 모든 보드에 동시에 REQ (틱 예산 안에서 재송신)
+        if (_rec) _record();
+        has_imu = false;
+        for (size_t k = 0; k < _boards.size(); ++k) {
+            bool h = false;
+            if (!_req_parsers[k].parse(_mcu[k], motors + _motor_offset[k], _req_imu[k], h, &stamps[k].seq))
+                return false;
+            stamps[k].rx_ns = _rx_ns[k];
+            if (h) { imu = _req_imu[k]; has_imu = true; }
+        }
+        return true;
+    }
+
+    // 목표값 송신: gain table이 바뀐 보드만 AT+GAIN 재업로드 후 AT+MITC(pos/vel/tau)만 전송.
+    // 업로드 ACK를 못 받은 보드는 gain을 직접 싣는 full MIT로 대체하고, backoff 동안은 다시
+    // 업로드하지 않음 (ACK가 계속 없을 때 매 틱 RT 타임아웃을 기다리지 않도록).
+    // 각 단계는 모든 보드에 먼저 송신하고 ACK를 한꺼번에 기다린다.
+    void send(const MotorTargets& t) override {
+        // 보드 k의 구간 (복사 없이 view)
+        auto slice = [&](std::span<const float> v, size_t k) {
+            return v.subspan(_motor_offset[k], _motor_ids[k].size());
+        };
+        const int timeout_rt = _pool->cli(_boards[0]).timeout_ms_rt();
+
+        // 1) gain table 동기화 (바뀐 보드만)
+        _tx_upload.clear();
+        _tx_upload_k.clear();
+        for (size_t k = 0; k < _boards.size(); ++k) {
+            const size_t s = _motor_offset[k], e = s + _motor_ids[k].size();
+            if (!_gain_cap[k]) continue;                       // GAIN 없는 펌웨어: 항상 full MIT
+            if (_gain_wait[k]) { --_gain_wait[k]; continue; }  // ACK 유실 뒤 backoff 중
+            bool same = _gain_table_valid[k] &&
+                std::equal(t.kp.begin()+s, t.kp.begin()+e, _board_kp.begin()+s) &&
+                std::equal(t.kd.begin()+s, t.kd.begin()+e, _board_kd.begin()+s);
+            if (!same) { _tx_upload.push_back(_boards[k]); _tx_upload_k.push_back(k); }
+        }
+        if (!_tx_upload.empty()) {
+            _pool->transact(_tx_upload, "GAIN", timeout_rt,
+                [&](FxCli& cli, size_t j) {
+                    const size_t k = _tx_upload_k[j];
+                    cli.post_gain_table(_motor_ids[k], slice(t.kp, k), slice(t.kd, k));
+                }, nullptr, &_tx_ok);
+            for (size_t j = 0; j < _tx_upload_k.size(); ++j) {
+                const size_t k = _tx_upload_k[j];
+                _gain_table_valid[k] = _tx_ok[j];
+                if (!_tx_ok[j]) {   // 일시적 유실로 보고 1, 2, 4 … 송신 뒤 다시 시도
+                    _gain_backoff[k] = std::clamp<uint32_t>(_gain_backoff[k] * 2, 1, kGainBackoffMax);
+                    _gain_wait[k] = _gain_backoff[k];
+                } else {
+                    _gain_backoff[k] = 0;
+                    const size_t s = _motor_offset[k], e = s + _motor_ids[k].size();
+                    std::copy(t.kp.begin()+s, t.kp.begin()+e, _board_kp.begin()+s);
+                    std::copy(t.kd.begin()+s, t.kd.begin()+e, _board_kd.begin()+s);
+                }
+            }
+        }
+
+        // 2) 목표값 송신: compact 보드와 full MIT 보드는 ACK 태그가 달라서 나눠서 수집
+        _tx_compact.clear(); _tx_compact_k.clear();
+        _tx_full.clear();    _tx_full_k.clear();
+        for (size_t k = 0; k < _boards.size(); ++k) {
+            if (_gain_table_valid[k]) { _tx_compact.push_back(_boards[k]); _tx_compact_k.push_back(k); }
+            else                      { _tx_full.push_back(_boards[k]);    _tx_full_k.push_back(k); }
+        }
+        for (size_t j = 0; j < _tx_compact.size(); ++j) {
+            const size_t k = _tx_compact_k[j];
+            _pool->cli(_tx_compact[j]).post_operation_control_compact(
+                _motor_ids[k], slice(t.pos, k), slice(t.vel, k), slice(t.tau, k));
+        }
+        for (size_t j = 0; j < _tx_full.size(); ++j) {
+            const size_t k = _tx_full_k[j];
+            _pool->cli(_tx_full[j]).post_operation_control(
+                _motor_ids[k], slice(t.pos, k), slice(t.vel, k), slice(t.kp, k), slice(t.kd, k), slice(t.tau, k));
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_rt);
+        for (size_t b : _tx_compact) _pool->cli(b).collect("MITC", _tx_ack, deadline);
+        for (size_t b : _tx_full)    _pool->cli(b).collect("MIT",  _tx_ack, deadline);
+    }
+
+    // set_gains / wake: backoff 중인 보드도 다음 send에서 바로 업로드
+    void gains_changed() override {
+        std::fill(_gain_wait.begin(), _gain_wait.end(), 0);
+        std::fill(_gain_backoff.begin(), _gain_backoff.end(), 0);
+    }
+
+    /// @brief Boards that the last send() drove with compact AT+MITC (the rest got full AT+MIT).
+    size_t compact_boards() const { return _tx_compact.size(); }
+
+    void set_req_retry(double control_period_ms, double slice) override {
+        for (size_t b : _boards) _pool->cli(b).set_req_retry(control_period_ms, slice);
+    }
+
+    uint64_t rx_bad_frames() override {
+        uint64_t n = 0;
+        for (size_t b : _boards) n += _pool->cli(b).rx_crc_errors() + _pool->cli(b).rx_truncated();
+        return n;
+    }
+
+    /// @brief Append every REQ exchange to @p path (ReplayBackend format); "" stops recording.
+    void record(const std::string& path) {
+        if (_rec) { std::fclose(_rec); _rec = nullptr; }
+        if (path.empty()) return;
+        _rec = std::fopen(path.c_str(), "w");
+        if (!_rec) throw std::runtime_error("UdpBackend: cannot open " + path);
+    }
+
+private:
+    static constexpr size_t kReplyReserve = 2048;   // 보드 응답 버퍼 초기 용량
+    static constexpr uint32_t kGainBackoffMax = 64; // AT+GAIN 재시도 간격 상한 (송신 수)
+
+    // 응답의 줄바꿈/탭은 구분자와 겹치므로 공백으로 바꿔 기록
+    void _record() {
+        for (size_t k = 0; k < _mcu.size(); ++k) {
+            if (k) std::fputc('\t', _rec);
+            for (char c : _mcu[k]) std::fputc(c == '\t' || c == '\n' || c == '\r' ? ' ' : c, _rec);
+        }
+        std::fputc('\n', _rec);
+    }
+
+    // boards (FxPool 인덱스 / 보드별 모터 id / action 시작 인덱스)
+    std::shared_ptr<FxPool> _pool;
+    FxPool::Boards _boards;
+    std::vector<std::vector<uint8_t>> _motor_ids;
+    std::vector<size_t> _motor_offset;
+    size_t _num_motors = 0;
+
+    // 보드별 최신 응답 버퍼와 파서 (재사용)
+    std::vector<std::string> _mcu;
+    std::vector<std::string> _status;
+    std::vector<ReqParser> _req_parsers;
+    std::vector<StatusParser> _status_parsers;
+    std::vector<ReqImu> _req_imu;
+    std::vector<int64_t> _rx_ns;   // 보드별 REQ 응답 수신 시각 (CLOCK_MONOTONIC)
+
+    // 보드에 업로드된 gain table 캐시 (AT+GAIN ACK 성공 시에만 갱신)
+    std::vector<char> _gain_table_valid;
+    std::vector<float> _board_kp;
+    std::vector<float> _board_kd;
+    std::vector<char> _gain_cap;          // FxBoard::gain_table
+    std::vector<uint32_t> _gain_wait;     // 다음 업로드 시도까지 남은 송신 수 (ACK 유실 뒤)
+    std::vector<uint32_t> _gain_backoff;  // 현재 backoff (연속 유실마다 2배, kGainBackoffMax까지)
+
+    // 송신 scratch (send, 재사용)
+    FxPool::Boards _tx_upload, _tx_compact, _tx_full, _cmd;
+    std::vector<size_t> _tx_upload_k, _tx_compact_k, _tx_full_k;
+    std::vector<char> _tx_ok, _cmd_ok;
+    std::string _tx_ack;
+
+    std::FILE* _rec = nullptr;   // record()
+};
+
+} // namespace robot
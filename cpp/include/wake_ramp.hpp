@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct WakeOptions {
+    double ramp_ms   = 7000.0;   ///< safe gains → half of the nominal gains over this long
+    double max_ms    = 10000.0;  ///< give up (e-stop) if not settled by then
+    double settle_ms = 200.0;    ///< must stay inside the band this long
+    float  pos_eps   = 0.02f;    ///< |q| band (rad)
+    float  vel_eps   = 0.05f;    ///< |dq| band (rad/s)
+};
+
+enum class WakePhase : uint8_t {
+    Idle,      ///< not waking (never started, finished, or taken over by do_action / estop)
+    Ramping,   ///< gains ramping, not yet inside the band
+    Settling,  ///< inside the band, waiting for settle_ms
+    Done,      ///< settled; nominal gains applied on this tick
+    TimedOut,  ///< max_ms passed without settling
+};
+
+/// @brief Progress of the current / last wake ramp.
+struct WakeStatus {
+    WakePhase phase;
+    uint32_t  tick;          ///< ticks advanced since begin()
+    float     alpha;         ///< ramp fraction (0 → 1)
+    double    elapsed_ms;    ///< tick * tick_ms: schedule time, independent of jitter
+    double    in_band_ms;    ///< time spent inside the band (0 outside)
+};
+
+/**
+ * @brief Tick-driven wake-up gain ramp (the state of Robot::wake()).
+ *
+ * Time is counted in ticks of tick_ms, so the ramp covers exactly
+ * ramp_ms / tick_ms ticks whatever the caller's jitter; the caller only has
+ * to advance it once per control period (ControlLoop, a Python loop, or
+ * Robot::wake() sleeping on absolute deadlines).
+ *
+ * Per tick: gains() gives the gains to send, then observe() takes the
+ * resulting observation and returns the new phase. No allocation after begin().
+ */
+class WakeRamp {
+public:
+    /**
+     * @param kp_safe, kd_safe  starting gains
+     * @param kp_nom, kd_nom    nominal gains; the ramp ends at half of them
+     * @param tick_ms           control period
+     */
+    void begin(std::span<const float> kp_safe, std::span<const float> kd_safe,
+               std::span<const float> kp_nom,  std::span<const float> kd_nom,
+               double tick_ms, const WakeOptions& opt = {}) {
+        _opt = opt;
+        _tick_ms = tick_ms;
+        _kp0.assign(kp_safe.begin(), kp_safe.end());
+        _kd0.assign(kd_safe.begin(), kd_safe.end());
+        _dkp.resize(_kp0.size());
+        _dkd.resize(_kd0.size());
+        for (size_t i = 0; i < _kp0.size(); ++i) {
+            _dkp[i] = 0.5f * kp_nom[i] - _kp0[i];
+            _dkd[i] = 0.5f * kd_nom[i] - _kd0[i];
+        }
+        _st = WakeStatus{WakePhase::Ramping, 0, 0.0f, 0.0, 0.0};
+        _in_band = -1;
+    }
+
+    /// @brief Abandon the ramp (phase → Idle); status() keeps the last progress.
+    void cancel() { if (active()) _st.phase = WakePhase::Idle; }
+
+    bool active() const { return _st.phase == WakePhase::Ramping || _st.phase == WakePhase::Settling; }
+    const WakeStatus& status() const { return _st; }
+    const WakeOptions& options() const { return _opt; }
+
+    /// @brief Gains for the current tick.
+    void gains(float* kp, float* kd) const {
+        const float a = _st.alpha;
+        for (size_t i = 0; i < _kp0.size(); ++i) {
+            kp[i] = _kp0[i] + a * _dkp[i];
+            kd[i] = _kd0[i] + a * _dkd[i];
+        }
+    }
+
+    /// @brief Feed this tick's observation and move to the next tick.
+    WakePhase observe(std::span<const float> q, std::span<const float> dq) {
+        if (!active()) return _st.phase;
+        const bool pos_ok = std::all_of(q.begin(), q.end(), [&](float v) { return std::fabs(v) <= _opt.pos_eps; });
+        const bool vel_ok = std::all_of(dq.begin(), dq.end(), [&](float v) { return std::fabs(v) <= _opt.vel_eps; });
+        const int64_t t = _st.tick;
+
+        if (pos_ok && vel_ok) {
+            if (_in_band < 0) _in_band = t;
+            _st.in_band_ms = (t - _in_band) * _tick_ms;
+            _st.phase = _st.in_band_ms >= _opt.settle_ms || _st.elapsed_ms >= _opt.max_ms
+                      ? WakePhase::Done : WakePhase::Settling;
+        } else {
+            _in_band = -1;
+            _st.in_band_ms = 0.0;
+            _st.phase = _st.elapsed_ms > _opt.max_ms ? WakePhase::TimedOut : WakePhase::Ramping;
+        }
+        if (!active()) return _st.phase;
+
+        _st.tick += 1;
+        _st.elapsed_ms = _st.tick * _tick_ms;
+        _st.alpha = static_cast<float>(std::min(1.0, _st.elapsed_ms / _opt.ramp_ms));
+        return _st.phase;
+    }
+
+private:
+    WakeOptions _opt;
+    double _tick_ms = 20.0;
+    std::vector<float> _kp0, _kd0, _dkp, _dkd;   // 시작 gain, (목표 - 시작)
+    WakeStatus _st{WakePhase::Idle, 0, 0.0f, 0.0, 0.0};
+    int64_t _in_band = -1;                       // 밴드에 들어온 틱 (-1: 밖)
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "rt_thread.hpp"
+#include "seq_slot.hpp"
+
+struct WatchdogOptions {
+    double period_ms = 1.0;            ///< check period
+    double action_timeout_ms = 100.0;  ///< max time since the last successful action (0: off)
+    double obs_timeout_ms = 100.0;     ///< max time since the last fresh observation (0: off)
+    bool   check_limits = true;        ///< position / velocity limits on the latest observation
+    int    fifo_prio = 90;             ///< SCHED_FIFO priority (0: keep the default policy)
+    int    cpu = -1;                   ///< pin to this CPU (-1: no pinning)
+};
+
+/// @brief Why and when a watchdog fired (fixed size: written on the RT thread).
+struct WatchdogTrip {
+    char    reason[256];
+    int64_t deadline_ns;   ///< when the violated condition became true (CLOCK_MONOTONIC)
+    int64_t detect_ns;     ///< when the watchdog noticed it
+    int64_t estop_ns;      ///< time spent in the e-stop callback
+};
+
+struct WatchdogStats {
+    uint64_t checks;
+    int64_t  max_gap_ns;   ///< longest interval between two checks (detection-delay bound)
+    uint8_t  running;
+    uint8_t  tripped;
+    uint8_t  reserved_[6];
+};
+
+/**
+ * @brief Periodic safety watchdog on its own RT thread.
+ *
+ * Every period the @p check callable inspects state that the control path
+ * publishes lock-free (timestamps, the latest observation) and returns true
+ * with a filled WatchdogTrip when something is wrong; the watchdog then
+ * calls @p fire (which e-stops the hardware directly) once and latches.
+ *
+ * Reaction time after the violated condition becomes true is bounded by
+ * max_gap_ns (one period plus scheduling latency) plus estop_ns; both are
+ * measured and reported in stats() / trip().
+ *
+ * The watchdog never takes the locks the control path holds, so a hung
+ * caller (Python GC, a stuck read, a blocked mutex) cannot delay it.
+ */
+class Watchdog {
+public:
+    using Check = std::function<bool(int64_t now_ns, WatchdogTrip& trip)>;
+    using Fire  = std::function<void(const WatchdogTrip& trip)>;
+
+    Watchdog(WatchdogOptions opt, Check check, Fire fire)
+        : _opt(opt), _check(std::move(check)), _fire(std::move(fire))
+    {
+        if (!_check || !_fire) throw std::invalid_argument("Watchdog: check and fire must not be empty");
+        if (!(_opt.period_ms > 0.0)) throw std::invalid_argument("Watchdog: period_ms must be greater than 0");
+        _period_ns = static_cast<int64_t>(_opt.period_ms * 1e6);
+        _thread = std::thread(&Watchdog::_loop, this);
+    }
+
+    ~Watchdog() {
+        _run.store(false, std::memory_order_release);
+        if (_thread.joinable()) _thread.join();
+    }
+
+    Watchdog(const Watchdog&) = delete;
+    Watchdog& operator=(const Watchdog&) = delete;
+
+    const WatchdogOptions& options() const { return _opt; }
+    bool tripped() const { return _tripped.load(std::memory_order_acquire); }
+    WatchdogStats stats() const { return _stats.load(); }
+
+    /// @brief Details of the trip (valid once tripped() is true).
+    WatchdogTrip trip() const { return _trip.load(); }
+
+private:
+    void _loop() {
+        rt::setup_thread("Watchdog", _opt.fifo_prio, _opt.cpu, /*lock_memory=*/false);
+
+        WatchdogStats st{};
+        st.running = 1;
+        WatchdogTrip tr{};
+        int64_t prev = rt::now_ns();
+        int64_t next = prev + _period_ns;
+        while (_run.load(std::memory_order_acquire)) {
+            rt::sleep_until(next, 0);
+            const int64_t now = rt::now_ns();
+            st.max_gap_ns = std::max(st.max_gap_ns, now - prev);
+            prev = now;
+            st.checks += 1;
+
+            if (!st.tripped && _check(now, tr)) {
+                tr.detect_ns = now;
+                _fire(tr);
+                tr.estop_ns = rt::now_ns() - now;
+                _trip.store(tr);
+                st.tripped = 1;
+                _tripped.store(true, std::memory_order_release);
+            }
+            _stats.store(st);
+
+            next += _period_ns;
+            if (next < now) next = now + _period_ns;   // 밀린 주기는 건너뜀
+        }
+        st.running = 0;
+        _stats.store(st);
+    }
+
+    WatchdogOptions _opt;
+    Check _check;
+    Fire _fire;
+    int64_t _period_ns = 0;
+
+    std::atomic<bool> _run{true};
+    std::atomic<bool> _tripped{false};
+    SeqSlot<WatchdogStats> _stats;
+    SeqSlot<WatchdogTrip> _trip;
+    std::thread _thread;
+};
@@ -0,0 +1,124 @@
+// crc32c.cpp
+
+#include "crc32c.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h>
+#define CRC32C_X86 1
+#elif defined(__aarch64__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#define CRC32C_ARM 1
+#endif
+
+namespace crc32c {
+namespace {
+
+constexpr uint32_t kPoly = 0x82F63B78u;   // Castagnoli, reflected
+
+// ──────────────── 소프트웨어 (테이블) ────────────────
+constexpr std::array<uint32_t, 256> make_table() {
+    std::array<uint32_t, 256> t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = (c & 1) ? (c >> 1) ^ kPoly : (c >> 1);
+        t[i] = c;
+    }
+    return t;
+}
+constexpr auto kTable = make_table();
+
+uint32_t sw_update(uint32_t crc, const uint8_t* p, size_t n) {
+    while (n--) crc = kTable[(crc ^ *p++) & 0xFFu] ^ (crc >> 8);
+    return crc;
+}
+
+// ──────────────── 하드웨어 ────────────────
+#if defined(CRC32C_X86)
+__attribute__((target("sse4.2")))
+uint32_t hw_update(uint32_t crc, const uint8_t* p, size_t n) {
+#if defined(__x86_64__)
+    uint64_t c = crc;
+    while (n >= 8) {
+        uint64_t v; std::memcpy(&v, p, 8);
+        c = _mm_crc32_u64(c, v);
+        p += 8; n -= 8;
+    }
+    crc = static_cast<uint32_t>(c);
+#endif
+    while (n--) crc = _mm_crc32_u8(crc, *p++);
+    return crc;
+}
+
+bool detect_hw() { return __builtin_cpu_supports("sse4.2"); }
+
+#elif defined(CRC32C_ARM)
+__attribute__((target("+crc")))
+uint32_t hw_update(uint32_t crc, const uint8_t* p, size_t n) {
+    while (n >= 8) {
+        uint64_t v; std::memcpy(&v, p, 8);
+        crc = __crc32cd(crc, v);
+        p += 8; n -= 8;
+    }
+    while (n--) crc = __crc32cb(crc, *p++);
+    return crc;
+}
+
+bool detect_hw() { return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0; }
+
+#else
+uint32_t hw_update(uint32_t crc, const uint8_t* p, size_t n) { return sw_update(crc, p, n); }
+bool detect_hw() { return false; }
+#endif
+
+using UpdateFn = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+
+// 최초 1회 CPU 기능 확인 후 고정
+const bool     g_hw     = detect_hw();
+const UpdateFn g_update = g_hw ? &hw_update : &sw_update;
+
+inline int hex_val(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+} // namespace
+
+uint32_t compute(const void* data, size_t len, uint32_t crc) {
+    return ~g_update(~crc, static_cast<const uint8_t*>(data), len);
+}
+
+bool hw_accelerated() { return g_hw; }
+
+void make_trailer(const void* data, size_t len, char out[kTrailerLen]) {
+    static constexpr char kHex[] = "0123456789ABCDEF";
+    const uint32_t c = compute(data, len);
+    out[0] = ' ';
+    out[1] = '*';
+    for (int i = 0; i < 8; ++i) out[2 + i] = kHex[(c >> (28 - 4 * i)) & 0xFu];
+}
+
+bool check_trailer(const char* frame, size_t& len) {
+    if (len < kTrailerLen) return false;
+    const char* t = frame + len - kTrailerLen;
+    if (t[0] != ' ' || t[1] != '*') return false;
+
+    uint32_t want = 0;
+    for (int i = 0; i < 8; ++i) {
+        int v = hex_val(t[2 + i]);
+        if (v < 0) return false;
+        want = (want << 4) | static_cast<uint32_t>(v);
+    }
+    const size_t payload = len - kTrailerLen;
+    if (compute(frame, payload) != want) return false;
+    len = payload;
+    return true;
+}
+
+} // namespace crc32c
@@ -7,6 +7,7 @@
 #endif
 
 #include "fx_client.hpp"
+#include "crc32c.hpp"
 #include "elapsed_timer.hpp"
 #include "elapsed_timer_rt.hpp"
 
@@ -22,16 +23,22 @@
 #include <vector>
 #include <array>
 #include <algorithm>
+#include <cmath>
 #include <mutex>
 #include <condition_variable>
 #include <unordered_map>   // ← 기존 유지
+#include <initializer_list>
+#include <span>
+#include <string_view>
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <poll.h>
+#include <time.h>
 #include <pthread.h>
 #include <strings.h>
 #include <fcntl.h>
@@ -47,31 +54,32 @@ static ElapsedTimerRT g_timer_ack_mit("chk_ACK_MIT");
 // ──────────────── 내부 유틸 ────────────────
 namespace {
 
-static inline void trim(std::string &s) {
+static inline void trim(std::string_view &s) {
     size_t b = s.find_first_not_of(" \t\r\n");
-    if (b == std::string::npos) { s.clear(); return; }
+    if (b == std::string_view::npos) { s = {}; return; }
     size_t e = s.find_last_not_of(" \t\r\n");
-    s.assign(s, b, e - b + 1);
+    s = s.substr(b, e - b + 1);
 }
 
-static bool extract_tag_word(const std::string &resp, std::string &out_word) {
+// 응답 버퍼를 가리키는 view로 태그만 잘라냄 (복사/할당 없음)
+static bool extract_tag_word(std::string_view resp, std::string_view &out_word) {
     size_t l = resp.find('<');
-    if (l == std::string::npos) return false;
+    if (l == std::string_view::npos) return false;
     size_t r = resp.find_first_of(">; ", l);
-    if (r == std::string::npos || r <= l + 1) return false;
-    std::string inside = resp.substr(l + 1, r - l - 1);
+    if (r == std::string_view::npos || r <= l + 1) return false;
+    std::string_view inside = resp.substr(l + 1, r - l - 1);
     trim(inside);
     if (inside.empty()) return false;
     size_t cut = inside.find_first_of(" \t(");
-    out_word = (cut == std::string::npos) ? inside : inside.substr(0, cut);
+    out_word = (cut == std::string_view::npos) ? inside : inside.substr(0, cut);
     trim(out_word);
     return !out_word.empty();
 }
 
-static inline bool tag_equals_ci(const std::string& tag, const char* expect_upper) {
+static inline bool tag_equals_ci(std::string_view tag, const char* expect_upper) {
     size_t elen = std::strlen(expect_upper);
     if (tag.size() < elen) return false;
-    if (::strncasecmp(tag.c_str(), expect_upper, elen) != 0) return false;
+    if (::strncasecmp(tag.data(), expect_upper, elen) != 0) return false;
     return (tag.size() == elen) || (tag[elen] == ';') || (tag[elen] == ' ');
 }
 
@@ -113,16 +121,19 @@ static inline const char* format_float(char* buf, size_t bufsz, float v) {
 struct LatestBufferRT {
     uint64_t wseq{0};        // write sequence (증가용 카운터)
     uint64_t rseq{0};        // read sequence  (마지막 소비된 카운터)
+    uint64_t last_seq_num{0}; // 마지막으로 소비한 응답의 SEQ_NUM (소비 스레드 전용)
     std::string latest;      // 최신 패킷 보관용 버퍼
+    int64_t latest_rx_ns{0}; // latest를 recv()한 시각 (CLOCK_MONOTONIC ns)
 
     std::mutex cv_mtx;
     std::condition_variable cv;
 
     // ───────────── push ─────────────
-    inline void push(std::string&& pkt) noexcept {
+    inline void push(std::string&& pkt, int64_t rx_ns) noexcept {
         {
             std::lock_guard<std::mutex> lk(cv_mtx);
             latest = std::move(pkt);
+            latest_rx_ns = rx_ns;
             ++wseq;  // 단순 증가 (락으로 보호되므로 atomic 불필요)
         }
         cv.notify_one();  // 즉시 wake (락 해제 후 호출)
@@ -131,21 +142,21 @@ struct LatestBufferRT {
     // ───────────── pop_latest ─────────────
     bool pop_latest(std::string& out, int timeout_ms) noexcept {
         using clock = std::chrono::steady_clock;
-        const auto deadline = clock::now() + std::chrono::milliseconds(timeout_ms);
-        std::unique_lock<std::mutex> lk(cv_mtx);
+        return pop_latest_until(out, clock::now() + std::chrono::milliseconds(timeout_ms));
+    }
 
-        if (wseq != rseq) {
-            out = latest;
-            rseq = wseq;
-            return true;
-        }
+    // 절대 deadline 기준 (여러 보드가 같은 마감시각을 공유할 때 사용)
+    bool pop_latest_until(std::string& out, std::chrono::steady_clock::time_point deadline,
+                          int64_t* rx_ns = nullptr) noexcept {
+        std::unique_lock<std::mutex> lk(cv_mtx);
 
-        if (!cv.wait_until(lk, deadline, [&]{ return wseq != rseq; })) {
+        if (wseq == rseq && !cv.wait_until(lk, deadline, [&]{ return wseq != rseq; })) {
             ::sched_yield(); // 타임아웃 후 양보 시도
             return false;
         }
 
         out = latest;
+        if (rx_ns) *rx_ns = latest_rx_ns;
         rseq = wseq;
         return true;
     }
@@ -159,6 +170,13 @@ struct LatestBufferRT {
 };
 
 
+// recv() 시각: rt::now_ns()와 같은 CLOCK_MONOTONIC
+static inline int64_t mono_ns() noexcept {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
 // "SEQ_NUM: cnt:<num>;" 형태 파싱
 static bool parse_seq_num(const std::string& s, uint64_t& out) {
     const char* key = "SEQ_NUM";
@@ -187,12 +205,14 @@ static bool parse_seq_num(const std::string& s, uint64_t& out) {
 // ──────────────────────────────────────────────────────
 struct AckQueues { // [CHANGED]
     LatestBufferRT mit;
+    LatestBufferRT mitc;
+    LatestBufferRT gain;
     LatestBufferRT req;
     LatestBufferRT status;
     LatestBufferRT ping, whoami, start_, stop_, estop_, setzero;
 
     void clear_all() { // [CHANGED]
-        mit.clear(); req.clear(); status.clear();
+        mit.clear(); mitc.clear(); gain.clear(); req.clear(); status.clear();
         ping.clear(); whoami.clear();
         start_.clear(); stop_.clear(); estop_.clear(); setzero.clear();
     }
@@ -202,6 +222,8 @@ struct AckQueues { // [CHANGED]
         if (!tag_upper) return nullptr;
         // strcmp는 <cstring> 필요 (이미 포함되어 있음)
         if (std::strcmp(tag_upper,"MIT")     == 0) return &mit;
+        if (std::strcmp(tag_upper,"MITC")    == 0) return &mitc;
+        if (std::strcmp(tag_upper,"GAIN")    == 0) return &gain;
         if (std::strcmp(tag_upper,"REQ")     == 0) return &req;
         if (std::strcmp(tag_upper,"STATUS")  == 0) return &status;
         if (std::strcmp(tag_upper,"PING")    == 0) return &ping;
@@ -224,10 +246,12 @@ struct AckQueues { // [CHANGED]
     // [CHANGED] 패킷 내용으로 큐 선택
     LatestBufferRT* select_by_packet(const std::string& pkt) noexcept {
         if (!begins_with_ok(pkt)) return nullptr;
-        std::string tag;
+        std::string_view tag;
         if (!extract_tag_word(pkt, tag)) return nullptr;
 
         if (tag_equals_ci(tag, "MIT"))     return &mit;
+        if (tag_equals_ci(tag, "MITC"))    return &mitc;
+        if (tag_equals_ci(tag, "GAIN"))    return &gain;
         if (tag_equals_ci(tag, "REQ"))     return &req;
         if (tag_equals_ci(tag, "STATUS"))  return &status;
         if (tag_equals_ci(tag, "PING"))    return &ping;
@@ -244,7 +268,8 @@ struct AckQueues { // [CHANGED]
 // ──────────────── FxCli::UdpSocket ────────────────
 class FxCli::UdpSocket {
 public:
-    explicit UdpSocket(const std::string &ip, uint16_t port, int recv_buf_bytes = (64 * 1024)) {
+    explicit UdpSocket(const std::string &ip, uint16_t port, bool own_rx_thread = true,
+                       int recv_buf_bytes = (64 * 1024)) {
         sock_ = ::socket(AF_INET, SOCK_DGRAM, 0);
         if (sock_ < 0) throw std::runtime_error("socket() failed");
 
@@ -282,7 +307,8 @@ public:
             throw std::runtime_error("connect() failed");
 
         run_rx_.store(true);
-        rx_thread_ = std::thread(&UdpSocket::rx_thread_entry, this);
+        // own_rx_thread=false 면 외부(FxPool)의 공용 I/O 스레드가 fd()/drain()을 호출
+        if (own_rx_thread) rx_thread_ = std::thread(&UdpSocket::rx_thread_entry, this);
     }
 
     ~UdpSocket() {
@@ -352,13 +378,35 @@ public:
         if (fd < 0)
             throw std::runtime_error("send() failed: invalid socket descriptor");
 
-        ssize_t n = ::send(fd, data, (int)len, 0);
+        ssize_t n;
+        size_t total = len;
+        if (crc_.load(std::memory_order_relaxed)) {
+            // payload + " *XXXXXXXX" 를 복사 없이 한 datagram으로
+            char trailer[crc32c::kTrailerLen];
+            crc32c::make_trailer(data, len, trailer);
+            iovec iov[2] = {
+                { const_cast<char*>(data), len },
+                { trailer, sizeof(trailer) },
+            };
+            msghdr msg{};
+            msg.msg_iov = iov;
+            msg.msg_iovlen = 2;
+            total += sizeof(trailer);
+            n = ::sendmsg(fd, &msg, 0);
+        } else {
+            n = ::send(fd, data, (int)len, 0);
+        }
         if (n < 0)
             throw std::runtime_error(std::string("send() failed: ") + strerror(errno));
-        if ((size_t)n != len)
+        if ((size_t)n != total)
             throw std::runtime_error("partial send()");
     }
 
+    void set_crc(bool on) { crc_.store(on, std::memory_order_relaxed); }
+    bool crc() const { return crc_.load(std::memory_order_relaxed); }
+    uint64_t crc_errors() const { return crc_errors_.load(std::memory_order_relaxed); }
+    uint64_t truncated() const { return truncated_.load(std::memory_order_relaxed); }
+
     // [CHANGED] 전체 큐 비우기 → 태그별 큐 전체 초기화
     void flush_queue() { q_.clear_all(); } // [CHANGED]
 
@@ -368,6 +416,13 @@ public:
     // [CHANGED] 태그별 큐에서 잔여시간 내 재시도 (deadline 기반)
     bool wait_for_ok_tag(const char* expect_tag_upper, std::string& out_ok, int timeout_ms) {
         using clock = std::chrono::steady_clock;
+        return wait_for_ok_tag_until(expect_tag_upper, out_ok,
+                                     clock::now() + std::chrono::milliseconds(timeout_ms));
+    }
+
+    bool wait_for_ok_tag_until(const char* expect_tag_upper, std::string& out_ok,
+                               std::chrono::steady_clock::time_point deadline,
+                               int64_t* rx_ns = nullptr) {
         auto* q = q_.select(expect_tag_upper);
         if (!q) {
             return false;
@@ -378,8 +433,9 @@ public:
         if (t) t->startTimer();
         #endif
 
-        std::string data;
-        if (!q->pop_latest(data, timeout_ms)) {
+        // out_ok에 바로 복사 → 호출자가 버퍼를 재사용하면 틱마다 할당 없음
+        std::string& data = out_ok;
+        if (!q->pop_latest_until(data, deadline, rx_ns)) {
             #ifdef DEBUG
             FXCLI_LOG("[wait_for_ok_tag] pop_latest timeout, yielding");
             if (t) { t->stopTimer(); t->printLatest(); }
@@ -389,14 +445,13 @@ public:
         }
         if (!begins_with_ok(data)) return false;
 
-        std::string tag;
+        std::string_view tag;
         if (!extract_tag_word(data, tag)) return false;
         if (!tag_equals_ci(tag, expect_tag_upper)) return false;
 
         uint64_t seq{};
         if (parse_seq_num(data, seq)) {
-            std::lock_guard<std::mutex> lock(seq_mtx_);
-            uint64_t& prev = seq_map_[std::string(expect_tag_upper)];
+            uint64_t& prev = q->last_seq_num;   // 태그별 슬롯에 보관 (맵 조회 없음)
             if (prev != 0 && seq != prev + 1) {
                 FXCLI_LOG(std::string("[DROP?] ") + expect_tag_upper +
                         " SEQ jump: prev=" + std::to_string(prev) +
@@ -408,7 +463,6 @@ public:
         #ifdef DEBUG
         if (t) { t->stopTimer(); t->printLatest(); }
         #endif
-        out_ok = std::move(data);
         return true;
     }
 
@@ -421,14 +475,19 @@ private:
 
     AckQueues q_;  // [CHANGED] ✅ 태그별 최신 데이터만 유지
 
+    // 프레임 무결성 검사 (RX 스레드에서 슬롯 push 전에 수행)
+    std::atomic<bool> crc_{false};
+    std::atomic<uint64_t> crc_errors_{0};
+    std::atomic<uint64_t> truncated_{0};
+
     // 태그별 SEQ 추적용 (예: "REQ", "STATUS", "MIT" 등)
-    std::unordered_map<std::string, uint64_t> seq_map_;
-    std::mutex seq_mtx_;
 
 #ifdef DEBUG
     // [CHANGED - TIMER] 태그별 타이머 세트
     struct TagTimers {
         ElapsedTimerRT mit     {"ack_MIT"};
+        ElapsedTimerRT mitc    {"ack_MITC"};
+        ElapsedTimerRT gain    {"ack_GAIN"};
         ElapsedTimerRT req     {"ack_REQ"};
         ElapsedTimerRT status  {"ack_STATUS"};
         ElapsedTimerRT ping    {"ack_PING"};
@@ -446,6 +505,8 @@ private:
     inline ElapsedTimerRT* timer_for_expect(const char* tag) noexcept {
         if (!tag) return &timers_.other;
         if (!strcmp(tag,"MIT"))     return &timers_.mit;
+        if (!strcmp(tag,"MITC"))    return &timers_.mitc;
+        if (!strcmp(tag,"GAIN"))    return &timers_.gain;
         if (!strcmp(tag,"REQ"))     return &timers_.req;
         if (!strcmp(tag,"STATUS"))  return &timers_.status;
         if (!strcmp(tag,"PING"))    return &timers_.ping;
@@ -465,102 +526,171 @@ private:
     }
 
     void rx_loop_polling() {
-        struct pollfd pfd{ .fd = sock_, .events = POLLIN };
-        std::array<char, 65536> buf;
-
-        using clock = std::chrono::steady_clock;
-
-        const auto RX_BUDGET = std::chrono::milliseconds(1);
+        struct pollfd pfd{ .fd = fd(), .events = POLLIN, .revents = 0 };
 
         while (run_rx_.load(std::memory_order_acquire)) {
             // 1) poll로 이벤트 감시 (1ms 정도; 필요시 남은 전체 예산으로 조정)
+            pfd.fd = fd();  // 재생성되었을 수 있으므로 매번 갱신
             int r = ::poll(&pfd, 1, /*timeout_ms=*/1);
             if (r <= 0) continue;
             if (!(pfd.revents & POLLIN)) continue;
+            drain();
+        }
+    }
 
-            // 2) drain 은 반드시 비-블로킹으로, 그리고 시간 제한!
-            const auto drain_deadline = clock::now() + RX_BUDGET;
-            for (;;) {
-                if (clock::now() >= drain_deadline) break; // 예산 소진 → 즉시 탈출
+public:
+    /// 현재 소켓 fd (재생성 시 바뀜)
+    int fd() {
+        std::lock_guard<std::mutex> lk(sock_mtx_);
+        return sock_;
+    }
 
-                // 비-블로킹 수신: 절대 기다리지 않음
-                ssize_t n = ::recv(sock_, buf.data(), buf.size(), MSG_DONTWAIT);
-                if (n < 0) {
-                    int err = errno;
-                    if (err == EAGAIN || err == EWOULDBLOCK || err == EINTR){
-                        break;
-                    }
-                    if (err == EBADF || err == ENOTCONN || err == ENETDOWN ||
-                        err == ECONNRESET || err == ECONNREFUSED || err == EPIPE) {
-
-                        if (!run_rx_.load(std::memory_order_acquire)) {
-                            std::cerr << "[FxCli::UdpSocket] Socket error during shutdown (errno=" << err << "), exiting...\n";
-                            break;
-                        }
-                        std::cerr << "[FxCli::UdpSocket] Detected bad socket (errno=" << err
-                                  << "), attempting recreate...\n";
-
-                        // ──────────────────────────────
-                        //  소켓 재생성 시간 측정 시작
-                        // ──────────────────────────────
-                        auto t_recreate_start = clock::now();
-
-                        try {
-                            create_socket_or_throw();   // ✅ 간단히 재호출
-                            {
-                                std::lock_guard<std::mutex> lk(sock_mtx_);
-                                pfd.fd = sock_;  // ✅ 새 소켓 핸들 갱신
-                            }
-
-                            auto t_recreate_end = clock::now();
-                            auto recreate_us = std::chrono::duration_cast<std::chrono::microseconds>(
-                                                    t_recreate_end - t_recreate_start).count();
-
-                            std::cerr << "[FxCli::UdpSocket] Socket recreated successfully ("
-                                      << recreate_us << " us elapsed)\n";
-                        } catch (const std::exception &e) {
-                            auto t_recreate_end = clock::now();
-                            auto recreate_us = std::chrono::duration_cast<std::chrono::microseconds>(
-                                                    t_recreate_end - t_recreate_start).count();
-
-                            std::cerr << "[FxCli::UdpSocket] Socket recreation failed after "
-                                      << recreate_us << " us: " << e.what() << "\n";
-                        }
-                        // ──────────────────────────────
+    /**
+     * 수신 가능한 패킷을 비-블로킹으로 모두 꺼내 태그 큐로 라우팅한다.
+     * 자체 RX 스레드 또는 FxPool의 공용 I/O 스레드에서 POLLIN 이후 호출.
+     */
+    void drain() {
+        using clock = std::chrono::steady_clock;
+        const auto RX_BUDGET = std::chrono::milliseconds(1);
+
+        // 2) drain 은 반드시 비-블로킹으로, 그리고 시간 제한!
+        const auto drain_deadline = clock::now() + RX_BUDGET;
+        const int sock = fd();
+        for (;;) {
+            if (clock::now() >= drain_deadline) break; // 예산 소진 → 즉시 탈출
+
+            // 비-블로킹 수신: 절대 기다리지 않음 (MSG_TRUNC → 잘린 경우 원래 길이 반환)
+            ssize_t n = ::recv(sock, rx_buf_.data(), rx_buf_.size(), MSG_DONTWAIT | MSG_TRUNC);
+            const int64_t rx_ns = mono_ns();
+            if (n < 0) {
+                int err = errno;
+                if (err == EAGAIN || err == EWOULDBLOCK || err == EINTR){
+                    break;
+                }
+                if (err == EBADF || err == ENOTCONN || err == ENETDOWN ||
+                    err == ECONNRESET || err == ECONNREFUSED || err == EPIPE) {
 
+                    if (!run_rx_.load(std::memory_order_acquire)) {
+                        std::cerr << "[FxCli::UdpSocket] Socket error during shutdown (errno=" << err << "), exiting...\n";
                         break;
                     }
+                    std::cerr << "[FxCli::UdpSocket] Detected bad socket (errno=" << err
+                              << "), attempting recreate...\n";
+
+                    // ──────────────────────────────
+                    //  소켓 재생성 시간 측정 시작
+                    // ──────────────────────────────
+                    auto t_recreate_start = clock::now();
+
+                    try {
+                        create_socket_or_throw();   // ✅ 새 fd는 다음 poll 주기에 fd()로 반영
+
+                        auto t_recreate_end = clock::now();
+                        auto recreate_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                                t_recreate_end - t_recreate_start).count();
+
+                        std::cerr << "[FxCli::UdpSocket] Socket recreated successfully ("
+                                  << recreate_us << " us elapsed)\n";
+                    } catch (const std::exception &e) {
+                        auto t_recreate_end = clock::now();
+                        auto recreate_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                                t_recreate_end - t_recreate_start).count();
+
+                        std::cerr << "[FxCli::UdpSocket] Socket recreation failed after "
+                                  << recreate_us << " us: " << e.what() << "\n";
+                    }
+                    // ──────────────────────────────
 
-                    std::cerr << "[FxCli::UdpSocket] recv() error " << err
-                              << ": " << strerror(err) << "\n";
-                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
                     break;
                 }
-                if (n == 0) break; // UDP에선 거의 없음
 
-                std::string pkt(buf.data(), buf.data() + n);
+                std::cerr << "[FxCli::UdpSocket] recv() error " << err
+                          << ": " << strerror(err) << "\n";
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                break;
+            }
+            if (n == 0) break; // UDP에선 거의 없음
 
-                // [CHANGED] 수신 즉시 태그 파싱 → 해당 태그 큐로 라우팅
-                if (auto* qdst = q_.select_by_packet(pkt)) {
-                    qdst->push(std::move(pkt));
-                } else {
-                    std::cerr << "[RX] drop unknown/invalid packet: " << pkt << "\n";
-                    continue;
-                }
+            // 길이/CRC 검사: 불량 프레임은 슬롯에 넣지 않고 버림 (파서까지 가지 않음)
+            size_t len = static_cast<size_t>(n);
+            if (len > rx_buf_.size()) {
+                truncated_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (crc_.load(std::memory_order_relaxed) && !crc32c::check_trailer(rx_buf_.data(), len)) {
+                crc_errors_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            std::string pkt(rx_buf_.data(), rx_buf_.data() + len);
+
+            // [CHANGED] 수신 즉시 태그 파싱 → 해당 태그 큐로 라우팅
+            if (auto* qdst = q_.select_by_packet(pkt)) {
+                qdst->push(std::move(pkt), rx_ns);
+            } else {
+                std::cerr << "[RX] drop unknown/invalid packet: " << pkt << "\n";
+                continue;
             }
         }
     }
+
+private:
+    std::array<char, 65536> rx_buf_;
 };
 
 
+// ──────────────── 명령 문자열 빌더 ────────────────
+namespace {
+
+static inline void append_id(std::string& cmd, uint8_t id) {
+    char ib[8]; int k = snprintf(ib, sizeof(ib), "%u", (unsigned)id);
+    cmd.append(ib, ib + k);
+}
+
+// "<id v0 v1 ...> <id ...>" 형태의 다중 모터 프레임
+static void build_motor_frames(std::string& cmd, const char* head,
+                               std::span<const uint8_t> ids,
+                               std::initializer_list<std::span<const float>> cols) {
+    const size_t n = ids.size();
+    for (const auto& c : cols)
+        if (c.size() != n)
+            throw std::invalid_argument("All parameter arrays must have the same length");
+    cmd.clear();
+    cmd.reserve((8 + 10 * cols.size()) * n + 16);
+    cmd.append(head);
+    char fb[32];
+    for (size_t i = 0; i < n; ++i) {
+        cmd.push_back('<');
+        append_id(cmd, ids[i]);
+        for (const auto& c : cols) {
+            cmd.push_back(' ');
+            cmd.append(format_float(fb, sizeof(fb), c[i]));
+        }
+        cmd.push_back('>');
+        if (i + 1 < n) cmd.push_back(' ');
+    }
+}
+
+} // namespace
+
+
 // ──────────────── FxCli ────────────────
-FxCli::FxCli(const std::string &ip, uint16_t port)
-: socket_(new UdpSocket(ip, port)) {}
+FxCli::FxCli(const std::string &ip, uint16_t port, bool own_rx_thread)
+: socket_(new UdpSocket(ip, port, own_rx_thread)) {}
 
 FxCli::~FxCli() {
     delete socket_;
 }
 
+int FxCli::rx_fd() { return socket_->fd(); }
+
+void FxCli::set_crc(bool on) { socket_->set_crc(on); }
+bool FxCli::crc() const { return socket_->crc(); }
+uint64_t FxCli::rx_crc_errors() const { return socket_->crc_errors(); }
+uint64_t FxCli::rx_truncated() const { return socket_->truncated(); }
+
+void FxCli::rx_drain() { socket_->drain(); }
+
 void FxCli::send_cmd(const std::string &cmd) {
     if (!socket_)
         throw std::runtime_error("socket not initialized");
@@ -600,6 +730,99 @@ bool FxCli::send_cmd_wait_ok_tag(const std::string& cmd, const char* expect_tag,
     return ok;
 }
 
+// ─────────────────────────────────────────────
+// Split-phase API (송신만 / 수집만)
+// ─────────────────────────────────────────────
+void FxCli::post_motor_cmd(const char* tag, const std::vector<uint8_t> &ids) {
+    socket_->flush_queue();      // Non-RT: send_cmd_wait_ok_tag와 동일하게 전체 초기화
+    send_cmd(std::string("AT+") + tag + " " + build_id_group(ids));
+}
+
+void FxCli::post_estop_nowait(const std::vector<uint8_t> &ids) {
+    send_cmd("AT+ESTOP " + build_id_group(ids));   // 태그 버퍼는 건드리지 않음 (진행 중인 수집 보존)
+}
+
+void FxCli::post_operation_control(std::span<const uint8_t> ids,
+                                   std::span<const float> pos,
+                                   std::span<const float> vel,
+                                   std::span<const float> kp,
+                                   std::span<const float> kd,
+                                   std::span<const float> tau) {
+    build_motor_frames(tx_buf_, "AT+MIT ", ids, {pos, vel, kp, kd, tau});
+    send_cmd(tx_buf_);
+}
+
+void FxCli::post_operation_control_compact(std::span<const uint8_t> ids,
+                                           std::span<const float> pos,
+                                           std::span<const float> vel,
+                                           std::span<const float> tau) {
+    build_motor_frames(tx_buf_, "AT+MITC ", ids, {pos, vel, tau});
+    send_cmd(tx_buf_);
+}
+
+void FxCli::post_gain_table(std::span<const uint8_t> ids,
+                            std::span<const float> kp,
+                            std::span<const float> kd) {
+    build_motor_frames(tx_buf_, "AT+GAIN ", ids, {kp, kd});
+    send_cmd(tx_buf_);
+}
+
+void FxCli::post_req(const std::vector<uint8_t> &ids, bool retransmit) {
+    if (retransmit) {
+        ++req_attempts_;
+        ++req_retries_;
+    } else {
+        socket_->flush_tag("REQ");   // 이전 틱의 늦은 응답을 이번 틱 데이터로 착각하지 않도록
+        req_attempts_ = 1;
+        req_sent_at_ = std::chrono::steady_clock::now();
+    }
+    // 보드의 id 목록은 고정 → 명령 문자열은 처음 한 번만 만들고 재송신에도 그대로 사용
+    if (req_cmd_.empty() || ids != req_ids_) {
+        req_ids_ = ids;
+        req_cmd_ = "AT+REQ " + build_id_group(ids);
+    }
+    send_cmd(req_cmd_);
+}
+
+void FxCli::post_status() {
+    send_cmd("AT+STATUS");
+}
+
+bool FxCli::collect(const char* tag, std::string& out,
+                    std::chrono::steady_clock::time_point deadline, int64_t* rx_ns) {
+    bool ok = socket_->wait_for_ok_tag_until(tag, out, deadline, rx_ns);
+    if (ok && req_attempts_ == 1 && std::strcmp(tag, "REQ") == 0) {
+        // Karn: 재송신한 REQ의 응답은 어느 송신에 대한 것인지 모호하므로 샘플에서 제외
+        const double r = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - req_sent_at_).count();
+        if (req_srtt_us_ == 0.0) {
+            req_srtt_us_ = r;
+            req_rttvar_us_ = r / 2;
+        } else {
+            req_rttvar_us_ = 0.75 * req_rttvar_us_ + 0.25 * std::abs(req_srtt_us_ - r);
+            req_srtt_us_   = 0.875 * req_srtt_us_ + 0.125 * r;
+        }
+    }
+    if (ok && std::strcmp(tag, "REQ") == 0) req_attempts_ = 0;
+    return ok;
+}
+
+void FxCli::set_req_retry(double control_period_ms, double slice) {
+    if (control_period_ms <= 0.0 || slice <= 0.0 || slice > 1.0)
+        throw std::invalid_argument("set_req_retry: period must be > 0 and slice in (0, 1]");
+    req_budget_ = std::chrono::microseconds(
+        static_cast<int64_t>(control_period_ms * slice * 1000.0));
+}
+
+std::chrono::microseconds FxCli::req_rto() const {
+    // 샘플이 없으면 예산의 절반 → 최소 1회 재송신 기회
+    const double rto = (req_srtt_us_ == 0.0)
+        ? static_cast<double>(req_budget_.count()) / 2
+        : req_srtt_us_ + 4.0 * req_rttvar_us_;
+    auto us = std::chrono::microseconds(static_cast<int64_t>(rto));
+    return std::clamp(us, kReqMinRto, std::max(kReqMinRto, req_budget_));
+}
+
 // ─────────────────────────────────────────────
 // 공개 API
 // ─────────────────────────────────────────────
@@ -636,26 +859,8 @@ bool FxCli::operation_control(const std::vector<uint8_t> &ids,
 #ifdef DEBUG
 g_timer_ack_mit.startTimer();
 #endif
-
-    const size_t n = ids.size();
-    if (!(pos.size() == n && vel.size() == n && kp.size() == n && kd.size() == n && tau.size() == n))
-        throw std::invalid_argument("All parameter arrays must have the same length");
-    std::string cmd; cmd.reserve(32 * n + 16);
-    cmd.append("AT+MIT ");
-    char fb[32];
-    for (size_t i = 0; i < n; ++i) {
-        cmd.push_back('<');
-        char ib[8]; int k = snprintf(ib, sizeof(ib), "%u", (unsigned)ids[i]);
-        cmd.append(ib, ib + k); cmd.push_back(' ');
-        cmd.append(format_float(fb, sizeof(fb), pos[i])); cmd.push_back(' ');
-        cmd.append(format_float(fb, sizeof(fb), vel[i])); cmd.push_back(' ');
-        cmd.append(format_float(fb, sizeof(fb), kp[i]));  cmd.push_back(' ');
-        cmd.append(format_float(fb, sizeof(fb), kd[i]));  cmd.push_back(' ');
-        cmd.append(format_float(fb, sizeof(fb), tau[i])); cmd.push_back('>');
-        if (i + 1 < n) cmd.push_back(' ');
-    }
+    post_operation_control(ids, pos, vel, kp, kd, tau);
     std::string out;
-    send_cmd(cmd);
     bool ok = socket_->wait_for_ok_tag("MIT", out, timeout_ms_rt_);
 #ifdef DEBUG
 g_timer_ack_mit.stopTimer();
@@ -664,13 +869,48 @@ g_timer_ack_mit.printLatest();
     return ok;
 }
 
+bool FxCli::set_gain_table(const std::vector<uint8_t> &ids,
+                           const std::vector<float> &kp,
+                           const std::vector<float> &kd) {
+    // RT 경로: flush/안정화 sleep 없이 GAIN 태그만 기다림
+    post_gain_table(ids, kp, kd);
+    std::string out;
+    return socket_->wait_for_ok_tag("GAIN", out, timeout_ms_rt_);
+}
+
+bool FxCli::operation_control_compact(const std::vector<uint8_t> &ids,
+                                      const std::vector<float> &pos,
+                                      const std::vector<float> &vel,
+                                      const std::vector<float> &tau) {
+#ifdef DEBUG
+g_timer_ack_mit.startTimer();
+#endif
+    post_operation_control_compact(ids, pos, vel, tau);
+    std::string out;
+    bool ok = socket_->wait_for_ok_tag("MITC", out, timeout_ms_rt_);
+#ifdef DEBUG
+g_timer_ack_mit.stopTimer();
+g_timer_ack_mit.printLatest();
+#endif
+    return ok;
+}
+
 std::string FxCli::req(const std::vector<uint8_t> &ids) {
 #ifdef DEBUG
 g_timer_ack_req.startTimer();
 #endif
+    using clock = std::chrono::steady_clock;
+    const auto deadline = clock::now() + req_budget_;
     std::string out;
-    send_cmd("AT+REQ " + build_id_group(ids));
-    bool ok = socket_->wait_for_ok_tag("REQ", out, timeout_ms_rt_);
+    post_req(ids);
+    bool ok = false;
+    for (;;) {
+        // 추정 RTT 안에 응답이 없으면 남은 예산 안에서 즉시 재송신
+        const auto until = std::min(deadline, clock::now() + req_rto());
+        if ((ok = collect("REQ", out, until))) break;
+        if (clock::now() >= deadline) break;
+        post_req(ids, /*retransmit=*/true);
+    }
 #ifdef DEBUG
 g_timer_ack_req.stopTimer();
 g_timer_ack_req.printLatest();
@@ -680,7 +920,7 @@ g_timer_ack_req.printLatest();
 
 std::string FxCli::status() {
     std::string out;
-    send_cmd("AT+STATUS");
+    post_status();
     bool ok = socket_->wait_for_ok_tag("STATUS", out, timeout_ms_rt_);
     return ok ? out : std::string();
 }
@@ -691,4 +931,4 @@ void FxCli::flush() {
 #ifdef DEBUG
     FXCLI_LOG("[FLUSH] queue cleared");
 #endif
-}
\ No newline at end of file
+}
@@ -0,0 +1,308 @@
+// fx_emulator.cpp
+
+#include "fx_emulator.hpp"
+#include "crc32c.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+// 간단한 관절 모델 파라미터
+constexpr float kInertia  = 0.02f;  // kg·m²
+constexpr float kFriction = 0.05f;  // N·m·s/rad
+constexpr float kSubStep  = 0.001f; // s
+constexpr float kMaxGap   = 0.05f;  // s, 명령 간격이 길어도 이 이상은 적분하지 않음
+
+// "<a b c ...>" 그룹을 하나씩 꺼낸다. vals에 최대 max_vals개 채우고 개수 반환, 그룹이 없으면 -1
+static int next_group(const char*& p, float* vals, int max_vals) {
+    const char* l = std::strchr(p, '<');
+    if (!l) return -1;
+    const char* r = std::strchr(l, '>');
+    if (!r) return -1;
+    int n = 0;
+    const char* c = l + 1;
+    while (c < r && n < max_vals) {
+        char* end = nullptr;
+        float v = std::strtof(c, &end);
+        if (end == c) break;
+        vals[n++] = v;
+        c = end;
+    }
+    p = r + 1;
+    return n;
+}
+
+static inline void append_kv(std::string& s, const char* key, float v) {
+    char buf[48];
+    int n = std::snprintf(buf, sizeof(buf), "%s%.6f", key, v);
+    s.append(buf, buf + n);
+}
+
+} // namespace
+
+
+FxEmulator::FxEmulator(const Options& opt) : opt_(opt) {
+    motors_.resize(opt_.motor_ids.size());
+    for (size_t i = 0; i < motors_.size(); ++i) motors_[i].id = opt_.motor_ids[i];
+
+    sock_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock_ < 0) throw std::runtime_error("socket() failed");
+
+    int yes = 1;
+    ::setsockopt(sock_, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port   = htons(opt_.port);
+    if (::inet_pton(AF_INET, opt_.bind_ip.c_str(), &addr.sin_addr) != 1) {
+        ::close(sock_);
+        throw std::runtime_error("inet_pton failed: " + opt_.bind_ip);
+    }
+    if (::bind(sock_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        int err = errno;
+        ::close(sock_);
+        throw std::runtime_error("bind() failed: " + std::string(strerror(err)));
+    }
+    last_step_ = std::chrono::steady_clock::now();
+}
+
+FxEmulator::~FxEmulator() {
+    stop();
+    if (sock_ >= 0) ::close(sock_);
+}
+
+void FxEmulator::start() {
+    if (run_.exchange(true)) return;
+    thread_ = std::thread(&FxEmulator::serve, this);
+}
+
+void FxEmulator::stop() {
+    run_.store(false, std::memory_order_release);
+    if (thread_.joinable()) thread_.join();
+}
+
+FxEmulator::Motor* FxEmulator::find_motor(unsigned id) {
+    for (auto& m : motors_) if (m.id == id) return &m;
+    return nullptr;
+}
+
+void FxEmulator::advance() {
+    const auto now = std::chrono::steady_clock::now();
+    float dt = std::chrono::duration<float>(now - last_step_).count();
+    last_step_ = now;
+    dt = std::min(dt, kMaxGap);
+
+    while (dt > 0.0f) {
+        const float h = std::min(dt, kSubStep);
+        for (auto& m : motors_) {
+            float tq = 0.0f;
+            if (m.running) tq = m.kp * (m.p_des - m.p) + m.kd * (m.v_des - m.v) + m.tau;
+            m.t = tq;
+            m.v += (tq - kFriction * m.v) / kInertia * h;
+            m.p += m.v * h;
+        }
+        dt -= h;
+    }
+}
+
+void FxEmulator::reply_req(const char* args, std::string& reply) {
+    reply.assign("OK <REQ>");
+    // 요청된 id 순서대로 응답 (그룹이 없으면 전체)
+    float ids[32];
+    const char* p = args;
+    int n = next_group(p, ids, 32);
+    if (n < 0) {
+        n = static_cast<int>(std::min<size_t>(motors_.size(), 32));
+        for (int i = 0; i < n; ++i) ids[i] = motors_[i].id;
+    }
+    for (int i = 0; i < n; ++i) {
+        const Motor* m = find_motor(static_cast<unsigned>(ids[i]));
+        char hdr[16];
+        int k = std::snprintf(hdr, sizeof(hdr), " M%u ", static_cast<unsigned>(ids[i]));
+        reply.append(hdr, hdr + k);
+        if (!m) { reply.append("p:N v:N t:N;"); continue; }
+        append_kv(reply, "p:", m->p); reply.push_back(' ');
+        append_kv(reply, "v:", m->v); reply.push_back(' ');
+        append_kv(reply, "t:", m->t); reply.push_back(';');
+    }
+    if (opt_.imu) {
+        // 정지 상태 IMU: 각속도 0, 중력은 -z
+        reply.append(" IMU gx:0.000000 gy:0.000000 gz:0.000000"
+                     " pgx:0.000000 pgy:0.000000 pgz:-1.000000;");
+    }
+    char seq[40];
+    int k = std::snprintf(seq, sizeof(seq), " SEQ_NUM: cnt:%llu;",
+                          static_cast<unsigned long long>(++req_seq_));
+    reply.append(seq, seq + k);
+}
+
+void FxEmulator::reply_status(std::string& reply) {
+    reply.assign("OK <STATUS>");
+    for (const auto& m : motors_) {
+        char buf[48];
+        int k = std::snprintf(buf, sizeof(buf), " M%u pattern:%d err:0;",
+                              static_cast<unsigned>(m.id), m.running ? 2 : 0);
+        reply.append(buf, buf + k);
+    }
+    reply.append(" EMERGENCY value:off;");
+    char seq[40];
+    int k = std::snprintf(seq, sizeof(seq), " SEQ_NUM: cnt:%llu;",
+                          static_cast<unsigned long long>(++status_seq_));
+    reply.append(seq, seq + k);
+}
+
+void FxEmulator::handle(const char* data, size_t len, std::string& reply) {
+    reply.clear();
+    std::string cmd(data, len);
+    if (cmd.size() < 3 || ::strncasecmp(cmd.c_str(), "AT+", 3) != 0) return;
+
+    // 명령어 단어와 인자 분리
+    const char* c = cmd.c_str() + 3;
+    const char* sp = std::strchr(c, ' ');
+    std::string word = sp ? std::string(c, sp) : std::string(c);
+    const char* args = sp ? sp : "";
+    for (auto& ch : word) ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+
+    advance();
+
+    float v[8];
+    if (word == "PING") {
+        reply = "OK <PING>";
+    } else if (word == "WHOAMI") {
+        reply = "OK <WHOAMI> fx-emulator";
+    } else if (word == "START" || word == "STOP" || word == "ESTOP" || word == "SETZERO") {
+        // <1 2 3 ...> 한 그룹에 id 목록
+        float ids[32];
+        const char* p = args;
+        int n = std::max(next_group(p, ids, 32), 0);
+        for (int i = 0; i < n; ++i) {
+            Motor* m = find_motor(static_cast<unsigned>(ids[i]));
+            if (!m) continue;
+            if (word == "START") {
+                m->running = true;
+            } else if (word == "SETZERO") {
+                m->p = 0.0f;
+            } else {
+                m->running = false;
+                m->kp = m->kd = m->tau = 0.0f;
+            }
+        }
+        if (word == "ESTOP") {
+            estop_count_.fetch_add(1, std::memory_order_relaxed);
+            last_estop_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+        }
+        reply = "OK <" + word + ">";
+    } else if (word == "MIT") {
+        const char* p = args;
+        while (next_group(p, v, 6) == 6) {
+            if (Motor* m = find_motor(static_cast<unsigned>(v[0]))) {
+                m->p_des = v[1]; m->v_des = v[2];
+                m->kp = v[3]; m->kd = v[4]; m->tau = v[5];
+            }
+        }
+        reply = "OK <MIT>";
+    } else if ((word == "GAIN" || word == "MITC") && !opt_.gain_table) {
+        return;   // gain table 이전 펌웨어: 모르는 명령 → 응답 없음
+    } else if (word == "GAIN") {
+        const char* p = args;
+        while (next_group(p, v, 3) == 3) {
+            if (Motor* m = find_motor(static_cast<unsigned>(v[0]))) {
+                m->kp = v[1]; m->kd = v[2];
+            }
+        }
+        reply = "OK <GAIN>";
+    } else if (word == "MITC") {
+        const char* p = args;
+        while (next_group(p, v, 4) == 4) {
+            if (Motor* m = find_motor(static_cast<unsigned>(v[0]))) {
+                m->p_des = v[1]; m->v_des = v[2]; m->tau = v[3];
+            }
+        }
+        reply = "OK <MITC>";
+    } else if (word == "REQ") {
+        reply_req(args, reply);
+    } else if (word == "STATUS") {
+        reply_status(reply);
+    }
+}
+
+void FxEmulator::serve() {
+    pollfd pfd{};
+    pfd.fd = sock_;
+    pfd.events = POLLIN;
+
+    while (run_.load(std::memory_order_acquire)) {
+        int r = ::poll(&pfd, 1, /*timeout_ms=*/50);
+        if (r <= 0 || !(pfd.revents & POLLIN)) continue;
+        serve_one();
+    }
+}
+
+void FxEmulator::serve_all(const std::vector<FxEmulator*>& boards, const std::atomic<bool>& run) {
+    std::vector<pollfd> pfds(boards.size());
+    for (size_t i = 0; i < boards.size(); ++i) {
+        pfds[i].fd = boards[i]->sock_;
+        pfds[i].events = POLLIN;
+    }
+
+    while (run.load(std::memory_order_acquire)) {
+        int r = ::poll(pfds.data(), pfds.size(), /*timeout_ms=*/50);
+        if (r <= 0) continue;
+        for (size_t i = 0; i < boards.size(); ++i) {
+            if (pfds[i].revents & POLLIN) boards[i]->serve_one();
+        }
+    }
+}
+
+void FxEmulator::serve_one() {
+    sockaddr_in peer{};
+    socklen_t plen = sizeof(peer);
+    ssize_t n = ::recvfrom(sock_, rx_buf_, sizeof(rx_buf_), MSG_DONTWAIT,
+                           reinterpret_cast<sockaddr*>(&peer), &plen);
+    if (n <= 0) return;
+    rx_count_.fetch_add(1, std::memory_order_relaxed);
+    if (opt_.loss > 0.0 && uni_(rng_) < opt_.loss) return;   // 링크 손실 모사
+
+    // CRC trailer가 붙어 오면 검사 후 떼어내고, 응답에도 붙인다
+    size_t len = static_cast<size_t>(n);
+    const bool has_trailer = len >= crc32c::kTrailerLen &&
+                             rx_buf_[len - crc32c::kTrailerLen] == ' ' &&
+                             rx_buf_[len - crc32c::kTrailerLen + 1] == '*';
+    if (has_trailer && !crc32c::check_trailer(rx_buf_, len)) {
+        crc_errors_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    handle(rx_buf_, len, reply_);
+    if (reply_.empty()) return;
+
+    if (has_trailer) {
+        char trailer[crc32c::kTrailerLen];
+        crc32c::make_trailer(reply_.data(), reply_.size(), trailer);
+        reply_.append(trailer, sizeof(trailer));
+    }
+    if (opt_.corrupt > 0.0 && uni_(rng_) < opt_.corrupt) {
+        // 전송 중 비트 오류 모사 (trailer 앞쪽 payload 한 바이트)
+        size_t i = static_cast<size_t>(uni_(rng_) * static_cast<double>(reply_.size()));
+        reply_[std::min(i, reply_.size() - 1)] ^= 0x20;
+    }
+
+    if (::sendto(sock_, reply_.data(), reply_.size(), 0,
+                 reinterpret_cast<sockaddr*>(&peer), plen) > 0) {
+        tx_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
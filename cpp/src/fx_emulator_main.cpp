@@ -0,0 +1,124 @@
+// fx_emulator_main.cpp
+//
+// Usage:
+//   fx_emulator [--bind 127.0.0.1] [--port 5101] [--ids 1-8 | --ids 1,2,3] [--no-imu] [--no-gain] [--loss P] [--corrupt P]
+//   fx_emulator [--bind 127.0.0.1] [--no-gain] [--loss P] [--corrupt P] --board PORT:IDS[:noimu] [--board ...]
+//
+// --loss P: 수신한 명령을 확률 P로 무시 (응답 없음) → REQ 재송신/disconnect 경로 시험용
+// --corrupt P: 응답 한 바이트를 확률 P로 변조 → CRC 검사 경로 시험용
+// --no-gain: AT+GAIN / AT+MITC에 응답하지 않음 (gain table 이전 펌웨어) → full MIT 대체 경로 시험용
+//
+// --board 를 여러 번 주면 보드 N개를 스레드 하나로 서빙한다 (front/rear, 24모터 변형, 여러 로봇):
+//   fx_emulator --board 5101:1-8:noimu --board 5102:9-16
+
+#include "fx_emulator.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<bool> g_run{true};
+
+void on_signal(int) { g_run.store(false); }
+
+// "1-8" 또는 "1,2,3" 형태
+std::vector<uint8_t> parse_ids(const std::string& s) {
+    std::vector<uint8_t> ids;
+    size_t dash = s.find('-');
+    if (dash != std::string::npos) {
+        int a = std::atoi(s.substr(0, dash).c_str());
+        int b = std::atoi(s.substr(dash + 1).c_str());
+        for (int i = a; i <= b; ++i) ids.push_back(static_cast<uint8_t>(i));
+        return ids;
+    }
+    size_t cur = 0;
+    while (cur < s.size()) {
+        size_t comma = s.find(',', cur);
+        if (comma == std::string::npos) comma = s.size();
+        ids.push_back(static_cast<uint8_t>(std::atoi(s.substr(cur, comma - cur).c_str())));
+        cur = comma + 1;
+    }
+    return ids;
+}
+
+// "5101:1-8" 또는 "5101:1-8:noimu"
+FxEmulator::Options parse_board(const std::string& s, const FxEmulator::Options& base) {
+    FxEmulator::Options o = base;
+    o.imu = true;
+    size_t c1 = s.find(':');
+    if (c1 == std::string::npos) { std::cerr << "bad --board: " << s << "\n"; std::exit(2); }
+    size_t c2 = s.find(':', c1 + 1);
+    o.port = static_cast<uint16_t>(std::atoi(s.substr(0, c1).c_str()));
+    o.motor_ids = parse_ids(s.substr(c1 + 1, c2 == std::string::npos ? std::string::npos : c2 - c1 - 1));
+    if (c2 != std::string::npos && s.substr(c2 + 1) == "noimu") o.imu = false;
+    return o;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    FxEmulator::Options opt;
+    std::vector<std::string> board_args;
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) { std::cerr << "missing value for " << a << "\n"; std::exit(2); }
+            return argv[++i];
+        };
+        if      (!std::strcmp(a, "--bind"))   opt.bind_ip = next();
+        else if (!std::strcmp(a, "--port"))   opt.port = static_cast<uint16_t>(std::atoi(next()));
+        else if (!std::strcmp(a, "--ids"))    opt.motor_ids = parse_ids(next());
+        else if (!std::strcmp(a, "--no-imu")) opt.imu = false;
+        else if (!std::strcmp(a, "--no-gain")) opt.gain_table = false;
+        else if (!std::strcmp(a, "--loss"))   opt.loss = std::atof(next());
+        else if (!std::strcmp(a, "--corrupt")) opt.corrupt = std::atof(next());
+        else if (!std::strcmp(a, "--board"))  board_args.push_back(next());
+        else {
+            std::cerr << "usage: " << argv[0]
+                      << " [--bind IP] [--port N] [--ids 1-8|1,2,3] [--no-imu] [--no-gain] [--loss P] [--corrupt P]"
+                      << " | [--bind IP] [--no-gain] [--loss P] [--corrupt P] --board PORT:IDS[:noimu] ...\n";
+            return 2;
+        }
+    }
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    if (!board_args.empty()) {
+        std::vector<std::unique_ptr<FxEmulator>> emus;
+        std::vector<FxEmulator*> ptrs;
+        for (const auto& b : board_args) {
+            auto o = parse_board(b, opt);
+            emus.push_back(std::make_unique<FxEmulator>(o));
+            ptrs.push_back(emus.back().get());
+            std::cerr << "[fx_emulator] board " << o.bind_ip << ":" << o.port
+                      << " (" << o.motor_ids.size() << " motors)\n";
+        }
+        FxEmulator::serve_all(ptrs, g_run);
+        for (auto* e : ptrs)
+            std::cerr << "[fx_emulator] :" << e->port() << " rx=" << e->rx_count()
+                      << " tx=" << e->tx_count() << " crc_err=" << e->crc_errors() << "\n";
+        return 0;
+    }
+
+    FxEmulator emu(opt);
+    emu.start();
+    std::cerr << "[fx_emulator] listening on " << opt.bind_ip << ":" << opt.port
+              << " (" << opt.motor_ids.size() << " motors)\n";
+
+    while (g_run.load()) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    emu.stop();
+    std::cerr << "[fx_emulator] rx=" << emu.rx_count() << " tx=" << emu.tx_count()
+              << " crc_err=" << emu.crc_errors() << "\n";
+    return 0;
+}
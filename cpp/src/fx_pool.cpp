@@ -0,0 +1,146 @@
+// fx_pool.cpp
+
+#include "fx_pool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <poll.h>
+
+FxPool::FxPool() {
+    run_.store(true);
+    io_thread_ = std::thread(&FxPool::io_loop, this);
+}
+
+FxPool::FxPool(const std::vector<FxBoard>& boards) : FxPool() {
+    for (const auto& b : boards) add_board(b);
+}
+
+FxPool::~FxPool() {
+    run_.store(false, std::memory_order_release);
+    if (io_thread_.joinable()) io_thread_.join();
+    // clis_ 소멸 시 소켓 close (I/O 스레드가 이미 멈춘 뒤)
+}
+
+size_t FxPool::add_board(const FxBoard& board) {
+    auto cli = std::make_unique<FxCli>(board.ip, board.port, /*own_rx_thread=*/false);
+    cli->set_crc(board.crc);
+    std::lock_guard<std::mutex> lk(boards_mtx_);
+    clis_.push_back(std::move(cli));
+    boards_.push_back(board);
+    gen_.fetch_add(1, std::memory_order_release);
+    return clis_.size() - 1;
+}
+
+size_t FxPool::size() const {
+    std::lock_guard<std::mutex> lk(boards_mtx_);
+    return clis_.size();
+}
+
+FxCli& FxPool::cli(size_t b) {
+    std::lock_guard<std::mutex> lk(boards_mtx_);
+    if (b >= clis_.size()) throw std::out_of_range("FxPool: board index out of range");
+    return *clis_[b];
+}
+
+const FxBoard& FxPool::board(size_t b) const {
+    std::lock_guard<std::mutex> lk(boards_mtx_);
+    if (b >= boards_.size()) throw std::out_of_range("FxPool: board index out of range");
+    return boards_[b];
+}
+
+size_t FxPool::motor_count(const Boards& bs) const {
+    size_t n = 0;
+    for (size_t b : bs) n += board(b).motor_ids.size();
+    return n;
+}
+
+size_t FxPool::req(const Boards& bs, std::vector<std::string>& out, std::vector<int64_t>* rx_ns) {
+    using clock = std::chrono::steady_clock;
+    out.resize(bs.size());
+    for (auto& s : out) s.clear();   // 용량 유지 (호출자 버퍼 재사용)
+    if (rx_ns) rx_ns->assign(bs.size(), 0);
+    if (bs.empty()) return 0;
+
+    // 미수신 보드 목록: 틱마다 호출되므로 용량 재사용. 풀은 여러 Robot(스레드)이 함께 쓰므로
+    // 멤버가 아니라 스레드별 (transact의 scratch와 같은 방식)
+    thread_local std::vector<size_t> pending, next;
+    const auto deadline = clock::now() + cli(bs[0]).req_budget();
+    pending.resize(bs.size());
+    for (size_t k = 0; k < bs.size(); ++k) {
+        pending[k] = k;
+        cli(bs[k]).post_req(board(bs[k]).motor_ids);
+    }
+
+    // 라운드: 남은 보드 중 가장 긴 RTO까지 수집 → 못 받은 보드만 즉시 재송신
+    for (;;) {
+        auto rto = std::chrono::microseconds(0);
+        for (size_t k : pending) rto = std::max(rto, cli(bs[k]).req_rto());
+        const auto until = std::min(deadline, clock::now() + rto);
+
+        next.clear();
+        for (size_t k : pending) {
+            if (!cli(bs[k]).collect("REQ", out[k], until, rx_ns ? &(*rx_ns)[k] : nullptr)) {
+                out[k].clear();
+                next.push_back(k);
+            }
+        }
+        pending.swap(next);
+        if (pending.empty() || clock::now() >= deadline) break;
+        for (size_t k : pending) cli(bs[k]).post_req(board(bs[k]).motor_ids, /*retransmit=*/true);
+    }
+    return bs.size() - pending.size();
+}
+
+size_t FxPool::status(const Boards& bs, std::vector<std::string>& out) {
+    if (bs.empty()) { out.clear(); return 0; }
+    const int timeout = cli(bs[0]).timeout_ms_rt();
+    return transact(bs, "STATUS", timeout,
+                    [&](FxCli& c, size_t) { c.post_status(); },
+                    &out);
+}
+
+size_t FxPool::motor_cmd(const Boards& bs, const char* tag, std::vector<char>* ok) {
+    if (bs.empty()) { if (ok) ok->clear(); return 0; }
+    const int timeout = cli(bs[0]).timeout_ms();
+    size_t n_ok = transact(bs, tag, timeout,
+                           [&](FxCli& c, size_t k) { c.post_motor_cmd(tag, board(bs[k]).motor_ids); },
+                           nullptr, ok);
+    if (n_ok > 0) std::this_thread::sleep_for(std::chrono::milliseconds(1000)); // ✅ Non-RT 안정화 (1회)
+    return n_ok;
+}
+
+void FxPool::io_loop() {
+    // prio, cpu_index는 환경 맞춰 조정
+    //set_thread_rt_and_affinity(/*fifo_prio=*/85, /*cpu_index=*/4);
+    std::vector<FxCli*> clis;
+    std::vector<pollfd> pfds;
+    uint64_t seen_gen = ~0ull;
+
+    while (run_.load(std::memory_order_acquire)) {
+        const uint64_t g = gen_.load(std::memory_order_acquire);
+        if (g != seen_gen) {
+            std::lock_guard<std::mutex> lk(boards_mtx_);
+            clis.clear();
+            for (auto& c : clis_) clis.push_back(c.get());
+            pfds.assign(clis.size(), pollfd{ -1, POLLIN, 0 });
+            seen_gen = g;
+        }
+        if (clis.empty()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        // 소켓이 재생성되었을 수 있으므로 매 주기 fd 갱신
+        for (size_t i = 0; i < clis.size(); ++i) {
+            pfds[i].fd = clis[i]->rx_fd();
+            pfds[i].revents = 0;
+        }
+        int r = ::poll(pfds.data(), pfds.size(), /*timeout_ms=*/1);
+        if (r <= 0) continue;
+
+        for (size_t i = 0; i < clis.size(); ++i) {
+            if (pfds[i].revents & POLLIN) clis[i]->rx_drain();
+        }
+    }
+}
@@ -2,16 +2,24 @@
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 #include "rl.hpp"
+#include "obs_frame_bindings.hpp"
 
 namespace py = pybind11;
 
 PYBIND11_MODULE(rl, m) {
     m.doc() = "C++ port of rl.py";
 
+    // 관측 타입 (robot 모듈과 같은 Python 타입을 공유)
+    bind_obs_frame(m);
+
     py::class_<rl::RL>(m, "RL")
       .def(py::init<>())
       .def("add_mode", &rl::RL::add_mode, py::arg("mode"))
       .def("set_mode", &rl::RL::set_mode, py::arg("mode_id") = py::none())
-      .def("build_state", &rl::RL::build_state, py::arg("obs"), py::arg("cmd"), py::arg("scaled_last_action") = py::none())
+      // ObsFrame 오버로드를 먼저 등록 (dict보다 우선 매칭)
+      .def("build_state", py::overload_cast<const ObsFrame&, const py::dict&, py::object>(&rl::RL::build_state),
+           py::arg("obs"), py::arg("cmd"), py::arg("scaled_last_action") = py::none())
+      .def("build_state", py::overload_cast<const py::dict&, const py::dict&, py::object>(&rl::RL::build_state),
+           py::arg("obs"), py::arg("cmd"), py::arg("scaled_last_action") = py::none())
       .def("select_action", &rl::RL::select_action, py::arg("state"));
 }
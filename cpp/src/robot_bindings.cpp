@@ -1,10 +1,118 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+
 #include "robot.hpp"
+#include "sim_backend.hpp"
+#include "replay_backend.hpp"
+#include "control_loop.hpp"
+#include "obs_frame_bindings.hpp"
 
 namespace py = pybind11;
 using namespace robot;
 
+namespace {
+
+// GIL을 놓고 Robot 호출 직렬화 잠금을 잡은 채로 f 실행.
+// 순서 주의: GIL을 먼저 놓고 잠금을 기다려야 다른 스레드와 교착되지 않는다.
+template <class F>
+decltype(auto) nogil(Robot& self, F&& f) {
+    py::gil_scoped_release release;
+    std::lock_guard<std::mutex> lk(self.call_mutex());
+    return f();
+}
+
+using farray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+
+// 루프 스레드가 step에서 GIL을 기다릴 수 있으므로 GIL을 놓고 join한 뒤,
+// Python 객체(step이 잡은 rl)는 GIL을 다시 잡고 해제한다.
+struct LoopDeleter {
+    void operator()(ControlLoop* p) const {
+        {
+            py::gil_scoped_release release;
+            p->stop();
+        }
+        delete p;
+    }
+};
+
+// joystick.get_cmd() 형식: {"cmd_vector": [...], "mode_id": int|None, ...} 또는 시퀀스
+LoopCommand to_loop_command(py::handle src) {
+    LoopCommand c{};
+    c.mode_id = -1;
+    py::object vec = py::reinterpret_borrow<py::object>(src);
+    if (py::isinstance<py::dict>(src)) {
+        py::dict d = py::reinterpret_borrow<py::dict>(src);
+        vec = d.contains("cmd_vector") ? py::object(d["cmd_vector"]) : py::object(py::none());
+        if (d.contains("mode_id") && !d["mode_id"].is_none()) c.mode_id = d["mode_id"].cast<int32_t>();
+    }
+    if (!vec.is_none()) {
+        farray a = farray::ensure(vec);
+        if (!a || a.ndim() != 1) throw py::value_error("cmd_vector must be a 1D array/list");
+        if (static_cast<size_t>(a.size()) > LoopCommand::kMaxCmd)
+            throw py::value_error("cmd_vector length must be <= " + std::to_string(LoopCommand::kMaxCmd));
+        c.cmd_len = static_cast<uint32_t>(a.size());
+        std::copy(a.data(), a.data() + a.size(), c.cmd);
+    }
+    return c;
+}
+
+// Robot.sim()/replay()의 virtual_time 인자 → nullptr이면 시스템 시계
+std::shared_ptr<rt::Clock> virtual_clock(bool on) {
+    return on ? std::make_shared<rt::VirtualClock>() : nullptr;
+}
+
+// 루프 스레드에서 호출: GIL을 잡고 rl.build_state → rl.select_action 실행.
+// 관측은 복사본을 넘긴다 (루프 내부 프레임을 가리키는 뷰가 Python 쪽에 남지 않도록).
+ControlLoop::Step rl_step(py::object rl) {
+    return [rl = std::move(rl)](const ObsFrame& obs, const LoopCommand& c, std::span<float> action) {
+        py::gil_scoped_acquire gil;
+        try {
+            py::dict cmd;
+            py::list v(c.cmd_len);
+            for (uint32_t i = 0; i < c.cmd_len; ++i) v[i] = py::float_(c.cmd[i]);
+            cmd["cmd_vector"] = v;
+            if (c.mode_id >= 0) cmd["mode_id"] = c.mode_id;
+
+            py::object state = rl.attr("build_state")(obs, cmd);
+            farray a = farray::ensure(rl.attr("select_action")(state));
+            if (!a || a.ndim() != 1 || static_cast<size_t>(a.size()) != action.size())
+                throw std::runtime_error("select_action must return a 1D array of length " + std::to_string(action.size()));
+            std::copy(a.data(), a.data() + a.size(), action.begin());
+        } catch (py::error_already_set& e) {
+            throw std::runtime_error(e.what());   // Python 오류 상태는 GIL 안에서 정리
+        }
+    };
+}
+
+py::dict telemetry_dict(const LoopTelemetry& t) {
+    py::dict d;
+    d["tick"] = t.tick;
+    d["overruns"] = t.overruns;
+    d["jitter_us"] = t.jitter_ns / 1000.0;
+    d["max_jitter_us"] = t.max_jitter_ns / 1000.0;
+    d["step_us"] = t.step_ns / 1000.0;
+    d["policy_tick"] = t.policy_tick;
+    d["policy_overruns"] = t.policy_overruns;
+    d["policy_step_us"] = t.policy_step_ns / 1000.0;
+    d["obs_to_action_us"] = t.obs_to_action_ns / 1000.0;
+    d["max_obs_to_action_us"] = t.max_obs_to_action_ns / 1000.0;
+    d["running"] = t.running != 0;
+    d["waking"] = t.waking != 0;
+    d["action"] = farray(ObsFrame::kLastAction, t.action);
+    d["obs"] = t.obs;
+    return d;
+}
+
+} // namespace
+
 PYBIND11_MODULE(robot, m) {
     m.doc() = "C++ port of robot.py";
 
@@ -13,32 +121,422 @@ PYBIND11_MODULE(robot, m) {
     py::register_exception<RobotSetGainsError>(m, "RobotSetGainsError");
     py::register_exception<RobotSleepError>(m, "RobotSleepError");
 
-    py::class_<Robot>(m, "Robot")
+    // 관측 타입 (rl 모듈과 같은 Python 타입을 공유)
+    bind_obs_frame(m);
+
+    py::class_<FxBoard>(m, "FxBoard")
+        .def(py::init<>())
+        .def(py::init([](std::string ip, uint16_t port, std::vector<uint8_t> ids, bool crc, bool gain_table) {
+                 return FxBoard{std::move(ip), port, std::move(ids), crc, gain_table};
+             }),
+             py::arg("ip"), py::arg("port"), py::arg("motor_ids"), py::arg("crc") = false,
+             py::arg("gain_table") = true)
+        .def_readwrite("ip", &FxBoard::ip)
+        .def_readwrite("port", &FxBoard::port)
+        .def_readwrite("motor_ids", &FxBoard::motor_ids)
+        .def_readwrite("crc", &FxBoard::crc)
+        .def_readwrite("gain_table", &FxBoard::gain_table);
+
+    // 여러 Robot이 하나의 I/O 스레드를 공유할 때 사용
+    py::class_<FxPool, std::shared_ptr<FxPool>>(m, "FxPool")
         .def(py::init<>())
+        .def("size", &FxPool::size);
+
+    // 블로킹 호출(UDP 왕복, wake 램프, _wait)은 GIL을 놓고 실행 → 조이스틱/로거 스레드가 멈추지 않음.
+    // 대신 같은 Robot을 여러 Python 스레드가 부를 수 있으므로 call_mutex()로 직렬화한다.
+    // Python 객체 변환(인자 캐스팅, 반환값 래핑)은 GIL을 잡은 채 바깥에서 한다.
+    py::class_<Robot>(m, "Robot")
+        .def(py::init<>(), py::call_guard<py::gil_scoped_release>())
+        .def(py::init<const std::vector<FxBoard>&>(), py::arg("boards"),
+             py::call_guard<py::gil_scoped_release>())
+        .def(py::init<std::shared_ptr<FxPool>, const std::vector<FxBoard>&>(),
+             py::arg("pool"), py::arg("boards"), py::call_guard<py::gil_scoped_release>())
+
+        // 하드웨어 없이: 시뮬레이션 plant (req()마다 dt_ms씩 진행 → 실시간보다 빠르게 돌릴 수 있음)
+        .def_static("sim",
+             [](double dt_ms, int substeps, double gravity_load, double pos_noise, double vel_noise, uint32_t seed,
+                bool virtual_time) {
+                 SimOptions o;
+                 o.dt_ms = dt_ms; o.substeps = substeps; o.gravity_load = gravity_load;
+                 o.pos_noise = pos_noise; o.vel_noise = vel_noise; o.seed = seed;
+                 return std::make_unique<Robot>(std::make_unique<SimBackend>(o), virtual_clock(virtual_time));
+             },
+             py::arg("dt_ms") = 20.0, py::arg("substeps") = 20, py::arg("gravity_load") = 0.0,
+             py::arg("pos_noise") = 0.0, py::arg("vel_noise") = 0.0, py::arg("seed") = 1,
+             py::arg("virtual_time") = false, py::call_guard<py::gil_scoped_release>(),
+             "Robot on an in-process simulated plant (lockstep: each get_obs advances dt_ms).\n"
+             "virtual_time=True: sleeps/timeouts jump a virtual clock instead of blocking")
+        // Robot.record()로 남긴 REQ 기록 재생
+        .def_static("replay",
+             [](const std::string& path, bool loop, bool virtual_time) {
+                 std::vector<std::vector<uint8_t>> ids;
+                 for (const auto& b : Robot::default_boards()) ids.push_back(b.motor_ids);
+                 return std::make_unique<Robot>(ReplayBackend::load(path, std::move(ids), loop), virtual_clock(virtual_time));
+             },
+             py::arg("path"), py::arg("loop") = false, py::arg("virtual_time") = false,
+             py::call_guard<py::gil_scoped_release>(),
+             "Robot replaying a recording written by Robot.record() (default board layout)")
 
-        .def("set_gains", &Robot::set_gains, py::arg("kp"), py::arg("kd"),
-             "Set PD gains")
+        // Robot 시계 (가상 시계면 sleep_until은 즉시 반환하며 시각만 진행) — call_mutex 불필요
+        .def("now_ns", [](const Robot& self) { return self.clock()->now_ns(); })
+        .def("sleep_until",
+             [](Robot& self, int64_t t_ns, int64_t spin_ns) { self.clock()->sleep_until(t_ns, spin_ns); },
+             py::arg("t_ns"), py::arg("spin_ns") = 0, py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("virtual_time", [](const Robot& self) { return self.clock()->is_virtual(); })
 
-        .def("check_safety", &Robot::check_safety)
+        .def("set_gains",
+             [](Robot& self, const std::vector<float>& kp, const std::vector<float>& kd) {
+                 nogil(self, [&] { self.set_gains(kp, kd); });
+             },
+             py::arg("kp"), py::arg("kd"), "Set PD gains")
 
-        // 1D action 검사: 첫 원소가 시퀀스면 즉시 estop
+        .def("check_safety", [](Robot& self) { nogil(self, [&] { self.check_safety(); }); })
+        .def("health",
+             [](Robot& self) {
+                 std::vector<MotorHealth> motors;
+                 std::vector<BoardHealth> boards;
+                 nogil(self, [&] {   // 복사만 잠금 안에서, dict 생성은 GIL 잡고
+                     motors.assign(self.motor_health().begin(), self.motor_health().end());
+                     boards.assign(self.board_health().begin(), self.board_health().end());
+                 });
+                 py::list bl, ml;
+                 for (const auto& b : boards) {
+                     py::dict d;
+                     d["valid"] = b.valid != 0;
+                     d["emergency"] = b.emergency != 0;
+                     d["seq"] = b.seq;
+                     bl.append(d);
+                 }
+                 for (const auto& m : motors) {
+                     py::dict d;
+                     d["id"] = m.id;
+                     d["present"] = m.present != 0;
+                     d["pattern"] = m.pattern;
+                     d["err"] = m.err;
+                     d["connected"] = m.connected();
+                     ml.append(d);
+                 }
+                 py::dict d;
+                 d["boards"] = bl;
+                 d["motors"] = ml;
+                 return d;
+             },
+             "Last STATUS decoded by check_safety/wake: {'boards': [...], 'motors': [...]} (action order)")
+
+        // 연속 float32 배열은 버퍼 그대로 사용 (리스트 등은 NumPy가 한 번에 변환)
+        // 1D가 아니거나 float 배열로 바꿀 수 없으면 즉시 estop
         .def("do_action",
              [](Robot& self, py::object action, bool torque_ctrl) {
-                 if (py::isinstance<py::sequence>(action)) {
-                     py::sequence seq = action;
-                     if (py::len(seq) > 0 && py::isinstance<py::sequence>(seq[0])) {
-                         self.estop("action must be a 1D list");
-                     }
+                 using farray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+                 farray a = farray::ensure(action);   // GIL 필요 (변환)
+                 if (!a || a.ndim() != 1) {
+                     nogil(self, [&] { self.estop("action must be a 1D list"); });
                  }
-                 std::vector<float> a = action.cast<std::vector<float>>();
-                 self.do_action(a, torque_ctrl);
+                 // a가 버퍼를 붙잡고 있으므로 GIL 없이 읽어도 수명은 안전
+                 std::span<const float> act(a.data(), static_cast<size_t>(a.size()));
+                 nogil(self, [&] { self.do_action(act, torque_ctrl); });
              },
              py::arg("action"), py::arg("torque_ctrl") = false)
 
-        .def("get_obs", &Robot::get_obs)
+        // 네이티브 토크 모드: setpoint(action 순서) → C++ 임피던스 법칙 → tau만 송신
+        .def("set_impedance",
+             [](Robot& self, std::vector<float> kp, std::vector<float> kd, std::vector<float> tau_limit) {
+                 ImpedanceOptions o;
+                 o.kp = std::move(kp);
+                 o.kd = std::move(kd);
+                 o.tau_limit = std::move(tau_limit);
+                 nogil(self, [&] { self.set_impedance(o); });
+             },
+             py::arg("kp"), py::arg("kd"), py::arg("tau_limit") = std::vector<float>{},
+             "Joint impedance for do_torque(): tau = kp (q_ref - q) + kd (dq_ref - dq), clamped to tau_limit")
+        .def("do_torque",
+             [](Robot& self, py::object setpoint) {
+                 using farray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+                 farray a = farray::ensure(setpoint);
+                 if (!a || a.ndim() != 1) {
+                     nogil(self, [&] { self.estop("action must be a 1D list"); });
+                 }
+                 std::span<const float> sp(a.data(), static_cast<size_t>(a.size()));
+                 nogil(self, [&] { self.do_torque(sp); });
+             },
+             py::arg("setpoint"),
+             "Evaluate the impedance law on the last get_obs() and send tau-only frames "
+             "(setpoint: joint positions / wheel velocities, action order)")
+        .def_property_readonly("last_torque",
+             [](const Robot& self) {
+                 const auto t = self.last_torque();
+                 return std::vector<float>(t.begin(), t.end());
+             },
+             "Torque sent by the last do_torque() (action order)")
+
+        // Robot 내부 프레임 (복사 없음, 필드는 읽기 전용 NumPy 뷰; 다음 get_obs()에서 갱신)
+        .def("get_obs",
+             [](Robot& self) -> const ObsFrame& {
+                 return nogil(self, [&]() -> const ObsFrame& { return self.get_obs(); });
+             },
+             py::return_value_policy::reference_internal)
+        .def("obs_fresh", [](Robot& self) { return nogil(self, [&] { return self.obs_fresh(); }); },
+             "True if the last get_obs() returned data from this tick")
+        // 최근 관측 이력: 링 버퍼 메모리를 그대로 가리키는 (n, len) 뷰 (복사 없음, 잠금 없음)
+        .def("obs_history",
+             [](py::object self_obj, py::object n_obj, py::object key, bool with_seq) -> py::object {
+                 const Robot& self = self_obj.cast<const Robot&>();
+                 const Robot::History& h = self.obs_history();
+                 const size_t avail = static_cast<size_t>(std::min<uint64_t>(h.count(), Robot::kObsHistory));
+                 const size_t n = n_obj.is_none() ? avail : n_obj.cast<size_t>();
+                 if (n > avail)
+                     throw py::value_error("obs_history: n must be <= " + std::to_string(avail) +
+                                           " (frames kept: " + std::to_string(Robot::kObsHistory) + ")");
+                 const ObsField* fd = nullptr;
+                 if (!key.is_none()) {
+                     fd = obs_field(key.cast<std::string>());
+                     if (!fd) throw py::key_error(key.cast<std::string>());
+                 }
+                 uint64_t first = h.count() - n;
+                 const ObsFrame* rows = n ? h.window(n, &first) : nullptr;
+                 if (n && !rows) throw py::value_error("obs_history: n out of range");
+                 static const ObsFrame empty{};
+                 py::array a = obs_rows_view(self_obj, rows ? rows : &empty, n, fd);
+                 if (with_seq) return py::make_tuple(first + 1, a);
+                 return a;
+             },
+             py::arg("n") = py::none(), py::arg("key") = py::none(), py::arg("with_seq") = false,
+             "Last n observations (oldest first) as a read-only (n, len) float32 view into the robot's\n"
+             "history ring, no copy: key selects one field (e.g. 'dof_pos'), None gives every float field.\n"
+             "Rows stay valid until obs_history_size - n more get_obs() calls. When another thread\n"
+             "(ControlLoop) calls get_obs(), pass with_seq=True to get (seq of row 0, view) and check\n"
+             "obs_history_intact(seq) after reading, or copy the view")
+        .def("obs_history_intact",
+             [](const Robot& self, uint64_t seq) { return seq > 0 && self.obs_history().intact(seq - 1); },
+             py::arg("seq"), "True while the frame with this seq (and every later one) is still in the history")
+        .def_property_readonly_static("obs_history_size", [](py::object) { return Robot::kObsHistory; },
+             "Frames kept by obs_history()")
+        .def("set_lin_vel_estimator",
+             [](Robot& self, float wheel_radius, float track_width, std::array<uint8_t, 4> wheel_index,
+                std::array<float, 4> wheel_sign, float accel_noise, float odom_noise, float lateral_noise,
+                float slip_gain, float slip_reject) {
+                 LinVelOptions o;
+                 o.wheel_radius = wheel_radius; o.track_width = track_width;
+                 o.wheel_index = wheel_index; o.wheel_sign = wheel_sign;
+                 o.accel_noise = accel_noise; o.odom_noise = odom_noise; o.lateral_noise = lateral_noise;
+                 o.slip_gain = slip_gain; o.slip_reject = slip_reject;
+                 nogil(self, [&] { self.set_lin_vel_estimator(o); });
+             },
+             py::arg("wheel_radius"), py::arg("track_width"),
+             py::arg("wheel_index") = std::array<uint8_t, 4>{6, 7, 14, 15},
+             py::arg("wheel_sign") = std::array<float, 4>{1.0f, -1.0f, 1.0f, -1.0f},
+             py::arg("accel_noise") = 4.0f, py::arg("odom_noise") = 0.05f, py::arg("lateral_noise") = 0.10f,
+             py::arg("slip_gain") = 1.0f, py::arg("slip_reject") = 0.3f,
+             "Estimate obs.lin_vel on every get_obs() from IMU + wheel odometry (wheels FL, FR, RL, RR)")
+        .def("disable_lin_vel_estimator", [](Robot& self) { nogil(self, [&] { self.disable_lin_vel_estimator(); }); })
+        .def("set_action_shaper",
+             [](Robot& self, std::vector<float> max_rate, float smooth_ms, int sub_ticks) {
+                 ShaperOptions o;
+                 o.max_rate = std::move(max_rate);
+                 o.smooth_ms = smooth_ms;
+                 o.sub_ticks = sub_ticks;
+                 nogil(self, [&] { self.set_action_shaper(o); });
+             },
+             py::arg("max_rate") = std::vector<float>{}, py::arg("smooth_ms") = 0.0f, py::arg("sub_ticks") = 1,
+             "Shape position-mode do_action() targets: per-entry slew limit (units/s, <= 0: none), "
+             "first-order smoothing (ms) and linear interpolation over sub_ticks MIT frames per period")
+        .def("disable_action_shaper", [](Robot& self) { nogil(self, [&] { self.disable_action_shaper(); }); })
+        .def_property_readonly("action_sub_ticks", &Robot::action_sub_ticks,
+             "MIT frames per control period (1 without a shaper)")
+        .def("action_subtick", [](Robot& self) { return nogil(self, [&] { return self.action_subtick(); }); },
+             "Send the shaper's next sub-tick frame; call sub_ticks - 1 times per period, evenly spaced")
+        .def_property_readonly("obs_to_action_ns", &Robot::obs_to_action_ns,
+             "Last do_action(): receive time of the observation it used → targets sent (ns)")
+        .def("rx_bad_frames", [](Robot& self) { return nogil(self, [&] { return self.rx_bad_frames(); }); },
+             "Frames dropped on the RX thread (CRC mismatch or truncated)")
+        .def("set_req_retry",
+             [](Robot& self, double period_ms, double slice) {
+                 nogil(self, [&] { self.set_req_retry(period_ms, slice); });
+             },
+             py::arg("control_period_ms") = 20.0, py::arg("slice") = 0.1,
+             "REQ retry budget as a slice of the control period")
+        .def("set_control_period",
+             [](Robot& self, double period_ms) { nogil(self, [&] { self.set_control_period(period_ms); }); },
+             py::arg("period_ms"), "do_action() period used for the disconnect timeout (default 20 ms)")
+        .def_property_readonly("backend", [](Robot& self) { return std::string(self.backend().name()); },
+             "'udp', 'sim' or 'replay'")
+        .def("record",
+             [](Robot& self, const std::string& path) {
+                 nogil(self, [&] {
+                     auto* udp = dynamic_cast<UdpBackend*>(&self.backend());
+                     if (!udp) throw std::runtime_error("record(): only the UDP backend can record");
+                     udp->record(path);
+                 });
+             },
+             py::arg("path"), "Write every REQ exchange to path for Robot.replay() ('' stops)")
+        .def("sim_state",
+             [](Robot& self) -> py::object {
+                 auto* sim = dynamic_cast<SimBackend*>(&self.backend());
+                 if (!sim) return py::none();
+                 SimSnapshot st;
+                 {
+                     py::gil_scoped_release release;   // snapshot()은 자체 잠금 → 제어 루프 중에도 호출 가능
+                     st = sim->snapshot();
+                 }
+                 py::dict d;
+                 d["t"] = st.t_ns * 1e-9;
+                 d["q"] = farray(static_cast<py::ssize_t>(st.q.size()), st.q.data());
+                 d["dq"] = farray(static_cast<py::ssize_t>(st.dq.size()), st.dq.data());
+                 d["u"] = farray(static_cast<py::ssize_t>(st.u.size()), st.u.data());
+                 d["rpy"] = farray(3, st.rpy.data());
+                 d["omega"] = farray(3, st.omega.data());
+                 d["estopped"] = st.estopped;
+                 d["reqs"] = st.reqs;
+                 d["sends"] = st.sends;
+                 d["estops"] = st.estops;
+                 return d;
+             },
+             "None unless the backend is 'sim'; else plant time and motor/body state")
+
+        // 독립 watchdog 스레드 (Python이 멈춰도 ESTOP)
+        .def("start_watchdog",
+             [](Robot& self, double period_ms, double action_timeout_ms, double obs_timeout_ms,
+                bool check_limits, int fifo_prio, int cpu) {
+                 WatchdogOptions o;
+                 o.period_ms = period_ms;
+                 o.action_timeout_ms = action_timeout_ms;
+                 o.obs_timeout_ms = obs_timeout_ms;
+                 o.check_limits = check_limits;
+                 o.fifo_prio = fifo_prio;
+                 o.cpu = cpu;
+                 nogil(self, [&] { self.start_watchdog(o); });
+             },
+             py::arg("period_ms") = 1.0, py::arg("action_timeout_ms") = 100.0, py::arg("obs_timeout_ms") = 100.0,
+             py::arg("check_limits") = true, py::arg("fifo_prio") = 90, py::arg("cpu") = -1)
+        .def("stop_watchdog", [](Robot& self) { nogil(self, [&] { self.stop_watchdog(); }); })
+        .def("watchdog_status",
+             [](Robot& self) -> py::object {
+                 bool on = false, tripped = false;
+                 WatchdogStats st{};
+                 WatchdogTrip tr{};
+                 nogil(self, [&] {
+                     if (const Watchdog* wd = self.watchdog()) {
+                         on = true;
+                         st = wd->stats();
+                         tripped = wd->tripped();
+                         if (tripped) tr = wd->trip();
+                     }
+                 });
+                 if (!on) return py::none();
+                 py::dict d;
+                 d["running"] = st.running != 0;
+                 d["checks"] = st.checks;
+                 d["max_gap_us"] = st.max_gap_ns / 1000.0;
+                 d["tripped"] = tripped;
+                 if (tripped) {
+                     d["reason"] = std::string(tr.reason);
+                     d["detect_late_us"] = (tr.detect_ns - tr.deadline_ns) / 1000.0;
+                     d["estop_us"] = tr.estop_ns / 1000.0;
+                 }
+                 return d;
+             },
+             "None if no watchdog runs; else checks, max_gap_us and trip details")
+
+        .def("estop", [](Robot& self, const std::string& msg) { nogil(self, [&] { self.estop(msg); }); },
+             py::arg("msg") = std::string())
+        .def("sleep", [](Robot& self) { nogil(self, [&] { self.sleep(); }); })
+        .def("wake", [](Robot& self) { nogil(self, [&] { self.wake(); }); })
+        // 비블로킹 wake: begin_wake() 후 제어 주기마다 wake_step() (ControlLoop는 자동)
+        .def("begin_wake",
+             [](Robot& self, double ramp_ms, double max_ms, double settle_ms, float pos_eps, float vel_eps) {
+                 WakeOptions o;
+                 o.ramp_ms = ramp_ms; o.max_ms = max_ms; o.settle_ms = settle_ms;
+                 o.pos_eps = pos_eps; o.vel_eps = vel_eps;
+                 nogil(self, [&] { self.begin_wake(o); });
+             },
+             py::arg("ramp_ms") = 7000.0, py::arg("max_ms") = 10000.0, py::arg("settle_ms") = 200.0,
+             py::arg("pos_eps") = 0.02f, py::arg("vel_eps") = 0.05f,
+             "Start the wake ramp; advance it with wake_step() once per control period")
+        .def("wake_step", [](Robot& self) { return nogil(self, [&] { self.wake_step(); return !self.waking(); }); },
+             "Advance the wake ramp by one tick; True once it has finished")
+        .def_property_readonly("waking", [](Robot& self) { return nogil(self, [&] { return self.waking(); }); })
+        .def("wake_status",
+             [](Robot& self) {
+                 const WakeStatus st = nogil(self, [&] { return self.wake_status(); });
+                 static const char* const kPhase[] = {"idle", "ramping", "settling", "done", "timed_out"};
+                 py::dict d;
+                 d["phase"] = kPhase[static_cast<int>(st.phase)];
+                 d["tick"] = st.tick;
+                 d["alpha"] = st.alpha;
+                 d["elapsed_ms"] = st.elapsed_ms;
+                 d["in_band_ms"] = st.in_band_ms;
+                 return d;
+             })
+        // 제어된 정지: 바퀴 저크 제한 감속 + 다리 자세 유지 / crouch, 전용 스레드가 rate_hz로 송신
+        .def("precise_stop",
+             [](Robot& self, double rate_hz, float wheel_decel, float wheel_jerk, float leg_speed,
+                std::vector<float> crouch, double settle_ms, float vel_eps, double max_ms, int max_missed,
+                int fifo_prio, int cpu) {
+                 StopOptions o;
+                 o.rate_hz = rate_hz; o.wheel_decel = wheel_decel; o.wheel_jerk = wheel_jerk;
+                 o.leg_speed = leg_speed; o.crouch = std::move(crouch);
+                 o.settle_ms = settle_ms; o.vel_eps = vel_eps; o.max_ms = max_ms; o.max_missed = max_missed;
+                 o.fifo_prio = fifo_prio; o.cpu = cpu;
+                 nogil(self, [&] { self.precise_stop(o); });
+             },
+             py::arg("rate_hz") = 500.0, py::arg("wheel_decel") = 10.0f, py::arg("wheel_jerk") = 100.0f,
+             py::arg("leg_speed") = 0.5f, py::arg("crouch") = std::vector<float>{},
+             py::arg("settle_ms") = 100.0, py::arg("vel_eps") = 0.05f, py::arg("max_ms") = 3000.0,
+             py::arg("max_missed") = 5, py::arg("fifo_prio") = 80, py::arg("cpu") = -1,
+             "Bring the robot to rest: jerk-limited wheel stop, legs held (or moved to crouch), "
+             "streamed at rate_hz with deadline monitoring; returns holding the final pose")
+        .def("stop_status",
+             [](Robot& self) {
+                 const StopStatus st = nogil(self, [&] { return self.stop_status(); });
+                 static const char* const kPhase[] = {"idle", "braking", "settling", "done", "timed_out"};
+                 py::dict d;
+                 d["phase"] = kPhase[static_cast<int>(st.phase)];
+                 d["tick"] = st.tick;
+                 d["speed"] = st.speed;
+                 d["elapsed_ms"] = st.elapsed_ms;
+                 d["in_rest_ms"] = st.in_rest_ms;
+                 d["missed"] = st.missed;
+                 d["max_late_us"] = st.max_late_ns / 1000.0;
+                 return d;
+             });
 
-        .def("estop", &Robot::estop, py::arg("msg") = std::string())
-        .def("sleep", &Robot::sleep)
-        .def("stand", &Robot::stand)
-        .def("precise_stop", &Robot::precise_stop);
-}
\ No newline at end of file
+    // 네이티브 제어 루프: 전용 SCHED_FIFO 스레드에서 get_obs → rl → do_action.
+    // Python은 set_cmd()로 명령을 넣고 telemetry()로 상태만 읽는다.
+    py::class_<ControlLoop, std::unique_ptr<ControlLoop, LoopDeleter>>(m, "ControlLoop")
+        .def(py::init([](Robot& robot, py::object rl, double hz, double spin_us, int fifo_prio, int cpu, bool lock_memory,
+                         double inner_hz, const std::string& interp, uint64_t max_ticks, bool torque) {
+                 LoopOptions opt;
+                 opt.hz = hz;
+                 opt.spin_ns = static_cast<int64_t>(spin_us * 1000.0);
+                 opt.fifo_prio = fifo_prio;
+                 opt.cpu = cpu;
+                 opt.lock_memory = lock_memory;
+                 opt.inner_hz = inner_hz;
+                 opt.max_ticks = max_ticks;
+                 opt.torque = torque;
+                 if (interp == "linear") opt.interp = LoopInterp::Linear;
+                 else if (interp == "first_order") opt.interp = LoopInterp::FirstOrder;
+                 else if (interp == "zero") opt.interp = LoopInterp::Zero;
+                 else throw py::value_error("interp must be 'linear', 'first_order' or 'zero'");
+                 return std::unique_ptr<ControlLoop, LoopDeleter>(new ControlLoop(robot, rl_step(std::move(rl)), opt));
+             }),
+             py::arg("robot"), py::arg("rl"), py::arg("hz") = 50.0, py::arg("spin_us") = 200.0,
+             py::arg("fifo_prio") = 80, py::arg("cpu") = -1, py::arg("lock_memory") = false,
+             py::arg("inner_hz") = 0.0, py::arg("interp") = "linear", py::arg("max_ticks") = 0,
+             py::arg("torque") = false,
+             py::keep_alive<1, 2>(),
+             "inner_hz > hz: get_obs/do_action at inner_hz, rl at hz on a second thread (multi-rate); "
+             "torque: rl outputs setpoints for Robot.do_torque (native impedance law) instead of do_action")
+        .def("start", &ControlLoop::start)
+        .def("stop", &ControlLoop::stop, py::call_guard<py::gil_scoped_release>(),
+             "Stop after the current tick and join the loop thread")
+        .def("wait", &ControlLoop::wait, py::call_guard<py::gil_scoped_release>(),
+             "Join the loop thread once it ends by itself (max_ticks, error, sleep)")
+        .def("set_cmd", [](ControlLoop& self, py::handle cmd) { self.set_command(to_loop_command(cmd)); },
+             py::arg("cmd"), "joystick.get_cmd() dict or a cmd_vector sequence")
+        .def("telemetry", [](const ControlLoop& self) { return telemetry_dict(self.telemetry()); })
+        .def("running", &ControlLoop::running)
+        .def("error", &ControlLoop::error, "Why the loop stopped (empty while running)")
+        .def_property_readonly("period_ns", &ControlLoop::period_ns)
+        .def_property_readonly("io_period_ns", &ControlLoop::io_period_ns);
+}
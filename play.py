@@ -1,4 +1,7 @@
+import time
+
 from w4_sdk import *
+from w4_sdk.core.exceptions import RobotSleepError
 
 # Robot's Gains
 kp = [100, 100, 100, 100, 120, 120, 0, 0, 100, 100, 100, 100, 120, 120, 0, 0]
@@ -30,17 +33,30 @@ robot.set_gains(kp=kp, kd=kd)
 rl.add_mode(mode)
 rl.set_mode(mode_id=1)
 
-# Wake the robot
-robot.wake()
-@control_rate(robot, hz=50)
-def loop():
-    obs = robot.get_obs()             # Get observation
-    cmd = joystick.get_cmd()          # Get command
-
-    state = rl.build_state(obs, cmd)  # Build state
-    action = rl.select_action(state)  # Select action
-    #action = [0] * 16
-    robot.do_action(action)           # Do action
-
-loop()
-
+# Safety watchdog: e-stop if this script stalls (no action / observation for 100 ms)
+robot.start_watchdog()
+
+# Wake the robot: 램프는 제어 루프가 틱마다 진행하고, 끝나면 그 다음 틱부터 정책이 제어
+robot.begin_wake()
+
+# Control loop: get_obs → build_state → select_action → do_action 은 C++ 스레드에서 50 Hz로 실행
+# 메인 스레드는 조이스틱 명령만 넘긴다 (wake 진행: loop.telemetry()["waking"], robot.wake_status())
+loop = ControlLoop(robot, rl, hz=50)
+loop.start()
+try:
+    while loop.running():
+        loop.set_cmd(joystick.get_cmd())   # Push command
+        time.sleep(0.01)
+    print(f"Control loop stopped: {loop.error()}")   # 루프 쪽 오류는 이미 estop 처리됨
+except RobotSleepError:
+    loop.stop()
+    print("Escape control loop due to robot sleep")
+except BaseException as e:                 # joystick e-stop, Ctrl+C, ...
+    loop.stop()
+    print(f"Control loop stopped: {e!r}")
+    try:
+        robot.estop()
+    except Exception:
+        pass
+finally:
+    loop.stop()
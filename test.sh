@@ -120,12 +120,19 @@ print("=========================================================")
 print("===============    import rl ... OK!    ===============")
 print("=========================================================\n")
 
-robot = Robot()
+# 하드웨어 없이 돌 때는 시뮬레이션 plant (W4_ROBOT=hw 로 실제 보드)
+robot = Robot() if os.environ.get("W4_ROBOT") == "hw" else Robot.sim()
+print("backend:", robot.backend)
+robot.set_gains([10.0] * 6 + [0.0] * 2 + [10.0] * 6 + [0.0] * 2, [0.5] * 16)
 obs = robot.get_obs()
 print("obs:", obs)
-action = [0] * 8
+action = [0] * 16
 robot.do_action(action)
-robot.estop()
+print("health:", robot.health()["boards"])
+try:
+    robot.estop()
+except RobotEStopError:
+    pass
 print("=========================================================")
 print("===============    import robot ... OK!    ===============")
 print("=========================================================\n")
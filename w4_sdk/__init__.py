@@ -1,11 +1,11 @@
 from .classes.onnxpolicy import MLPPolicy, LSTMPolicy
 from .classes.mode import Mode
 from .classes.joystick import Joystick
-from .classes.robot import Robot
+from .classes.robot import Robot, ControlLoop
 from .classes.rl import RL
 from .classes.mode import Mode
 from .core.control_rate import control_rate
 from .core.exceptions import RobotEStopError
 from .classes.logger import Logger
 
-__all__ = ["Logger", "control_rate", "Robot", "RL", "Joystick", "Mode", "MLPPolicy", "LSTMPolicy", "RobotEStopError"]
+__all__ = ["Logger", "control_rate", "Robot", "ControlLoop", "RL", "Joystick", "Mode", "MLPPolicy", "LSTMPolicy", "RobotEStopError"]
@@ -23,28 +23,25 @@ def control_rate(robot: Robot, hz: float = 50.0, busy_spin_ns: int = 200000):
         def runner(*args, **kwargs):
             try:
                 cnt = 0
-                start_call_ns = time.monotonic_ns()
+                # 시각은 Robot 시계로: Robot.sim(virtual_time=True)이면 대기 없이 가상 시각만 진행
+                start_call_ns = robot.now_ns()
                 next_tick = start_call_ns + period_ns
                 while True:
                     cnt += 1
                     loop_func(*args, **kwargs)
 
-                    now = time.monotonic_ns()
+                    now = robot.now_ns()
                     remaining = next_tick - now
 
                     print(f"\nElapsed: {(period_ns - remaining) / 1000000} ms\n")
                     
                     if remaining <= 0:
                         logger.warning(f"[cnt= {cnt}] Control loop overrun: {-remaining / 1000000:.6f} ms")
-                        next_tick = time.monotonic_ns() + period_ns
+                        next_tick = robot.now_ns() + period_ns
                         continue
 
-                    sleep_ns = remaining - busy_spin_ns
-                    if sleep_ns > 0:
-                        time.sleep(sleep_ns / 1000000000)
-
-                    while time.monotonic_ns() < next_tick:
-                        pass
+                    # sleep 후 마지막 busy_spin_ns는 spin (GIL은 놓고 대기)
+                    robot.sleep_until(next_tick, busy_spin_ns)
 
                     next_tick += period_ns
 